@@ -0,0 +1,149 @@
+#include "BilateralFilter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "../ConvolutionKernel/KernelCache/KernelCache.h"
+#include "../Instrumentation/Instrumentation.h"
+
+namespace {
+    // Empty cells around the grid, as many as the radius of the blur.
+    constexpr int gridPadding = 2;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+BilateralFilter<IEEE754_t>::BilateralFilter(IEEE754_t spatialSigma, IEEE754_t rangeSigma) : spatialSigma(spatialSigma), rangeSigma(rangeSigma) {
+    assert(spatialSigma > 0 && rangeSigma > 0);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+IEEE754_t BilateralFilter<IEEE754_t>::getSpatialSigma() const {
+    return this->spatialSigma;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+IEEE754_t BilateralFilter<IEEE754_t>::getRangeSigma() const {
+    return this->rangeSigma;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *BilateralFilter<IEEE754_t>::filtered(const Channel<IEEE754_t> *channel) const {
+    assert(channel != nullptr);
+    INSTRUMENTATION_SCOPE("BilateralFilter::filtered");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, channel->getRows() * channel->getColumns());
+
+    auto rows = channel->getRows();
+    auto columns = channel->getColumns();
+    auto layout = channel->getMatrixLayout();
+    auto maxValue = static_cast<IEEE754_t>(channel->getMaxTheoreticalValue());
+
+    auto gridRows = static_cast<int>(std::ceil((rows - 1) / this->spatialSigma)) + 1 + 2 * gridPadding;
+    auto gridColumns = static_cast<int>(std::ceil((columns - 1) / this->spatialSigma)) + 1 + 2 * gridPadding;
+    auto gridDepth = static_cast<int>(std::ceil(maxValue / this->rangeSigma)) + 1 + 2 * gridPadding;
+    auto cellsCount = static_cast<size_t>(gridRows) * gridColumns * gridDepth;
+
+    // Cells are stored depth first, then by column, then by row; each holds the sum of its values and their count.
+    auto cellIndexOf = [gridColumns, gridDepth](int gridRow, int gridColumn, int level) {
+        return (static_cast<size_t>(gridRow) * gridColumns + gridColumn) * gridDepth + level;
+    };
+
+    auto sums = std::vector<IEEE754_t>(cellsCount, 0);
+    auto counts = std::vector<IEEE754_t>(cellsCount, 0);
+
+    for (unsigned int row = 0; row < rows; row++) {
+        for (unsigned int column = 0; column < columns; column++) {
+            auto value = std::clamp(channel->at(row, column), static_cast<IEEE754_t>(0), maxValue);
+            auto cellIndex = cellIndexOf(
+                static_cast<int>(std::lround(row / this->spatialSigma)) + gridPadding,
+                static_cast<int>(std::lround(column / this->spatialSigma)) + gridPadding,
+                static_cast<int>(std::lround(value / this->rangeSigma)) + gridPadding
+            );
+
+            sums[cellIndex] += value;
+            counts[cellIndex] += 1;
+        }
+    }
+
+    // One cell of the grid is one sigma along each axis, hence a Gaussian of sigma 1; it's separable, its row factor is the 1D profile.
+    const auto& taps = KernelCache<IEEE754_t>::gaussianKernel(2 * gridPadding + 1, 1)->getRowFactor();
+    assert(taps.size() == 2 * gridPadding + 1);
+
+    auto blurred = std::vector<IEEE754_t>(cellsCount);
+    size_t axisStrides[] = {static_cast<size_t>(gridColumns) * gridDepth, static_cast<size_t>(gridDepth), 1};
+    int axisSizes[] = {gridRows, gridColumns, gridDepth};
+
+    for (auto grid : {&sums, &counts}) {
+        for (int axis = 0; axis < 3; axis++) {
+            auto stride = axisStrides[axis];
+            auto axisSize = axisSizes[axis];
+
+            // Lines along the axis are `stride` cells apart, so the innermost loop runs over contiguous cells.
+            auto outerCount = cellsCount / (stride * axisSize);
+
+            for (size_t outer = 0; outer < outerCount; outer++) {
+                for (int position = 0; position < axisSize; position++) {
+                    auto blurredCells = blurred.data() + (outer * axisSize + position) * stride;
+                    std::fill(blurredCells, blurredCells + stride, 0);
+
+                    for (int tap = std::max(-gridPadding, -position); tap <= std::min(gridPadding, axisSize - 1 - position); tap++) {
+                        auto sourceCells = grid->data() + (outer * axisSize + position + tap) * stride;
+                        auto tapValue = taps[tap + gridPadding];
+
+                        for (size_t i = 0; i < stride; i++) {
+                            blurredCells[i] += sourceCells[i] * tapValue;
+                        }
+                    }
+                }
+            }
+
+            grid->swap(blurred);
+        }
+    }
+
+    auto filteredChannel = new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), rows, columns, layout);
+    auto destination = filteredChannel->getMutableElements();
+
+    for (unsigned int row = 0; row < rows; row++) {
+        for (unsigned int column = 0; column < columns; column++) {
+            auto value = std::clamp(channel->at(row, column), static_cast<IEEE754_t>(0), maxValue);
+
+            IEEE754_t position[] = {row / this->spatialSigma + gridPadding, column / this->spatialSigma + gridPadding, value / this->rangeSigma + gridPadding};
+            int lowerCell[3];
+            IEEE754_t fraction[3];
+
+            for (int axis = 0; axis < 3; axis++) {
+                lowerCell[axis] = std::min(static_cast<int>(position[axis]), axisSizes[axis] - 2);
+                fraction[axis] = position[axis] - lowerCell[axis];
+            }
+
+            IEEE754_t sum = 0;
+            IEEE754_t count = 0;
+
+            for (int corner = 0; corner < 8; corner++) {
+                IEEE754_t weight = 1;
+                int cell[3];
+
+                for (int axis = 0; axis < 3; axis++) {
+                    auto isUpper = (corner >> axis) & 1;
+
+                    cell[axis] = lowerCell[axis] + isUpper;
+                    weight *= isUpper ? fraction[axis] : 1 - fraction[axis];
+                }
+
+                auto cellIndex = cellIndexOf(cell[0], cell[1], cell[2]);
+                sum += weight * sums[cellIndex];
+                count += weight * counts[cellIndex];
+            }
+
+            destination[flatIndexOf(row, column, rows, columns, layout)] = count > 0 ? channel->saturated(sum / count) : channel->at(row, column);
+        }
+    }
+
+    return filteredChannel;
+}
+
+template class BilateralFilter<float>;
+template class BilateralFilter<double>;
+template class BilateralFilter<long double>;
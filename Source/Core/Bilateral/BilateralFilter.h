@@ -0,0 +1,37 @@
+#ifndef IMAGECONVOLUTIONKERNEL_BILATERALFILTER_H
+#define IMAGECONVOLUTIONKERNEL_BILATERALFILTER_H
+
+#include <type_traits>
+
+#include "../Channel/Channel.h"
+
+/*
+ * Edge preserving smoothing: each pixel becomes the average of its neighbours weighted both by their distance (Gaussian of `spatialSigma`
+ * pixels) and by how close their values are to its own (Gaussian of `rangeSigma` levels), so that pixels across an edge barely contribute.
+ *
+ * Rather than weighting every neighbour of every pixel, the filter runs on a bilateral grid (Chen, Paris and Durand, 2007): pixels are
+ * accumulated into cells of `spatialSigma` x `spatialSigma` pixels x `rangeSigma` levels along with their count, the grid is blurred with
+ * the 5 taps Gaussian of `KernelCache` along each of its 3 axes, and each output pixel is read back by trilinear interpolation at its
+ * position and value, divided by the interpolated count. The grid has about rows · columns · maxValue / (spatialSigma² · rangeSigma)
+ * cells, so the cost is nearly independent of the spatial sigma, and it shrinks as sigmas grow; sigmas of a couple of units or more are
+ * where it pays off.
+ *
+ * Out of the channel, the grid is empty: borders are normalized by the count, which is the usual behaviour of bilateral filters rather
+ * than one of the padding strategies.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class BilateralFilter {
+private:
+    IEEE754_t spatialSigma;
+    IEEE754_t rangeSigma;
+
+public:
+    BilateralFilter(IEEE754_t spatialSigma, IEEE754_t rangeSigma);
+
+    [[nodiscard]] IEEE754_t getSpatialSigma() const;
+    [[nodiscard]] IEEE754_t getRangeSigma() const;
+
+    Channel<IEEE754_t>* filtered(const Channel<IEEE754_t>* channel) const;
+};
+
+#endif
@@ -1,7 +1,53 @@
 #include "Channel.h"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <limits>
+#include <vector>
+
+#include "../Instrumentation/Instrumentation.h"
+#include "../Scheduler/Spans.h"
+#include "../Im2col/Im2colConvolution.h"
+#include "../Plan/ConvolutionPlan.h"
+
+namespace {
+    /*
+     * Compilers won't reorder a floating point min/max reduction on their own, since it changes which of two equal zeros (or NaNs) comes
+     * out; the simd reduction allows it, so that the loop becomes vector min/max instructions. Channel values are never NaN.
+     */
+    template<typename IEEE754_t>
+    std::pair<IEEE754_t, IEEE754_t> rangeOf(const IEEE754_t* values, size_t begin, size_t end) {
+        auto minValue = values[begin];
+        auto maxValue = values[begin];
+
+        #pragma omp simd reduction(min:minValue) reduction(max:maxValue)
+        for (size_t i = begin + 1; i < end; i++) {
+            minValue = values[i] < minValue ? values[i] : minValue;
+            maxValue = values[i] > maxValue ? values[i] : maxValue;
+        }
+
+        return {minValue, maxValue};
+    }
+
+    // The values of `kernel` in row-major order, whatever its layout.
+    template<typename IEEE754_t>
+    std::vector<IEEE754_t> valuesOf(const Matrix<IEEE754_t>* kernel) {
+        auto values = std::vector<IEEE754_t>();
+        values.reserve(static_cast<size_t>(kernel->getRows()) * kernel->getColumns());
+
+        for (unsigned int row = 0; row < kernel->getRows(); row++) {
+            for (unsigned int column = 0; column < kernel->getColumns(); column++) {
+                values.push_back(kernel->at(row, column));
+            }
+        }
+
+        return values;
+    }
+}
 
+/*
+ * Channel values must not exceed `maxValue`. The check is a debug assertion: release builds trust the caller, and only pay for the copy.
+ */
 template < typename IEEE754_t > requires std::is_floating_point_v <IEEE754_t>
     Channel < IEEE754_t > ::Channel(
         unsigned int maxValue,
@@ -19,119 +65,150 @@ template <typename IEEE754_t> requires std::is_floating_point_v <IEEE754_t>
     Channel < IEEE754_t > ::Channel(
         unsigned int maxValue,
         const Matrix < IEEE754_t > * channelValues): Matrix <IEEE754_t> (
-        [channelValues]() {
-            assert(channelValues != nullptr);
-
-            auto deepCopyOfChannelValues = new IEEE754_t[channelValues -> getRows() * channelValues -> getColumns()];
-            for (int i = 0; i < channelValues -> getRows(); i++) {
-                for (int j = 0; j < channelValues -> getColumns(); j++) {
-                    if (channelValues->getMatrixLayout() == ROW_MAJOR) {
-                        deepCopyOfChannelValues[i * channelValues -> getColumns() + j] = channelValues -> at(i, j);
-                    } else {
-                        deepCopyOfChannelValues[i + channelValues->getColumns() * j] = channelValues -> at(i, j);
-                    }
-                }
-            }
-            return deepCopyOfChannelValues;
-        }(),
         channelValues -> getRows(),
         channelValues -> getColumns(),
         channelValues -> getMatrixLayout()
     ),
     maxTheoreticalValue(maxValue) {
+    auto elements = this->getMutableElements();
+
+    for (unsigned int i = 0; i < this->getRows(); i++) {
+        for (unsigned int j = 0; j < this->getColumns(); j++) {
+            elements[flatIndexOf(i, j, this->getRows(), this->getColumns(), this->getMatrixLayout())] = channelValues -> at(i, j);
+        }
+    }
+
     assert(this->isWithinMaxThreshold());
 }
 
+/*
+ * A channel whose values are left uninitialized, for the operations that write every value right after.
+ */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
-bool Channel<IEEE754_t>::isWithinMaxThreshold() {
-    auto max = this->at(0, 0);
-    for (int i = 0; i < this->getRows(); i++) {
-        for (int j = 0; j < this->getColumns(); j++) {
-            auto currentElement = this->at(i, j);
-            if ( max > currentElement) {
-                max = currentElement;
-            }
-        }
-    }
+Channel<IEEE754_t>::Channel(unsigned int maxValue, unsigned int rows, unsigned int columns, MatrixLayout layout) : Matrix<IEEE754_t>(rows, columns, layout), maxTheoreticalValue(maxValue) {
 
-    return max <= this->maxTheoreticalValue;
 }
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
-unsigned int Channel<IEEE754_t>::getMaxTheoreticalValue() const {
-    return this->maxTheoreticalValue;
+Channel<IEEE754_t>::Channel(BorrowedStorage, unsigned int maxValue, IEEE754_t *elements, unsigned int rows, unsigned int columns, MatrixLayout layout) : Matrix<IEEE754_t>(BorrowedStorage{}, elements, rows, columns, layout), maxTheoreticalValue(maxValue) {
+
 }
 
+/*
+ * A channel that reads and writes `elements` in place, laid out according to `layout`, instead of a copy of them: e.g. a plane of a
+ * `SharedImage`, so that filtering into it writes straight to shared memory. `elements` isn't freed with the channel and must outlive it.
+ * The values aren't checked against `maxValue`, as they may be written later on by another process.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *Channel<IEEE754_t>::borrowing(unsigned int maxValue, IEEE754_t *elements, unsigned int rows, unsigned int columns, MatrixLayout layout) {
+    return new Channel(BorrowedStorage{}, maxValue, elements, rows, columns, layout);
+}
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
-Channel<IEEE754_t>* Channel<IEEE754_t>::normalized() const {
-    auto normalizedChannelValues = new IEEE754_t[this->getRows() * this->getColumns()];
+Channel<IEEE754_t>::~Channel() {
+    delete this->lastFilteredChannel;
+}
 
-    auto minValue = this->at(0, 0);
-    auto maxValue = this->at(0, 0);
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+bool Channel<IEEE754_t>::isWithinMaxThreshold() {
+    return rangeOf(this->getElements(), 0, this->getRows() * this->getColumns()).second <= this->maxTheoreticalValue;
+}
 
-    for (int i = 0; i < this->getRows(); i++) {
-        for (int j = 0; j < this->getColumns(); j++) {
-            auto currentElement = this->at(i, j);
-            if (currentElement < minValue) {
-                minValue = currentElement;
-            }
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int Channel<IEEE754_t>::getMaxTheoreticalValue() const {
+    return this->maxTheoreticalValue;
+}
 
-            if (currentElement > maxValue) {
-                maxValue = currentElement;
-            }
-        }
+/*
+ * The minimum and maximum values of the channel, found in a single pass over the storage, split across the workers of `scheduler` if any.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+std::pair<IEEE754_t, IEEE754_t> Channel<IEEE754_t>::getValueRange(WorkStealingScheduler *scheduler) const {
+    auto values = this->getElements();
+    auto valuesCount = static_cast<size_t>(this->getRows()) * this->getColumns();
+    auto spansCount = spansCountFor(valuesCount, MIN_VALUES_PER_TASK, scheduler);
+
+    auto spanRanges = std::vector<std::pair<IEEE754_t, IEEE754_t>>(spansCount);
+    forEachSpan(valuesCount, spansCount, scheduler, [values, &spanRanges](size_t span, size_t begin, size_t end) {
+        spanRanges[span] = rangeOf(values, begin, end);
+    });
+
+    auto range = spanRanges[0];
+    for (const auto& [minValue, maxValue] : spanRanges) {
+        range.first = std::min(range.first, minValue);
+        range.second = std::max(range.second, maxValue);
     }
 
-    for (int i = 0; i < this->getRows(); i++) {
-        for (int j = 0; j < this->getColumns(); j++) {
-            auto normalizedValue = (this -> at(i, j) - minValue) / (maxValue - minValue);;
+    return range;
+}
 
-            if (this->getMatrixLayout() == ROW_MAJOR) {
-                normalizedChannelValues[i * this -> getColumns() + j] = normalizedValue;
-            } else {
-                normalizedChannelValues[i + this->getRows() * j] = normalizedValue;
-            }
-        }
-    }
+/*
+ * Rescales the values to [0, 1]; a constant channel becomes all zeros. Values are mapped straight over the storage, whatever the layout.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t>* Channel<IEEE754_t>::normalized(WorkStealingScheduler *scheduler) const {
+    auto normalizedChannel = new Channel(1, this->getRows(), this->getColumns(), this->getMatrixLayout());
+    this->normalizedInto(normalizedChannel, scheduler);
 
-    return new Channel(
-        1,
-        normalizedChannelValues,
-        this->getRows(),
-        this->getColumns(),
-        this->getMatrixLayout()
-    );
+    return normalizedChannel;
 }
 
+/*
+ * Same as `normalized`, but the output goes to `destination`, an existing channel of the same size and layout (see `filteredInto`).
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::normalizedInto(Channel *destination, WorkStealingScheduler *scheduler) const {
+    assert(destination != nullptr && destination != this);
+    assert(destination->getRows() == this->getRows() && destination->getColumns() == this->getColumns());
+    assert(destination->getMatrixLayout() == this->getMatrixLayout());
+    INSTRUMENTATION_SCOPE("Channel::normalized");
+
+    auto [minValue, maxValue] = this->getValueRange(scheduler);
+    auto valuesRange = maxValue > minValue ? maxValue - minValue : static_cast<IEEE754_t>(1);
+
+    destination->recycle(1);
+    auto values = this->getElements();
+    auto normalizedValues = destination->getMutableElements();
+    auto valuesCount = static_cast<size_t>(this->getRows()) * this->getColumns();
+
+    // A division rather than a multiplication by the reciprocal, so that the maximum maps exactly to 1.
+    forEachSpan(valuesCount, spansCountFor(valuesCount, MIN_VALUES_PER_TASK, scheduler), scheduler, [values, normalizedValues, minValue, valuesRange](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            normalizedValues[i] = (values[i] - minValue) / valuesRange;
+        }
+    });
+}
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
-Channel<IEEE754_t>* Channel<IEEE754_t>::clamped(IEEE754_t min, IEEE754_t max) const {
-    assert(min <= max);
+Channel<IEEE754_t>* Channel<IEEE754_t>::clamped(IEEE754_t min, IEEE754_t max, WorkStealingScheduler *scheduler) const {
+    auto clampedChannel = new Channel(this->maxTheoreticalValue, this->getRows(), this->getColumns(), this->getMatrixLayout());
+    this->clampedInto(clampedChannel, min, max, scheduler);
 
-    auto clampedChannelValues = new IEEE754_t[this->getRows() * this->getColumns()];
+    return clampedChannel;
+}
 
-    for (int i = 0; i < this->getRows(); i++) {
-        for (int j = 0; j < this->getColumns(); j++) {
-            auto currentChannelValue = this->at(i, j);
-            auto clampedValue = (currentChannelValue < min) ? min : (currentChannelValue > max) ? max : currentChannelValue;
+/*
+ * Same as `clamped`, but the output goes to `destination`, an existing channel of the same size and layout (see `filteredInto`).
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::clampedInto(Channel *destination, IEEE754_t min, IEEE754_t max, WorkStealingScheduler *scheduler) const {
+    assert(destination != nullptr && destination != this);
+    assert(destination->getRows() == this->getRows() && destination->getColumns() == this->getColumns());
+    assert(destination->getMatrixLayout() == this->getMatrixLayout());
+    assert(min <= max);
+    INSTRUMENTATION_SCOPE("Channel::clamped");
 
-            if (this->getMatrixLayout() == ROW_MAJOR) {
-                clampedChannelValues[i * this -> getColumns() + j] = clampedValue;
-            } else {
-                clampedChannelValues[i + this->getRows() * j] = clampedValue;
-            }
+    destination->recycle(this->maxTheoreticalValue);
+    auto values = this->getElements();
+    auto clampedValues = destination->getMutableElements();
+    auto valuesCount = static_cast<size_t>(this->getRows()) * this->getColumns();
 
+    forEachSpan(valuesCount, spansCountFor(valuesCount, MIN_VALUES_PER_TASK, scheduler), scheduler, [values, clampedValues, min, max](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            auto value = values[i];
+            clampedValues[i] = value < min ? min : (value > max ? max : value);
         }
-    }
-
-    return new Channel(
-        this->maxTheoreticalValue,
-        clampedChannelValues,
-        this->getRows(),
-        this->getColumns(),
-        this->getMatrixLayout()
-    );
+    });
 }
 
 
@@ -158,37 +235,692 @@ IEEE754_t Channel<IEEE754_t>::outputPixel(unsigned int row, unsigned int column,
 }
 
 
+/*
+ * Calls `store(row, column, value)` with the filtered value of each pixel of `region`, the same value `outputPixel` would return.
+ * With a `step` greater than 1, only the pixels whose row and column are multiples of `step` are filtered, `region` must then start on one.
+ *
+ * Only the input pixels of the region plus the halo of the kernel around it are read. When the kernel window of a pixel lies within
+ * the channel, its values are read straight from the storage; the padding strategy is only asked for the windows that cross the
+ * channel boundaries, therefore the cost grows with the area of the region and not with the one of the channel.
+ */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
-Channel<IEEE754_t> *Channel<IEEE754_t>::filtered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
-    auto filteredElements = new IEEE754_t[this->getRows() * this->getColumns()];
+template<typename Accumulator, typename Store>
+void Channel<IEEE754_t>::forEachFilteredPixel(const MatrixRegion &region, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, Store store, unsigned int step) const {
+    assert(usingKernel != nullptr);
+    assert(withPaddingStrategy != nullptr);
+    assert(region.isWithin(this->getRows(), this->getColumns()));
+    assert(step > 0 && region.row % step == 0 && region.column % step == 0);
+
+    auto kernelColumns = static_cast<int>(usingKernel->getColumns());
+    auto lowerRowOffset = usingKernel->getLowerBoundRowIndex();
+    auto upperRowOffset = usingKernel->getUpperBoundRowIndex();
+    auto lowerColumnOffset = usingKernel->getLowerBoundColumnIndex();
+    auto upperColumnOffset = usingKernel->getUpperBoundColumnIndex();
+
+    // Reused across calls, so that filtering into a recycled channel (see `ChannelPool`) allocates nothing once warmed up.
+    thread_local std::vector<Accumulator> kernelValues;
+    kernelValues.clear();
+
+    for (int i = lowerRowOffset; i <= upperRowOffset; i++) {
+        for (int j = lowerColumnOffset; j <= upperColumnOffset; j++) {
+            kernelValues.push_back(usingKernel->getValue(i, j));
+        }
+    }
 
-    for (int i = 0; i < this->getRows(); i++) {
-        for (int j = 0; j < this->getColumns(); j++) {
-            auto filteredChannelValue = round(this->outputPixel(i, j, usingKernel, withPaddingStrategy));
+    auto rows = static_cast<int>(this->getRows());
+    auto columns = static_cast<int>(this->getColumns());
+    auto elements = this->getElements();
 
-            if (this->getMatrixLayout() == ROW_MAJOR) {
-                filteredElements[i * this->getColumns() + j] = filteredChannelValue;
+    // Strides aren't constant across tiles, tiled channels are filtered from row-major copies of their tiles instead.
+    if (this->getMatrixLayout() == TILED) {
+        this->forEachBlockWithHalo(region, lowerRowOffset, upperRowOffset, lowerColumnOffset, upperColumnOffset, withPaddingStrategy,
+            [usingKernel, kernelColumns, store, step](const MatrixRegion& block, const IEEE754_t* values, int stride) {
+                accumulateBlock<Accumulator>(block, values, stride, kernelValues.data(), static_cast<int>(usingKernel->getRows()), kernelColumns, store, step);
+            }
+        );
+        return;
+    }
+
+    auto rowStride = this->getMatrixLayout() == ROW_MAJOR ? columns : 1;
+    auto columnStride = this->getMatrixLayout() == ROW_MAJOR ? 1 : rows;
+
+    for (int row = static_cast<int>(region.row); row < static_cast<int>(region.getLastRow()); row += static_cast<int>(step)) {
+        auto isWindowWithinRows = row + lowerRowOffset >= 0 && row + upperRowOffset < rows;
+
+        for (int column = static_cast<int>(region.column); column < static_cast<int>(region.getLastColumn()); column += static_cast<int>(step)) {
+            auto isWindowWithinChannel = isWindowWithinRows && column + lowerColumnOffset >= 0 && column + upperColumnOffset < columns;
+            Accumulator accumulatedFilterValue = 0;
+
+            if (isWindowWithinChannel) {
+                auto windowOrigin = elements + (row + lowerRowOffset) * rowStride + (column + lowerColumnOffset) * columnStride;
+                auto kernelValue = kernelValues.data();
+
+                for (int i = lowerRowOffset; i <= upperRowOffset; i++) {
+                    auto windowRow = windowOrigin + (i - lowerRowOffset) * rowStride;
+
+                    for (int j = 0; j < kernelColumns; j++) {
+                        accumulatedFilterValue += static_cast<Accumulator>(windowRow[j * columnStride]) * *kernelValue++;
+                    }
+                }
             } else {
-                filteredElements[i + this->getRows() * j] = filteredChannelValue;
+                auto kernelValue = kernelValues.data();
+
+                for (int i = lowerRowOffset; i <= upperRowOffset; i++) {
+                    for (int j = lowerColumnOffset; j <= upperColumnOffset; j++) {
+                        accumulatedFilterValue += static_cast<Accumulator>(withPaddingStrategy->pad(*this, row + i, column + j)) * *kernelValue++;
+                    }
+                }
             }
+
+            store(row, column, static_cast<IEEE754_t>(accumulatedFilterValue));
         }
     }
+}
+
+
+/*
+ * Accumulates the kernel whose values are flattened in `kernelValues` over every pixel of `block`, reading the windows from `values`, that
+ * starts at the kernel offset (`rowOffset`, `columnOffset`) of the block halo. The order of summation is the one of `outputPixel`.
+ * With a `step` greater than 1, only the pixels whose row and column in the channel are multiples of `step` are accumulated.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Accumulator, typename Store>
+void Channel<IEEE754_t>::accumulateBlock(const MatrixRegion &block, const IEEE754_t *values, int stride, const Accumulator *kernelValues, int kernelRows, int kernelColumns, Store store, unsigned int step) {
+    for (unsigned int row = (step - block.row % step) % step; row < block.rows; row += step) {
+        for (unsigned int column = (step - block.column % step) % step; column < block.columns; column += step) {
+            auto windowOrigin = values + row * stride + column;
+            auto kernelValue = kernelValues;
+            Accumulator accumulatedFilterValue = 0;
+
+            for (int i = 0; i < kernelRows; i++) {
+                auto windowRow = windowOrigin + i * stride;
+
+                for (int j = 0; j < kernelColumns; j++) {
+                    accumulatedFilterValue += static_cast<Accumulator>(windowRow[j]) * *kernelValue++;
+                }
+            }
+
+            store(block.row + row, block.column + column, static_cast<IEEE754_t>(accumulatedFilterValue));
+        }
+    }
+}
+
+
+/*
+ * Apparently normalizing and rescaling to fit [0, maxValue] is not the way as it doesn't preserve brightness relationships between pixels.
+ * Well known projects such as OpenCV use clamping instead. This strategy is known as saturate_cast.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+IEEE754_t Channel<IEEE754_t>::saturated(IEEE754_t filteredValue) const {
+    return std::clamp(std::round(filteredValue), static_cast<IEEE754_t>(0), static_cast<IEEE754_t>(this->getMaxTheoreticalValue()));
+}
+
+
+/*
+ * Like `filterStridedInto` with a kernel that isn't separable, but the filtered values are stored as they are, neither rounded nor clamped,
+ * for stages that keep working on them before producing a channel (e.g. `LumaChromaFilter`, whose planes can be negative).
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::filterUnsaturatedInto(IEEE754_t *destination, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, unsigned int stride) const {
+    assert(destination != nullptr);
+
+    auto outputRows = stridedSize(this->getRows(), stride);
+    auto outputColumns = stridedSize(this->getColumns(), stride);
+    auto layout = this->getMatrixLayout();
+
+    this->forEachFilteredPixel({0, 0, this->getRows(), this->getColumns()}, usingKernel, withPaddingStrategy,
+        [destination, stride, outputRows, outputColumns, layout](unsigned int row, unsigned int column, IEEE754_t filteredValue) {
+            destination[flatIndexOf(row / stride, column / stride, outputRows, outputColumns, layout)] = filteredValue;
+        },
+        stride
+    );
+}
+
+/*
+ * Computes the filtered values of the rows in [firstRow, lastRow[ and stores them in `destination`, that is expected to hold
+ * `getRows() * getColumns()` elements with the same layout as this channel. Rows outside of the range are left untouched, so that
+ * disjoint ranges of the same channel can be filtered concurrently into the same buffer.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Accumulator>
+void Channel<IEEE754_t>::filterRowsInto(IEEE754_t *destination, unsigned int firstRow, unsigned int lastRow, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(destination != nullptr);
+    assert(firstRow <= lastRow && lastRow <= this->getRows());
+    INSTRUMENTATION_SCOPE("Channel::filtered");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, (lastRow - firstRow) * this->getColumns());
+
+    auto rows = this->getRows();
+    auto columns = this->getColumns();
+    auto layout = this->getMatrixLayout();
+
+    this->template forEachFilteredPixel<Accumulator>({firstRow, 0, lastRow - firstRow, columns}, usingKernel, withPaddingStrategy,
+        [this, destination, rows, columns, layout](unsigned int row, unsigned int column, IEEE754_t filteredValue) {
+            destination[flatIndexOf(row, column, rows, columns, layout)] = this->saturated(filteredValue);
+        }
+    );
+}
+
+
+/*
+ * Filters only the pixels of `region`, and returns them as a channel of `region.rows * region.columns` pixels, with the same layout and
+ * maximum value of this channel. Pixel (i, j) of the output equals pixel (region.row + i, region.column + j) of `filtered`.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *Channel<IEEE754_t>::filteredRegion(const MatrixRegion &region, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(!region.isEmpty());
+    INSTRUMENTATION_SCOPE("Channel::filteredRegion");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, region.rows * region.columns);
+
+    auto filteredElements = new IEEE754_t[region.rows * region.columns];
+    auto layout = this->getMatrixLayout();
+
+    this->forEachFilteredPixel(region, usingKernel, withPaddingStrategy,
+        [this, filteredElements, &region, layout](unsigned int row, unsigned int column, IEEE754_t filteredValue) {
+            auto regionRow = row - region.row;
+            auto regionColumn = column - region.column;
+
+            filteredElements[flatIndexOf(regionRow, regionColumn, region.rows, region.columns, layout)] = this->saturated(filteredValue);
+        }
+    );
+
+    auto filteredChannel = new Channel(this->getMaxTheoreticalValue(), filteredElements, region.rows, region.columns, this->getMatrixLayout());
+    delete[] filteredElements;
+
+    return filteredChannel;
+}
+
+
+/*
+ * `Accumulator` is the type the products of the kernel and the channel values are summed in, by default the type of the channel.
+ * A wider type (e.g. `double` for a `float` channel) trades speed for accuracy, a narrower one the other way round; `AccumulationPolicy`
+ * gives the error bound of each combination.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Accumulator>
+Channel<IEEE754_t> *Channel<IEEE754_t>::filtered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    auto filteredElements = new IEEE754_t[this->getRows() * this->getColumns()];
+    this->template filterRowsInto<Accumulator>(filteredElements, 0, this->getRows(), usingKernel, withPaddingStrategy);
 
     auto filteredChannel = new Channel<IEEE754_t>(this->getMaxTheoreticalValue(), filteredElements, this->getRows(), this->getColumns(), this->getMatrixLayout());
+    delete[] filteredElements;
 
-    // Apparently normalizing and rescaling to fit [0, maxValue] is not the way as it doesn't preserve brightness relationships between pixels.
-    // Well known projects such as OpenCV use clamping instead. This strategy is known as saturate_cast.
-    return filteredChannel->clamped(0, this->getMaxTheoreticalValue());
+    return filteredChannel;
+}
+
+/*
+ * Filters this channel as planned by `plan`, which must have been made for its size and layout. The planning decisions were all taken
+ * when the plan was made, this only dispatches on the chosen strategy.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *Channel<IEEE754_t>::filtered(const ConvolutionPlan<IEEE754_t> *plan) const {
+    assert(plan != nullptr);
+
+    auto filteredChannel = new Channel(this->getMaxTheoreticalValue(), this->getRows(), this->getColumns(), this->getMatrixLayout());
+    plan->execute(this, filteredChannel);
+
+    return filteredChannel;
+}
+
+
+/*
+ * Filters this channel with each kernel of `usingKernels`, and returns the filtered channels in the same order; the i-th one equals
+ * `filtered(usingKernels[i], withPaddingStrategy)`.
+ *
+ * Rather than a pass over the channel per kernel, the channel is walked once, a block at a time: each block is gathered along with the halo of
+ * the largest kernel window, then every kernel of the bank runs over it while it's still in cache. Kernels of different sizes can be mixed.
+ * Banks of at least `IM2COL_MIN_KERNELS` kernels go through `Im2colConvolution` instead, which reuses each gathered value across kernels,
+ * unless they're summed in an `Accumulator` (see `filtered`) other than the type of the channel.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Accumulator>
+std::vector<Channel<IEEE754_t> *> Channel<IEEE754_t>::filteredBank(std::span<const ConvolutionKernel<IEEE754_t>* const> usingKernels, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(!usingKernels.empty());
+    assert(withPaddingStrategy != nullptr);
+
+    // The matrix product of `Im2colConvolution` sums in the type of the channel.
+    if (std::is_same_v<Accumulator, IEEE754_t> && usingKernels.size() >= IM2COL_MIN_KERNELS) {
+        return Im2colConvolution<IEEE754_t>(usingKernels).filtered(this, withPaddingStrategy);
+    }
+
+    INSTRUMENTATION_SCOPE("Channel::filteredBank");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, this->getRows() * this->getColumns() * usingKernels.size());
+
+    struct BankKernel {
+        std::vector<Accumulator> values;
+        const ConvolutionKernel<IEEE754_t>* kernel;
+        IEEE754_t* destination;
+    };
+
+    auto rows = this->getRows();
+    auto columns = this->getColumns();
+    auto layout = this->getMatrixLayout();
+
+    auto lowerRowOffset = 0;
+    auto upperRowOffset = 0;
+    auto lowerColumnOffset = 0;
+    auto upperColumnOffset = 0;
+
+    auto bank = std::vector<BankKernel>();
+
+    for (auto kernel : usingKernels) {
+        assert(kernel != nullptr);
+
+        auto kernelValues = std::vector<Accumulator>();
+        for (int i = kernel->getLowerBoundRowIndex(); i <= kernel->getUpperBoundRowIndex(); i++) {
+            for (int j = kernel->getLowerBoundColumnIndex(); j <= kernel->getUpperBoundColumnIndex(); j++) {
+                kernelValues.push_back(static_cast<Accumulator>(kernel->getValue(i, j)));
+            }
+        }
+
+        lowerRowOffset = std::min(lowerRowOffset, kernel->getLowerBoundRowIndex());
+        upperRowOffset = std::max(upperRowOffset, kernel->getUpperBoundRowIndex());
+        lowerColumnOffset = std::min(lowerColumnOffset, kernel->getLowerBoundColumnIndex());
+        upperColumnOffset = std::max(upperColumnOffset, kernel->getUpperBoundColumnIndex());
+
+        bank.push_back({kernelValues, kernel, new IEEE754_t[rows * columns]});
+    }
+
+    this->forEachBlockWithHalo({0, 0, rows, columns}, lowerRowOffset, upperRowOffset, lowerColumnOffset, upperColumnOffset, withPaddingStrategy,
+        [this, &bank, rows, columns, layout, lowerRowOffset, lowerColumnOffset](const MatrixRegion& block, const IEEE754_t* values, int stride) {
+            for (const auto& bankKernel : bank) {
+                // The window of a smaller kernel starts inside the halo of the largest one.
+                auto kernelOrigin = values +
+                    (bankKernel.kernel->getLowerBoundRowIndex() - lowerRowOffset) * stride +
+                    (bankKernel.kernel->getLowerBoundColumnIndex() - lowerColumnOffset);
+                auto destination = bankKernel.destination;
+
+                accumulateBlock<Accumulator>(block, kernelOrigin, stride, bankKernel.values.data(), bankKernel.kernel->getRows(), bankKernel.kernel->getColumns(),
+                    [this, destination, rows, columns, layout](unsigned int row, unsigned int column, IEEE754_t filteredValue) {
+                        destination[flatIndexOf(row, column, rows, columns, layout)] = this->saturated(filteredValue);
+                    }
+                );
+            }
+        }
+    );
+
+    auto filteredChannels = std::vector<Channel *>();
+    for (const auto& bankKernel : bank) {
+        filteredChannels.push_back(new Channel(this->getMaxTheoreticalValue(), bankKernel.destination, rows, columns, layout));
+        delete[] bankKernel.destination;
+    }
+
+    return filteredChannels;
+}
+
+
+/*
+ * Same as `filtered`, but the output goes to `destination`, an existing channel of the same size and layout (e.g. one from `ChannelPool`),
+ * whose previous values, maximum value and edit tracking are discarded. Nothing is allocated, once the first call warmed up the buffers.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::filteredInto(Channel *destination, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(destination != nullptr && destination != this);
+    assert(destination->getRows() == this->getRows() && destination->getColumns() == this->getColumns());
+    assert(destination->getMatrixLayout() == this->getMatrixLayout());
+
+    destination->recycle(this->getMaxTheoreticalValue());
+    this->filterRowsInto(destination->getMutableElements(), 0, this->getRows(), usingKernel, withPaddingStrategy);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::filteredInto(Channel *destination, const ConvolutionPlan<IEEE754_t> *plan) const {
+    assert(plan != nullptr);
+    plan->execute(this, destination);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int Channel<IEEE754_t>::stridedSize(unsigned int size, unsigned int stride) {
+    assert(stride > 0);
+    return (size + stride - 1) / stride;
+}
+
+/*
+ * Filters only the pixels whose row and column are multiples of `stride`, i.e. decimates while filtering: the output is a
+ * `stridedSize(getRows(), stride)` x `stridedSize(getColumns(), stride)` channel with the layout of this one, stored in `destination`,
+ * and its pixel (i, j) is pixel (i * stride, j * stride) of `filtered`.
+ *
+ * Separable kernels (e.g. the gaussian one) are applied as a vertical pass on the sampled rows, followed by a horizontal pass on the sampled
+ * columns, which takes O(k) operations per pixel instead of O(k^2); the result then matches `filtered` up to rounding. `scratch` holds the
+ * output of the vertical pass, kept in `Accumulator` (see `filtered`), and is only grown, so that it can be reused across calls (see
+ * `GaussianPyramid`).
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Accumulator>
+void Channel<IEEE754_t>::filterStridedInto(IEEE754_t *destination, std::vector<Accumulator> &scratch, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, unsigned int stride) const {
+    assert(destination != nullptr);
+    assert(usingKernel != nullptr);
+    assert(withPaddingStrategy != nullptr);
+    INSTRUMENTATION_SCOPE("Channel::filteredStrided");
+
+    auto rows = static_cast<int>(this->getRows());
+    auto columns = static_cast<int>(this->getColumns());
+    auto outputRows = stridedSize(rows, stride);
+    auto outputColumns = stridedSize(columns, stride);
+    auto layout = this->getMatrixLayout();
+
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, outputRows * outputColumns);
+
+    if (!usingKernel->isSeparable()) {
+        this->template forEachFilteredPixel<Accumulator>({0, 0, this->getRows(), this->getColumns()}, usingKernel, withPaddingStrategy,
+            [this, destination, stride, outputRows, outputColumns, layout](unsigned int row, unsigned int column, IEEE754_t filteredValue) {
+                destination[flatIndexOf(row / stride, column / stride, outputRows, outputColumns, layout)] = this->saturated(filteredValue);
+            },
+            stride
+        );
+        return;
+    }
+
+    const auto& columnFactor = usingKernel->getColumnFactor();
+    const auto& rowFactor = usingKernel->getRowFactor();
+    auto lowerRowOffset = usingKernel->getLowerBoundRowIndex();
+    auto lowerColumnOffset = usingKernel->getLowerBoundColumnIndex();
+
+    // The vertical pass also covers the columns of the horizontal halo, so that the padded values are the ones the 2D kernel would read.
+    auto extendedColumns = static_cast<size_t>(columns) + rowFactor.size() - 1;
+    if (scratch.size() < extendedColumns) {
+        scratch.resize(extendedColumns);
+    }
+
+    auto elements = this->getElements();
+
+    for (unsigned int outputRow = 0; outputRow < outputRows; outputRow++) {
+        auto row = static_cast<int>(outputRow * stride);
+        auto isWindowWithinRows = row + lowerRowOffset >= 0 && row + lowerRowOffset + static_cast<int>(columnFactor.size()) <= rows;
+
+        for (size_t extendedColumn = 0; extendedColumn < extendedColumns; extendedColumn++) {
+            auto column = static_cast<int>(extendedColumn) + lowerColumnOffset;
+            auto isWithinColumns = column >= 0 && column < columns;
+            Accumulator accumulatedValue = 0;
+
+            for (size_t i = 0; i < columnFactor.size(); i++) {
+                auto inputRow = row + lowerRowOffset + static_cast<int>(i);
+                auto value = isWindowWithinRows && isWithinColumns ?
+                    elements[flatIndexOf(inputRow, column, rows, columns, layout)] :
+                    withPaddingStrategy->pad(*this, inputRow, column);
+
+                accumulatedValue += static_cast<Accumulator>(value) * static_cast<Accumulator>(columnFactor[i]);
+            }
+
+            scratch[extendedColumn] = accumulatedValue;
+        }
+
+        for (unsigned int outputColumn = 0; outputColumn < outputColumns; outputColumn++) {
+            auto window = scratch.data() + outputColumn * stride;
+            Accumulator accumulatedValue = 0;
+
+            for (size_t j = 0; j < rowFactor.size(); j++) {
+                accumulatedValue += window[j] * static_cast<Accumulator>(rowFactor[j]);
+            }
+
+            destination[flatIndexOf(outputRow, outputColumn, outputRows, outputColumns, layout)] = this->saturated(static_cast<IEEE754_t>(accumulatedValue));
+        }
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *Channel<IEEE754_t>::filteredStrided(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, unsigned int stride) const {
+    auto outputRows = stridedSize(this->getRows(), stride);
+    auto outputColumns = stridedSize(this->getColumns(), stride);
+
+    auto filteredElements = new IEEE754_t[outputRows * outputColumns];
+    auto scratch = std::vector<IEEE754_t>();
+
+    this->filterStridedInto(filteredElements, scratch, usingKernel, withPaddingStrategy, stride);
+
+    auto filteredChannel = new Channel(this->getMaxTheoreticalValue(), filteredElements, outputRows, outputColumns, this->getMatrixLayout());
+    delete[] filteredElements;
+
+    return filteredChannel;
 }
 
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 [[nodiscard]] Channel<IEEE754_t>* Channel<IEEE754_t>::transposedChannel() const {
-    return new Channel(this->maxTheoreticalValue, this->transposed());
+    auto transposedChannel = new Channel(this->maxTheoreticalValue, this->getColumns(), this->getRows(), this->getMatrixLayout());
+    this->transposedInto(transposedChannel);
+
+    return transposedChannel;
+}
+
+/*
+ * Same as `transposedChannel`, but the output goes to `destination`, an existing channel of the transposed size and the same layout.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::transposedInto(Channel *destination) const {
+    assert(destination != nullptr && destination != this);
+    assert(destination->getRows() == this->getColumns() && destination->getColumns() == this->getRows());
+    assert(destination->getMatrixLayout() == this->getMatrixLayout());
+
+    auto rows = this->getRows();
+    auto columns = this->getColumns();
+    auto layout = this->getMatrixLayout();
+    auto elements = this->getElements();
+
+    destination->recycle(this->maxTheoreticalValue);
+    auto transposedElements = destination->getMutableElements();
+
+    for (unsigned int row = 0; row < rows; row++) {
+        for (unsigned int column = 0; column < columns; column++) {
+            transposedElements[flatIndexOf(column, row, columns, rows, layout)] = elements[flatIndexOf(row, column, rows, columns, layout)];
+        }
+    }
+}
+
+/*
+ * Returns a copy of this channel stored with `layout`, converted in a single pass over the storage.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *Channel<IEEE754_t>::withLayout(MatrixLayout layout) const {
+    auto rows = this->getRows();
+    auto columns = this->getColumns();
+    auto elements = this->getElements();
+    auto relaidOutElements = new IEEE754_t[rows * columns];
+
+    for (unsigned int row = 0; row < rows; row++) {
+        for (unsigned int column = 0; column < columns; column++) {
+            relaidOutElements[flatIndexOf(row, column, rows, columns, layout)] = elements[flatIndexOf(row, column, rows, columns, this->getMatrixLayout())];
+        }
+    }
+
+    auto relaidOutChannel = new Channel(this->maxTheoreticalValue, relaidOutElements, rows, columns, layout);
+    delete[] relaidOutElements;
+
+    return relaidOutChannel;
+}
+
+
+/*
+ * Dirty regions are kept as a list of rectangles, so that a few scattered edits don't trigger the re-filtering of everything in between.
+ * Past a handful of rectangles, tracking them costs more than it saves, and they're merged into their bounding box.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::markDirty(const MatrixRegion &region) {
+    constexpr size_t maxDirtyRegions = 32;
+
+    for (const auto& dirtyRegion : this->dirtyRegions) {
+        if (region.row >= dirtyRegion.row && region.getLastRow() <= dirtyRegion.getLastRow() &&
+            region.column >= dirtyRegion.column && region.getLastColumn() <= dirtyRegion.getLastColumn()) {
+            return;
+        }
+    }
+
+    this->dirtyRegions.push_back(region);
+
+    if (this->dirtyRegions.size() > maxDirtyRegions) {
+        auto boundingBox = this->dirtyRegions.front();
+
+        for (const auto& dirtyRegion : this->dirtyRegions) {
+            auto lastRow = std::max(boundingBox.getLastRow(), dirtyRegion.getLastRow());
+            auto lastColumn = std::max(boundingBox.getLastColumn(), dirtyRegion.getLastColumn());
+
+            boundingBox.row = std::min(boundingBox.row, dirtyRegion.row);
+            boundingBox.column = std::min(boundingBox.column, dirtyRegion.column);
+            boundingBox.rows = lastRow - boundingBox.row;
+            boundingBox.columns = lastColumn - boundingBox.column;
+        }
+
+        this->dirtyRegions = {boundingBox};
+    }
+}
+
+/*
+ * Prepares the channel to be overwritten with new contents: they'll have `maxValue` as maximum value, and nothing of the previous ones is kept.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::recycle(unsigned int maxValue) {
+    this->maxTheoreticalValue = maxValue;
+    this->dirtyRegions.clear();
+
+    delete this->lastFilteredChannel;
+    this->lastFilteredChannel = nullptr;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::setValue(unsigned int row, unsigned int column, IEEE754_t value) {
+    assert(row < this->getRows() && column < this->getColumns());
+    assert(value <= this->maxTheoreticalValue);
+
+    this->getMutableElements()[flatIndexOf(row, column, this->getRows(), this->getColumns(), this->getMatrixLayout())] = value;
+
+    this->markDirty({row, column, 1, 1});
+}
+
+/*
+ * Overwrites the pixels of `region` with `values`, that must have the same size of the region.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void Channel<IEEE754_t>::setRegion(const MatrixRegion &region, const Matrix<IEEE754_t> *values) {
+    assert(values != nullptr);
+    assert(region.isWithin(this->getRows(), this->getColumns()));
+    assert(values->getRows() == region.rows && values->getColumns() == region.columns);
+
+    auto elements = this->getMutableElements();
+
+    for (unsigned int i = 0; i < region.rows; i++) {
+        for (unsigned int j = 0; j < region.columns; j++) {
+            auto row = region.row + i;
+            auto column = region.column + j;
+
+            assert(values->at(i, j) <= this->maxTheoreticalValue);
+            elements[flatIndexOf(row, column, this->getRows(), this->getColumns(), this->getMatrixLayout())] = values->at(i, j);
+        }
+    }
+
+    if (!region.isEmpty()) {
+        this->markDirty(region);
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const std::vector<MatrixRegion> &Channel<IEEE754_t>::getDirtyRegions() const {
+    return this->dirtyRegions;
+}
+
+/*
+ * Returns this channel filtered with `usingKernel` and `withPaddingStrategy`, like `filtered` would, but reusing the output of the previous call
+ * with the same kernel and padding strategy: only the pixels changed since then (through `setValue` and `setRegion`), dilated by the kernel halo,
+ * are filtered again. Kernels are matched by their values, so that a kernel freed and another allocated at its address aren't mistaken for
+ * each other, and padding strategies, which hold no state, by their type.
+ *
+ * If the padding strategy isn't local, an edit near the boundaries may affect outputs on the other side of the channel, in which case (as well as
+ * for the first call, or a call with another kernel, padding strategy or `Accumulator`) the whole channel is filtered again.
+ *
+ * The returned channel is owned by this channel, and stays valid until the next call or its destruction.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Accumulator>
+const Channel<IEEE754_t> *Channel<IEEE754_t>::refiltered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) {
+    assert(usingKernel != nullptr);
+    assert(withPaddingStrategy != nullptr);
+
+    auto rows = this->getRows();
+    auto columns = this->getColumns();
+
+    auto kernelValues = valuesOf(usingKernel);
+    auto requiresFullPass = this->lastFilteredChannel == nullptr ||
+        this->lastFilteringKernelRows != usingKernel->getRows() ||
+        this->lastFilteringKernelColumns != usingKernel->getColumns() ||
+        this->lastFilteringKernelValues != kernelValues ||
+        this->lastFilteringPaddingType != &typeid(*withPaddingStrategy) ||
+        this->lastFilteringAccumulatorDigits != std::numeric_limits<Accumulator>::digits;
+
+    if (!requiresFullPass && !withPaddingStrategy->isLocal()) {
+        // Values read through the padding come from a band as wide as the kernel along the boundaries, as long as the kernel fits in the channel.
+        auto borderRows = usingKernel->getRows();
+        auto borderColumns = usingKernel->getColumns();
+
+        for (const auto& dirtyRegion : this->dirtyRegions) {
+            requiresFullPass = requiresFullPass ||
+                2 * borderRows >= rows || 2 * borderColumns >= columns ||
+                dirtyRegion.row < borderRows || dirtyRegion.getLastRow() + borderRows > rows ||
+                dirtyRegion.column < borderColumns || dirtyRegion.getLastColumn() + borderColumns > columns;
+        }
+    }
+
+    if (requiresFullPass) {
+        delete this->lastFilteredChannel;
+
+        this->lastFilteredChannel = this->template filtered<Accumulator>(usingKernel, withPaddingStrategy);
+        this->lastFilteringKernelValues = std::move(kernelValues);
+        this->lastFilteringKernelRows = usingKernel->getRows();
+        this->lastFilteringKernelColumns = usingKernel->getColumns();
+        this->lastFilteringPaddingType = &typeid(*withPaddingStrategy);
+        this->lastFilteringAccumulatorDigits = std::numeric_limits<Accumulator>::digits;
+        this->dirtyRegions.clear();
+
+        return this->lastFilteredChannel;
+    }
+
+    auto destination = this->lastFilteredChannel->getMutableElements();
+    auto layout = this->getMatrixLayout();
+
+    for (const auto& dirtyRegion : this->dirtyRegions) {
+        // The input pixel at `p` is read by the outputs at `p - i` for each kernel offset `i`.
+        auto firstRow = std::max(static_cast<int>(dirtyRegion.row) - usingKernel->getUpperBoundRowIndex(), 0);
+        auto lastRow = std::min(static_cast<int>(dirtyRegion.getLastRow()) - usingKernel->getLowerBoundRowIndex(), static_cast<int>(rows));
+        auto firstColumn = std::max(static_cast<int>(dirtyRegion.column) - usingKernel->getUpperBoundColumnIndex(), 0);
+        auto lastColumn = std::min(static_cast<int>(dirtyRegion.getLastColumn()) - usingKernel->getLowerBoundColumnIndex(), static_cast<int>(columns));
+
+        auto affectedRegion = MatrixRegion{
+            static_cast<unsigned int>(firstRow),
+            static_cast<unsigned int>(firstColumn),
+            static_cast<unsigned int>(lastRow - firstRow),
+            static_cast<unsigned int>(lastColumn - firstColumn)
+        };
+
+        INSTRUMENTATION_SCOPE("Channel::refiltered");
+        INSTRUMENTATION_COUNT(PIXELS_PROCESSED, affectedRegion.rows * affectedRegion.columns);
+
+        this->template forEachFilteredPixel<Accumulator>(affectedRegion, usingKernel, withPaddingStrategy,
+            [this, destination, rows, columns, layout](unsigned int row, unsigned int column, IEEE754_t filteredValue) {
+                destination[flatIndexOf(row, column, rows, columns, layout)] = this->saturated(filteredValue);
+            }
+        );
+    }
+
+    this->dirtyRegions.clear();
+    return this->lastFilteredChannel;
 }
 
 
 
 template class Channel<float>;
 template class Channel<double>;
-template class Channel<long double>;
\ No newline at end of file
+template class Channel<long double>;
+
+#define IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(IEEE754_t, Accumulator) \
+    template Channel<IEEE754_t>* Channel<IEEE754_t>::filtered<Accumulator>(const ConvolutionKernel<IEEE754_t>*, const MatrixPaddingStrategy<IEEE754_t>*) const; \
+    template void Channel<IEEE754_t>::filterRowsInto<Accumulator>(IEEE754_t*, unsigned int, unsigned int, const ConvolutionKernel<IEEE754_t>*, const MatrixPaddingStrategy<IEEE754_t>*) const; \
+    template std::vector<Channel<IEEE754_t>*> Channel<IEEE754_t>::filteredBank<Accumulator>(std::span<const ConvolutionKernel<IEEE754_t>* const>, const MatrixPaddingStrategy<IEEE754_t>*) const; \
+    template void Channel<IEEE754_t>::filterStridedInto<Accumulator>(IEEE754_t*, std::vector<Accumulator>&, const ConvolutionKernel<IEEE754_t>*, const MatrixPaddingStrategy<IEEE754_t>*, unsigned int) const; \
+    template const Channel<IEEE754_t>* Channel<IEEE754_t>::refiltered<Accumulator>(const ConvolutionKernel<IEEE754_t>*, const MatrixPaddingStrategy<IEEE754_t>*);
+
+IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(float, float)
+IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(float, double)
+IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(float, long double)
+IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(double, float)
+IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(double, double)
+IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(double, long double)
+IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(long double, float)
+IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(long double, double)
+IMAGECONVOLUTIONKERNEL_INSTANTIATE_ACCUMULATOR(long double, long double)
@@ -1,20 +1,85 @@
 #ifndef IMAGECONVOLUTIONKERNEL_CHANNEL_H
 #define IMAGECONVOLUTIONKERNEL_CHANNEL_H
 
+#include <span>
+#include <utility>
 #include <type_traits>
+#include <typeinfo>
+#include <vector>
 #include <gtest/gtest_prod.h>
 
 #include "../ConvolutionKernel/ConvolutionKernel.h"
 #include "../Matrix/Matrix.h"
+#include "../Matrix/MatrixRegion.h"
 #include "../MatrixPaddingStrategy/MatrixPaddingStrategy.h"
 
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class EdgeDetector;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class ChannelPool;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class Im2colConvolution;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class WinogradConvolution;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class RankFilter;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class Morphology;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class BilateralFilter;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class GuidedFilter;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class ShardedConvolution;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class ConvolutionPlan;
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class LumaChromaFilter;
+
+class WorkStealingScheduler;
+
 template<typename IEEE754_t>
     requires std::is_floating_point_v<IEEE754_t>
 class Channel: public Matrix<IEEE754_t> {
+    friend class EdgeDetector<IEEE754_t>;
+    friend class ChannelPool<IEEE754_t>;
+    friend class Im2colConvolution<IEEE754_t>;
+    friend class WinogradConvolution<IEEE754_t>;
+    friend class RankFilter<IEEE754_t>;
+    friend class Morphology<IEEE754_t>;
+    friend class BilateralFilter<IEEE754_t>;
+    friend class GuidedFilter<IEEE754_t>;
+    friend class ShardedConvolution<IEEE754_t>;
+    friend class ConvolutionPlan<IEEE754_t>;
+    friend class LumaChromaFilter<IEEE754_t>;
 
 private:
     unsigned int maxTheoreticalValue;
+
+    std::vector<MatrixRegion> dirtyRegions;
+    std::vector<IEEE754_t> lastFilteringKernelValues;
+    unsigned int lastFilteringKernelRows = 0;
+    unsigned int lastFilteringKernelColumns = 0;
+    const std::type_info* lastFilteringPaddingType = nullptr;
+    int lastFilteringAccumulatorDigits = 0;
+    Channel* lastFilteredChannel = nullptr;
+
+    Channel(unsigned int maxValue, unsigned int rows, unsigned int columns, MatrixLayout layout);
+    Channel(BorrowedStorage, unsigned int maxValue, IEEE754_t* elements, unsigned int rows, unsigned int columns, MatrixLayout layout);
+
     bool isWithinMaxThreshold();
+    void markDirty(const MatrixRegion& region);
+    void recycle(unsigned int maxValue);
     IEEE754_t outputPixel(
         unsigned int row,
         unsigned int column,
@@ -22,18 +87,154 @@ private:
         const MatrixPaddingStrategy<IEEE754_t>* paddingStrategy
     ) const;
 
+    template<typename Visit>
+    void forEachBlockWithHalo(
+        const MatrixRegion& region,
+        int lowerRowOffset,
+        int upperRowOffset,
+        int lowerColumnOffset,
+        int upperColumnOffset,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        Visit visit
+    ) const;
+
+    template<typename Accumulator = IEEE754_t, typename Store>
+    static void accumulateBlock(const MatrixRegion& block, const IEEE754_t* values, int stride, const Accumulator* kernelValues, int kernelRows, int kernelColumns, Store store, unsigned int step = 1);
+
+    template<typename Accumulator = IEEE754_t, typename Store>
+    void forEachFilteredPixel(
+        const MatrixRegion& region,
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        Store store,
+        unsigned int step = 1
+    ) const;
+    [[nodiscard]] IEEE754_t saturated(IEEE754_t filteredValue) const;
+    void filterUnsaturatedInto(
+        IEEE754_t* destination,
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        unsigned int stride = 1
+    ) const;
+
     FRIEND_TEST(ImageChannel, OutputPixelForKernel);
+    FRIEND_TEST(ImageChannel, FilteredRegionMatchesFullFiltering);
 public:
     Channel(unsigned int maxValue, const IEEE754_t* elements, unsigned int rows, unsigned int columns, MatrixLayout layout = ROW_MAJOR);
     Channel(unsigned int maxValue, const Matrix<IEEE754_t>* channelValues);
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+    ~Channel();
+
+    static Channel* borrowing(unsigned int maxValue, IEEE754_t* elements, unsigned int rows, unsigned int columns, MatrixLayout layout = ROW_MAJOR);
 
     [[nodiscard]] unsigned int getMaxTheoreticalValue() const;
-    [[nodiscard]] Channel* normalized() const;
-    [[nodiscard]] Channel* clamped(IEEE754_t min, IEEE754_t max) const;
+    [[nodiscard]] std::pair<IEEE754_t, IEEE754_t> getValueRange(WorkStealingScheduler* scheduler = nullptr) const;
+    [[nodiscard]] Channel* normalized(WorkStealingScheduler* scheduler = nullptr) const;
+    [[nodiscard]] Channel* clamped(IEEE754_t min, IEEE754_t max, WorkStealingScheduler* scheduler = nullptr) const;
+    void normalizedInto(Channel* destination, WorkStealingScheduler* scheduler = nullptr) const;
+    void clampedInto(Channel* destination, IEEE754_t min, IEEE754_t max, WorkStealingScheduler* scheduler = nullptr) const;
+    template<typename Accumulator = IEEE754_t>
     Channel* filtered(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const;
+    Channel* filtered(const ConvolutionPlan<IEEE754_t>* plan) const;
+    template<typename Accumulator = IEEE754_t>
+    std::vector<Channel*> filteredBank(
+        std::span<const ConvolutionKernel<IEEE754_t>* const> usingKernels,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy
+    ) const;
+    Channel* filteredRegion(
+        const MatrixRegion& region,
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy
+    ) const;
+    template<typename Accumulator = IEEE754_t>
+    void filterRowsInto(
+        IEEE754_t* destination,
+        unsigned int firstRow,
+        unsigned int lastRow,
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy
+    ) const;
+    void filteredInto(Channel* destination, const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const;
+    void filteredInto(Channel* destination, const ConvolutionPlan<IEEE754_t>* plan) const;
+    template<typename Accumulator = IEEE754_t>
+    void filterStridedInto(
+        IEEE754_t* destination,
+        std::vector<Accumulator>& scratch,
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        unsigned int stride
+    ) const;
+    Channel* filteredStrided(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy, unsigned int stride) const;
+    [[nodiscard]] static unsigned int stridedSize(unsigned int size, unsigned int stride);
     Channel* transposedChannel() const;
+    void transposedInto(Channel* destination) const;
+    Channel* withLayout(MatrixLayout layout) const;
+
+    void setValue(unsigned int row, unsigned int column, IEEE754_t value);
+    void setRegion(const MatrixRegion& region, const Matrix<IEEE754_t>* values);
+    [[nodiscard]] const std::vector<MatrixRegion>& getDirtyRegions() const;
+    template<typename Accumulator = IEEE754_t>
+    const Channel* refiltered(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy);
 
 
 };
 
+/*
+ * Splits `region` along the storage tiles (blocks of `MATRIX_TILE_SIZE` x `MATRIX_TILE_SIZE` pixels), and calls `visit(block, values, stride)`
+ * with a row-major copy of each block grown by the given halo: `values[0]` is the pixel at (block.row + lowerRowOffset,
+ * block.column + lowerColumnOffset), and `stride` the distance between two of its rows. The copy is gathered straight from the storage,
+ * values out of the channel come from the padding strategy, so the convolution loops over it never need to branch.
+ *
+ * Defined here rather than in Channel.cpp, as the stages built on top of channels (e.g. `EdgeDetector`) instantiate it with their own visitors.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Visit>
+void Channel<IEEE754_t>::forEachBlockWithHalo(const MatrixRegion &region, int lowerRowOffset, int upperRowOffset, int lowerColumnOffset, int upperColumnOffset, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, Visit visit) const {
+    auto rows = static_cast<int>(this->getRows());
+    auto columns = static_cast<int>(this->getColumns());
+    auto layout = this->getMatrixLayout();
+    auto tileSize = static_cast<int>(MATRIX_TILE_SIZE);
+    auto elements = this->getElements();
+
+    thread_local std::vector<IEEE754_t> block;
+
+    for (int blockRow = static_cast<int>(region.row); blockRow < static_cast<int>(region.getLastRow()); ) {
+        auto blockLastRow = std::min(static_cast<int>(region.getLastRow()), (blockRow / tileSize + 1) * tileSize);
+
+        for (int blockColumn = static_cast<int>(region.column); blockColumn < static_cast<int>(region.getLastColumn()); ) {
+            auto blockLastColumn = std::min(static_cast<int>(region.getLastColumn()), (blockColumn / tileSize + 1) * tileSize);
+            auto blockHeight = blockLastRow - blockRow + upperRowOffset - lowerRowOffset;
+            auto blockWidth = blockLastColumn - blockColumn + upperColumnOffset - lowerColumnOffset;
+
+            block.resize(blockHeight * blockWidth);
+
+            for (int i = 0; i < blockHeight; i++) {
+                auto inputRow = blockRow + lowerRowOffset + i;
+
+                for (int j = 0; j < blockWidth; j++) {
+                    auto inputColumn = blockColumn + lowerColumnOffset + j;
+                    auto isWithinChannel = inputRow >= 0 && inputRow < rows && inputColumn >= 0 && inputColumn < columns;
+
+                    block[i * blockWidth + j] = isWithinChannel ?
+                        elements[flatIndexOf(inputRow, inputColumn, rows, columns, layout)] :
+                        withPaddingStrategy->pad(*this, inputRow, inputColumn);
+                }
+            }
+
+            auto visitedBlock = MatrixRegion{
+                static_cast<unsigned int>(blockRow),
+                static_cast<unsigned int>(blockColumn),
+                static_cast<unsigned int>(blockLastRow - blockRow),
+                static_cast<unsigned int>(blockLastColumn - blockColumn)
+            };
+
+            visit(visitedBlock, static_cast<const IEEE754_t*>(block.data()), blockWidth);
+            blockColumn = blockLastColumn;
+        }
+
+        blockRow = blockLastRow;
+    }
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "LumaChromaFilter.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "../Instrumentation/Instrumentation.h"
+
+namespace {
+    // BT.601 full range, as in JPEG.
+    template<typename IEEE754_t>
+    struct YCbCr {
+        static constexpr IEEE754_t RED_LUMA = 0.299;
+        static constexpr IEEE754_t GREEN_LUMA = 0.587;
+        static constexpr IEEE754_t BLUE_LUMA = 0.114;
+
+        static constexpr IEEE754_t RED_BLUE_DIFFERENCE = -0.168736;
+        static constexpr IEEE754_t GREEN_BLUE_DIFFERENCE = -0.331264;
+        static constexpr IEEE754_t BLUE_BLUE_DIFFERENCE = 0.5;
+
+        static constexpr IEEE754_t RED_RED_DIFFERENCE = 0.5;
+        static constexpr IEEE754_t GREEN_RED_DIFFERENCE = -0.418688;
+        static constexpr IEEE754_t BLUE_RED_DIFFERENCE = -0.081312;
+
+        static constexpr IEEE754_t RED_FROM_RED_DIFFERENCE = 1.402;
+        static constexpr IEEE754_t GREEN_FROM_BLUE_DIFFERENCE = -0.344136;
+        static constexpr IEEE754_t GREEN_FROM_RED_DIFFERENCE = -0.714136;
+        static constexpr IEEE754_t BLUE_FROM_BLUE_DIFFERENCE = 1.772;
+    };
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+LumaChromaFilter<IEEE754_t>::LumaChromaFilter(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, ChromaFiltering chromaFiltering) :
+    kernel(usingKernel), paddingStrategy(withPaddingStrategy), chromaFiltering(chromaFiltering) {
+    assert(usingKernel != nullptr);
+    assert(withPaddingStrategy != nullptr);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+ChromaFiltering LumaChromaFilter<IEEE754_t>::getChromaFiltering() const {
+    return this->chromaFiltering;
+}
+
+/*
+ * The filtered red, green and blue channels, in that order. The three channels must have the same size and layout.
+ *
+ * Half resolution chroma samples sit on the even rows and columns; in between, each pixel interpolates the (up to) four samples around it,
+ * and the last row or column of an even-sized channel repeats the sample before it.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+std::vector<Channel<IEEE754_t> *> LumaChromaFilter<IEEE754_t>::filtered(const Channel<IEEE754_t> *red, const Channel<IEEE754_t> *green, const Channel<IEEE754_t> *blue) const {
+    assert(red != nullptr && green != nullptr && blue != nullptr);
+    assert(green->getRows() == red->getRows() && green->getColumns() == red->getColumns() && green->getMatrixLayout() == red->getMatrixLayout());
+    assert(blue->getRows() == red->getRows() && blue->getColumns() == red->getColumns() && blue->getMatrixLayout() == red->getMatrixLayout());
+    INSTRUMENTATION_SCOPE("LumaChromaFilter::filtered");
+
+    using Coefficients = YCbCr<IEEE754_t>;
+
+    auto rows = red->getRows();
+    auto columns = red->getColumns();
+    auto layout = red->getMatrixLayout();
+    auto pixelsCount = static_cast<size_t>(rows) * columns;
+    auto isChromaFiltered = this->chromaFiltering == ChromaFiltering::HALF_RESOLUTION;
+
+    auto redValues = red->getElements();
+    auto greenValues = green->getElements();
+    auto blueValues = blue->getElements();
+
+    // Single pass to YCbCr. As the three channels share their layout, a flat index is the same pixel in each of them.
+    auto luma = std::vector<IEEE754_t>(pixelsCount);
+    auto blueDifference = std::vector<IEEE754_t>(isChromaFiltered ? pixelsCount : 0);
+    auto redDifference = std::vector<IEEE754_t>(isChromaFiltered ? pixelsCount : 0);
+
+    for (size_t i = 0; i < pixelsCount; i++) {
+        auto r = redValues[i];
+        auto g = greenValues[i];
+        auto b = blueValues[i];
+
+        luma[i] = Coefficients::RED_LUMA * r + Coefficients::GREEN_LUMA * g + Coefficients::BLUE_LUMA * b;
+
+        if (isChromaFiltered) {
+            blueDifference[i] = Coefficients::RED_BLUE_DIFFERENCE * r + Coefficients::GREEN_BLUE_DIFFERENCE * g + Coefficients::BLUE_BLUE_DIFFERENCE * b;
+            redDifference[i] = Coefficients::RED_RED_DIFFERENCE * r + Coefficients::GREEN_RED_DIFFERENCE * g + Coefficients::BLUE_RED_DIFFERENCE * b;
+        }
+    }
+
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, isChromaFiltered ? pixelsCount + 2 * Channel<IEEE754_t>::stridedSize(rows, 2) * Channel<IEEE754_t>::stridedSize(columns, 2) : pixelsCount);
+
+    auto filteredLuma = std::vector<IEEE754_t>(pixelsCount);
+    auto lumaChannel = Channel<IEEE754_t>(BorrowedStorage{}, red->getMaxTheoreticalValue(), luma.data(), rows, columns, layout);
+    lumaChannel.filterUnsaturatedInto(filteredLuma.data(), this->kernel, this->paddingStrategy);
+
+    auto filteredRed = new Channel<IEEE754_t>(red->getMaxTheoreticalValue(), rows, columns, layout);
+    auto filteredGreen = new Channel<IEEE754_t>(green->getMaxTheoreticalValue(), rows, columns, layout);
+    auto filteredBlue = new Channel<IEEE754_t>(blue->getMaxTheoreticalValue(), rows, columns, layout);
+
+    auto filteredRedValues = filteredRed->getMutableElements();
+    auto filteredGreenValues = filteredGreen->getMutableElements();
+    auto filteredBlueValues = filteredBlue->getMutableElements();
+
+    if (!isChromaFiltered) {
+        // The chroma is unchanged, so converting back only adds the change of the luma to each sample.
+        for (size_t i = 0; i < pixelsCount; i++) {
+            auto lumaChange = filteredLuma[i] - luma[i];
+
+            filteredRedValues[i] = filteredRed->saturated(redValues[i] + lumaChange);
+            filteredGreenValues[i] = filteredGreen->saturated(greenValues[i] + lumaChange);
+            filteredBlueValues[i] = filteredBlue->saturated(blueValues[i] + lumaChange);
+        }
+
+        return {filteredRed, filteredGreen, filteredBlue};
+    }
+
+    auto sampledRows = Channel<IEEE754_t>::stridedSize(rows, 2);
+    auto sampledColumns = Channel<IEEE754_t>::stridedSize(columns, 2);
+    auto filteredBlueDifference = std::vector<IEEE754_t>(static_cast<size_t>(sampledRows) * sampledColumns);
+    auto filteredRedDifference = std::vector<IEEE754_t>(filteredBlueDifference.size());
+
+    auto blueDifferenceChannel = Channel<IEEE754_t>(BorrowedStorage{}, blue->getMaxTheoreticalValue(), blueDifference.data(), rows, columns, layout);
+    auto redDifferenceChannel = Channel<IEEE754_t>(BorrowedStorage{}, red->getMaxTheoreticalValue(), redDifference.data(), rows, columns, layout);
+    blueDifferenceChannel.filterUnsaturatedInto(filteredBlueDifference.data(), this->kernel, this->paddingStrategy, 2);
+    redDifferenceChannel.filterUnsaturatedInto(filteredRedDifference.data(), this->kernel, this->paddingStrategy, 2);
+
+    auto sampleAt = [sampledRows, sampledColumns, layout](const std::vector<IEEE754_t>& samples, unsigned int row, unsigned int column) {
+        auto upperRow = row / 2;
+        auto leftColumn = column / 2;
+        auto lowerRow = std::min(upperRow + row % 2, sampledRows - 1);
+        auto rightColumn = std::min(leftColumn + column % 2, sampledColumns - 1);
+
+        return (samples[flatIndexOf(upperRow, leftColumn, sampledRows, sampledColumns, layout)]
+              + samples[flatIndexOf(upperRow, rightColumn, sampledRows, sampledColumns, layout)]
+              + samples[flatIndexOf(lowerRow, leftColumn, sampledRows, sampledColumns, layout)]
+              + samples[flatIndexOf(lowerRow, rightColumn, sampledRows, sampledColumns, layout)]) / 4;
+    };
+
+    for (unsigned int row = 0; row < rows; row++) {
+        for (unsigned int column = 0; column < columns; column++) {
+            auto i = flatIndexOf(row, column, rows, columns, layout);
+            auto y = filteredLuma[i];
+            auto cb = sampleAt(filteredBlueDifference, row, column);
+            auto cr = sampleAt(filteredRedDifference, row, column);
+
+            filteredRedValues[i] = filteredRed->saturated(y + Coefficients::RED_FROM_RED_DIFFERENCE * cr);
+            filteredGreenValues[i] = filteredGreen->saturated(y + Coefficients::GREEN_FROM_BLUE_DIFFERENCE * cb + Coefficients::GREEN_FROM_RED_DIFFERENCE * cr);
+            filteredBlueValues[i] = filteredBlue->saturated(y + Coefficients::BLUE_FROM_BLUE_DIFFERENCE * cb);
+        }
+    }
+
+    return {filteredRed, filteredGreen, filteredBlue};
+}
+
+template class LumaChromaFilter<float>;
+template class LumaChromaFilter<double>;
+template class LumaChromaFilter<long double>;
@@ -0,0 +1,47 @@
+#ifndef IMAGECONVOLUTIONKERNEL_LUMACHROMAFILTER_H
+#define IMAGECONVOLUTIONKERNEL_LUMACHROMAFILTER_H
+
+#include <type_traits>
+#include <vector>
+
+#include "../Channel/Channel.h"
+
+enum class ChromaFiltering {
+    // Only the luma is filtered, the chroma of each pixel is kept as is.
+    UNFILTERED,
+    // The chroma is filtered too, but only at the pixels of even row and column, then interpolated bilinearly in between.
+    HALF_RESOLUTION
+};
+
+/*
+ * Filters RGB channels in the YCbCr space (BT.601 full range, without the chroma offset, so that the conversion is linear): sharpening and
+ * denoising mostly matter to the luma, which is a third of the work of filtering the three RGB channels.
+ *
+ * The conversion to YCbCr is a single pass over the three channels, which gathers the planes the filtering needs and nothing else. The
+ * conversion back is fused with writing the output channels: with unfiltered chroma, each output sample is its input sample plus the change
+ * of the luma (R' = R + Y' - Y, and the same for G and B), so the chroma planes are never even stored. Filtering chroma at half resolution
+ * costs a quarter of a full channel per chroma plane.
+ *
+ * Padding strategies pad the YCbCr planes; as the conversion is linear, that's the same as padding the RGB channels for the linear
+ * strategies (e.g. zero padding and periodic extension). Only the output is rounded and clamped, like `Channel::filtered` does.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class LumaChromaFilter {
+private:
+    const ConvolutionKernel<IEEE754_t>* kernel;
+    const MatrixPaddingStrategy<IEEE754_t>* paddingStrategy;
+    ChromaFiltering chromaFiltering;
+
+public:
+    LumaChromaFilter(
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        ChromaFiltering chromaFiltering = ChromaFiltering::UNFILTERED
+    );
+
+    [[nodiscard]] ChromaFiltering getChromaFiltering() const;
+
+    std::vector<Channel<IEEE754_t>*> filtered(const Channel<IEEE754_t>* red, const Channel<IEEE754_t>* green, const Channel<IEEE754_t>* blue) const;
+};
+
+#endif
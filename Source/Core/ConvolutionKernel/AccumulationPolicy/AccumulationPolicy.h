@@ -0,0 +1,64 @@
+#ifndef IMAGECONVOLUTIONKERNEL_ACCUMULATIONPOLICY_H
+#define IMAGECONVOLUTIONKERNEL_ACCUMULATIONPOLICY_H
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "../ConvolutionKernel.h"
+
+/*
+ * Error analysis of filtering channels of type `Storage` while summing in `Accumulator` (see `Channel::filtered<Accumulator>`).
+ *
+ * Filtering a pixel is a dot product of n = rows * columns kernel values w and channel values x. Summed in a type of unit roundoff u, its
+ * absolute error is at most γ(n) · Σ|w| · max|x|, with γ(n) = n·u / (1 - n·u) (Higham, Accuracy and Stability of Numerical Algorithms, §3.1).
+ * Storing the sum back as `Storage` adds at most u(Storage) · Σ|w| · max|x|. Kernel values are stored as `Storage` in any case, so they're
+ * the reference and don't count.
+ *
+ * As a rough guide, for a normalized (Σ|w| = 1) 5x5 kernel over 8 bit channels (max|x| = 255), the bound is about (x86-64, where
+ * `long double` is the 80 bit extended format):
+ *
+ *   Storage \ Accumulator     float       double      long double
+ *   float                     4e-4        1.5e-5      1.5e-5
+ *   double                    3.8e-4      7e-13       2.9e-14
+ *   long double               3.8e-4      7e-13       3.6e-16
+ *
+ * and it grows linearly with the number of kernel values and with the maximum channel value. Filtered values are rounded to integers
+ * before being saturated, so any bound below 0.5 gives the exact output, except for sums within the bound of a .5 tie.
+ */
+template<typename Storage, typename Accumulator> requires std::is_floating_point_v<Storage> && std::is_floating_point_v<Accumulator>
+struct AccumulationPolicy {
+    using StorageType = Storage;
+    using AccumulatorType = Accumulator;
+
+    static constexpr long double accumulatorUnitRoundoff = std::numeric_limits<Accumulator>::epsilon() / 2.0L;
+    static constexpr long double storageUnitRoundoff = std::numeric_limits<Storage>::epsilon() / 2.0L;
+
+    /*
+     * Upper bound of the absolute error of filtering a channel whose values are within [-maxValue, maxValue] with `kernel`.
+     * Infinite when n·u >= 1, as the bound no longer holds.
+     */
+    [[nodiscard]] static long double errorBound(const ConvolutionKernel<Storage>* kernel, long double maxValue) {
+        auto taps = static_cast<long double>(kernel->getRows()) * kernel->getColumns();
+        long double sumOfAbsoluteValues = 0;
+
+        for (int i = kernel->getLowerBoundRowIndex(); i <= kernel->getUpperBoundRowIndex(); i++) {
+            for (int j = kernel->getLowerBoundColumnIndex(); j <= kernel->getUpperBoundColumnIndex(); j++) {
+                sumOfAbsoluteValues += std::abs(static_cast<long double>(kernel->getValue(i, j)));
+            }
+        }
+
+        if (taps * accumulatorUnitRoundoff >= 1) {
+            return std::numeric_limits<long double>::infinity();
+        }
+
+        auto gamma = taps * accumulatorUnitRoundoff / (1 - taps * accumulatorUnitRoundoff);
+        return (gamma + storageUnitRoundoff) * sumOfAbsoluteValues * maxValue;
+    }
+
+    [[nodiscard]] static bool meetsTolerance(const ConvolutionKernel<Storage>* kernel, long double maxValue, long double tolerance) {
+        return errorBound(kernel, maxValue) <= tolerance;
+    }
+};
+
+#endif
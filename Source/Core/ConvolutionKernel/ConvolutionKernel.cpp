@@ -2,11 +2,12 @@
 
 #include <cmath>
 #include <cassert>
+#include <limits>
 
 template <typename IEEE754_t>
     requires std::is_floating_point_v<IEEE754_t>
 ConvolutionKernel<IEEE754_t>::ConvolutionKernel(const IEEE754_t *elements, unsigned int rows, unsigned int columns, MatrixLayout layout) : Matrix<IEEE754_t>(elements, rows, columns, layout) {
-
+    this->computeMetadata();
 }
 
 
@@ -21,9 +22,9 @@ ConvolutionKernel<IEEE754_t>::ConvolutionKernel(const Matrix<IEEE754_t>* fromMat
         for (int i = 0; i < fromMatrix->getRows(); i++) {
             for (int j = 0; j < fromMatrix->getColumns(); j++) {
                 if (fromMatrix->getMatrixLayout() == ROW_MAJOR) {
-                    deepCopy[i * fromMatrix -> getRows() + j] = fromMatrix -> at(i, j);
+                    deepCopy[i * fromMatrix -> getColumns() + j] = fromMatrix -> at(i, j);
                 } else {
-                    deepCopy[i + fromMatrix->getColumns() * j] = fromMatrix -> at(i, j);
+                    deepCopy[i + fromMatrix->getRows() * j] = fromMatrix -> at(i, j);
                 }
             }
         }
@@ -34,7 +35,82 @@ ConvolutionKernel<IEEE754_t>::ConvolutionKernel(const Matrix<IEEE754_t>* fromMat
     fromMatrix->getColumns(),
     fromMatrix->getMatrixLayout()
 ) {
+    this->computeMetadata();
+}
+
+/*
+ * Kernels are immutable, and their metadata is read for every tap of every output pixel, so everything that can be derived from the
+ * kernel values is computed once here:
+ * - The central indices and the bounds of the centered indexing system, according to the rules documented on their getters.
+ * - The sum of the values, e.g. 1 for normalized blurs and 0 for derivative kernels.
+ * - Whether the kernel equals its rotation by 180 degrees, in which case convolution and correlation give the same result.
+ * - Whether the kernel is separable, that is K = c * r for a column vector c and a row vector r, in which case the factors are stored
+ *   too. Separability is checked up to a tolerance relative to the largest value, so that kernels generated in floating point
+ *   (e.g. gaussians) are recognized.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void ConvolutionKernel<IEEE754_t>::computeMetadata() {
+    auto rows = static_cast<int>(this->getRows());
+    auto columns = static_cast<int>(this->getColumns());
+
+    this->centralRowIndex = rows % 2 == 0 ? static_cast<int>(ceil(static_cast<float>(rows - 1) / 2)) : rows / 2;
+    this->centralColumnIndex = columns % 2 == 0 ? static_cast<int>(ceil(static_cast<float>(columns - 1) / 2)) : columns / 2;
+
+    this->lowerBoundRowIndex = rows % 2 == 0 ? -static_cast<int>(ceil(static_cast<float>(rows - 1) / 2)) : -(rows - 1) / 2;
+    this->upperBoundRowIndex = rows % 2 == 0 ? static_cast<int>(ceil(static_cast<float>(rows - 1) / 2)) - 1 : (rows - 1) / 2;
+    this->lowerBoundColumnIndex = columns % 2 == 0 ? -static_cast<int>(ceil(static_cast<float>(columns - 1) / 2)) : -(columns - 1) / 2;
+    this->upperBoundColumnIndex = columns % 2 == 0 ? static_cast<int>(ceil(static_cast<float>(columns - 1) / 2)) - 1 : (columns - 1) / 2;
+
+    this->sumOfValues = 0;
+    this->symmetric = true;
+
+    auto pivotRow = 0;
+    auto pivotColumn = 0;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < columns; j++) {
+            auto value = this->at(i, j);
+            this->sumOfValues += value;
+
+            if (value != this->at(rows - 1 - i, columns - 1 - j)) {
+                this->symmetric = false;
+            }
 
+            if (std::abs(value) > std::abs(this->at(pivotRow, pivotColumn))) {
+                pivotRow = i;
+                pivotColumn = j;
+            }
+        }
+    }
+
+    auto pivot = this->at(pivotRow, pivotColumn);
+    this->columnFactor.clear();
+    this->rowFactor.clear();
+    this->separable = pivot != 0;
+
+    if (this->separable) {
+        for (int i = 0; i < rows; i++) {
+            this->columnFactor.push_back(this->at(i, pivotColumn));
+        }
+
+        for (int j = 0; j < columns; j++) {
+            this->rowFactor.push_back(this->at(pivotRow, j) / pivot);
+        }
+
+        auto tolerance = 64 * std::numeric_limits<IEEE754_t>::epsilon() * std::abs(pivot);
+        for (int i = 0; i < rows && this->separable; i++) {
+            for (int j = 0; j < columns; j++) {
+                if (std::abs(this->at(i, j) - this->columnFactor[i] * this->rowFactor[j]) > tolerance) {
+                    this->separable = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!this->separable) {
+        this->columnFactor.clear();
+        this->rowFactor.clear();
+    }
 }
 
 /*
@@ -44,9 +120,7 @@ ConvolutionKernel<IEEE754_t>::ConvolutionKernel(const Matrix<IEEE754_t>* fromMat
  */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 int ConvolutionKernel<IEEE754_t>::getCentralRowIndex() const {
-    auto rows = static_cast<int>(this->getRows());
-
-    return rows % 2 == 0 ? static_cast<int>(ceil(static_cast<float>(rows - 1) / 2)) : rows / 2;
+    return this->centralRowIndex;
 }
 
 /*
@@ -56,8 +130,7 @@ int ConvolutionKernel<IEEE754_t>::getCentralRowIndex() const {
  */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 int ConvolutionKernel<IEEE754_t>::getCentralColumnIndex() const {
-    auto columns = static_cast<int>(this->getColumns());
-    return columns % 2 == 0 ? static_cast<int>(ceil(static_cast<float>(columns - 1) / 2)) : columns / 2;
+    return this->centralColumnIndex;
 }
 
 /*
@@ -67,9 +140,7 @@ int ConvolutionKernel<IEEE754_t>::getCentralColumnIndex() const {
  */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 int ConvolutionKernel<IEEE754_t>::getLowerBoundRowIndex() const {
-    auto rows = static_cast<int>(this->getRows());
-
-    return rows % 2 == 0 ? -static_cast<int>(ceil(static_cast<float>(rows - 1) / 2)) : -(rows - 1) / 2;
+    return this->lowerBoundRowIndex;
 }
 
 /*
@@ -79,9 +150,7 @@ int ConvolutionKernel<IEEE754_t>::getLowerBoundRowIndex() const {
  */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 int ConvolutionKernel<IEEE754_t>::getUpperBoundRowIndex() const {
-    auto rows = static_cast<int>(this->getRows());
-
-    return rows % 2 == 0 ? static_cast<int>(ceil(static_cast<float>(rows - 1) / 2)) - 1 : (rows - 1) / 2;
+    return this->upperBoundRowIndex;
 }
 
 
@@ -92,9 +161,7 @@ int ConvolutionKernel<IEEE754_t>::getUpperBoundRowIndex() const {
  */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 int ConvolutionKernel<IEEE754_t>::getLowerBoundColumnIndex() const {
-    auto columns = static_cast<int>(this->getColumns());
-
-    return columns % 2 == 0 ? -static_cast<int>(ceil(static_cast<float>(columns - 1) / 2)) : -(columns - 1) / 2;
+    return this->lowerBoundColumnIndex;
 }
 
 /*
@@ -104,9 +171,7 @@ int ConvolutionKernel<IEEE754_t>::getLowerBoundColumnIndex() const {
  */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 int ConvolutionKernel<IEEE754_t>::getUpperBoundColumnIndex() const {
-    auto columns = static_cast<int>(this->getColumns());
-
-    return columns % 2 == 0 ? static_cast<int>(ceil(static_cast<float>(columns - 1) / 2)) - 1 : (columns - 1) / 2;
+    return this->upperBoundColumnIndex;
 }
 
 
@@ -118,13 +183,39 @@ int ConvolutionKernel<IEEE754_t>::getUpperBoundColumnIndex() const {
  */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 IEEE754_t ConvolutionKernel<IEEE754_t>::getValue(int row, int column) const {
-    assert(row >= this->getLowerBoundRowIndex() && row <= this->getUpperBoundRowIndex());
-    assert(column >= this->getLowerBoundColumnIndex() && column <= this->getUpperBoundColumnIndex());
+    assert(row >= this->lowerBoundRowIndex && row <= this->upperBoundRowIndex);
+    assert(column >= this->lowerBoundColumnIndex && column <= this->upperBoundColumnIndex);
+
+    return this->at(row + this->centralRowIndex, column + this->centralColumnIndex);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+IEEE754_t ConvolutionKernel<IEEE754_t>::getSum() const {
+    return this->sumOfValues;
+}
 
-    auto mappedRowIndex = row + this->getCentralRowIndex();
-    auto mappedColumnIndex = column + this->getCentralColumnIndex();
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+bool ConvolutionKernel<IEEE754_t>::isSymmetric() const {
+    return this->symmetric;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+bool ConvolutionKernel<IEEE754_t>::isSeparable() const {
+    return this->separable;
+}
 
-    return this->at(mappedRowIndex, mappedColumnIndex);
+/*
+ * If the kernel is separable, these are the factors s.t. `at(i, j) == getColumnFactor()[i] * getRowFactor()[j]`, up to rounding.
+ * Both are empty for non separable kernels.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const std::vector<IEEE754_t> &ConvolutionKernel<IEEE754_t>::getColumnFactor() const {
+    return this->columnFactor;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const std::vector<IEEE754_t> &ConvolutionKernel<IEEE754_t>::getRowFactor() const {
+    return this->rowFactor;
 }
 
 
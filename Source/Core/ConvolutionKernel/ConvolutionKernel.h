@@ -3,11 +3,28 @@
 #define IMAGECONVOLUTIONKERNEL_CONVOLUTIONKERNEL_H
 
 #include <type_traits>
+#include <vector>
 #include "../Matrix/Matrix.h"
 
 template <typename IEEE754_t>
     requires std::is_floating_point_v<IEEE754_t>
 class ConvolutionKernel : public Matrix<IEEE754_t> {
+    private:
+    int centralRowIndex;
+    int centralColumnIndex;
+    int lowerBoundRowIndex;
+    int upperBoundRowIndex;
+    int lowerBoundColumnIndex;
+    int upperBoundColumnIndex;
+
+    IEEE754_t sumOfValues;
+    bool symmetric;
+    bool separable;
+    std::vector<IEEE754_t> columnFactor;
+    std::vector<IEEE754_t> rowFactor;
+
+    void computeMetadata();
+
     public:
     ConvolutionKernel(const IEEE754_t* elements, unsigned int rows, unsigned int columns, MatrixLayout layout = ROW_MAJOR);
     explicit ConvolutionKernel(const Matrix<IEEE754_t>* fromMatrix);
@@ -22,6 +39,12 @@ class ConvolutionKernel : public Matrix<IEEE754_t> {
     [[nodiscard]] int getUpperBoundColumnIndex() const;
 
     IEEE754_t getValue(int row, int column) const;
+
+    [[nodiscard]] IEEE754_t getSum() const;
+    [[nodiscard]] bool isSymmetric() const;
+    [[nodiscard]] bool isSeparable() const;
+    [[nodiscard]] const std::vector<IEEE754_t>& getColumnFactor() const;
+    [[nodiscard]] const std::vector<IEEE754_t>& getRowFactor() const;
 };
 
 #endif
\ No newline at end of file
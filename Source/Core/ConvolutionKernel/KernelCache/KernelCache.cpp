@@ -0,0 +1,81 @@
+#include "KernelCache.h"
+
+#include <map>
+#include <mutex>
+
+#include "../Kernels/AverageKernel.cpp"
+#include "../Kernels/GaussianKernel.cpp"
+#include "../Kernels/Identity.cpp"
+
+namespace {
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    struct KernelCacheStorage {
+        std::mutex mutex;
+        std::map<typename KernelCache<IEEE754_t>::Key, const ConvolutionKernel<IEEE754_t>*> kernels;
+    };
+
+    // A function local static avoids depending on the initialization order of globals across translation units.
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    KernelCacheStorage<IEEE754_t>& storage() {
+        static KernelCacheStorage<IEEE754_t> kernelCacheStorage;
+        return kernelCacheStorage;
+    }
+}
+
+/*
+ * Kernels are generated while holding the lock. Generation is cheap compared to a convolution, and this guarantees that concurrent requests of the same key
+ * never generate it twice.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const ConvolutionKernel<IEEE754_t> *KernelCache<IEEE754_t>::cached(const Key &key) {
+    auto& cacheStorage = storage<IEEE754_t>();
+    std::lock_guard lock(cacheStorage.mutex);
+
+    auto cachedKernel = cacheStorage.kernels.find(key);
+    if (cachedKernel != cacheStorage.kernels.end()) {
+        return cachedKernel->second;
+    }
+
+    const ConvolutionKernel<IEEE754_t>* kernel = nullptr;
+    switch (key.type) {
+        case KernelType::IDENTITY:
+            kernel = Kernels::identity<IEEE754_t>(key.size);
+            break;
+        case KernelType::AVERAGE:
+            kernel = Kernels::averageKernel<IEEE754_t>(key.size);
+            break;
+        case KernelType::GAUSSIAN:
+            kernel = Kernels::gaussianKernel<IEEE754_t>(key.size, key.sigma);
+            break;
+    }
+
+    cacheStorage.kernels.emplace(key, kernel);
+    return kernel;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const ConvolutionKernel<IEEE754_t> *KernelCache<IEEE754_t>::identity(unsigned int size) {
+    return cached({KernelType::IDENTITY, size, 0});
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const ConvolutionKernel<IEEE754_t> *KernelCache<IEEE754_t>::averageKernel(unsigned int size) {
+    return cached({KernelType::AVERAGE, size, 0});
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const ConvolutionKernel<IEEE754_t> *KernelCache<IEEE754_t>::gaussianKernel(unsigned int size, IEEE754_t sigma) {
+    return cached({KernelType::GAUSSIAN, size, sigma});
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int KernelCache<IEEE754_t>::getCachedKernelsCount() {
+    auto& cacheStorage = storage<IEEE754_t>();
+    std::lock_guard lock(cacheStorage.mutex);
+
+    return cacheStorage.kernels.size();
+}
+
+template class KernelCache<float>;
+template class KernelCache<double>;
+template class KernelCache<long double>;
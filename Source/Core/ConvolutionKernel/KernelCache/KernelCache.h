@@ -0,0 +1,44 @@
+#ifndef IMAGECONVOLUTIONKERNEL_KERNELCACHE_H
+#define IMAGECONVOLUTIONKERNEL_KERNELCACHE_H
+
+#include <compare>
+#include <type_traits>
+
+#include "../ConvolutionKernel.h"
+
+enum class KernelType {
+    IDENTITY = 0,
+    AVERAGE = 1,
+    GAUSSIAN = 2
+};
+
+/*
+ * A process-wide cache of the kernels generated by the `Kernels` namespace, keyed by (type, size, sigma). Each scalar type has its own cache,
+ * since it's a separate instantiation of this class.
+ *
+ * The first request of a key generates the kernel, the following ones return the very same instance, which is why the returned kernels are const
+ * and must never be deleted: they live as long as the process. All the methods are thread safe.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class KernelCache {
+public:
+    struct Key {
+        KernelType type;
+        unsigned int size;
+        IEEE754_t sigma;
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+private:
+    static const ConvolutionKernel<IEEE754_t>* cached(const Key& key);
+
+public:
+    static const ConvolutionKernel<IEEE754_t>* identity(unsigned int size);
+    static const ConvolutionKernel<IEEE754_t>* averageKernel(unsigned int size);
+    static const ConvolutionKernel<IEEE754_t>* gaussianKernel(unsigned int size, IEEE754_t sigma);
+
+    [[nodiscard]] static unsigned int getCachedKernelsCount();
+};
+
+#endif
@@ -10,6 +10,9 @@ namespace Kernels {
             elements[i] = 1.0/(size * size);
         }
 
-        return new ConvolutionKernel<IEEE754_t>(elements, size, size, ROW_MAJOR);
+        auto kernel = new ConvolutionKernel<IEEE754_t>(elements, size, size, ROW_MAJOR);
+        delete[] elements;
+
+        return kernel;
     }
 }
\ No newline at end of file
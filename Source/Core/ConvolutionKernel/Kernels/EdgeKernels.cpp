@@ -0,0 +1,51 @@
+#include <type_traits>
+#include "../ConvolutionKernel.h"
+
+namespace Kernels {
+    /*
+     * 3x3 first derivative kernels: `sideWeight` and `centreWeight` are the smoothing weights across the derivative direction, e.g. (1, 2)
+     * for Sobel. Convolution in this project is a correlation, so the horizontal kernel responds positively where the values increase from
+     * left to right, and the vertical one where they increase from top to bottom.
+     */
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    ConvolutionKernel<IEEE754_t>* gradientKernel(IEEE754_t sideWeight, IEEE754_t centreWeight, bool isVertical) {
+        IEEE754_t horizontalElements[] = {
+            -sideWeight, 0, sideWeight,
+            -centreWeight, 0, centreWeight,
+            -sideWeight, 0, sideWeight
+        };
+
+        // The vertical kernel is the transpose of the horizontal one, which is what a column major reading of the same elements is.
+        return new ConvolutionKernel<IEEE754_t>(horizontalElements, 3, 3, isVertical ? COLUMN_MAJOR : ROW_MAJOR);
+    }
+
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    ConvolutionKernel<IEEE754_t>* sobelX() {
+        return gradientKernel<IEEE754_t>(1, 2, false);
+    }
+
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    ConvolutionKernel<IEEE754_t>* sobelY() {
+        return gradientKernel<IEEE754_t>(1, 2, true);
+    }
+
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    ConvolutionKernel<IEEE754_t>* scharrX() {
+        return gradientKernel<IEEE754_t>(3, 10, false);
+    }
+
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    ConvolutionKernel<IEEE754_t>* scharrY() {
+        return gradientKernel<IEEE754_t>(3, 10, true);
+    }
+
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    ConvolutionKernel<IEEE754_t>* prewittX() {
+        return gradientKernel<IEEE754_t>(1, 1, false);
+    }
+
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    ConvolutionKernel<IEEE754_t>* prewittY() {
+        return gradientKernel<IEEE754_t>(1, 1, true);
+    }
+}
@@ -15,39 +15,38 @@
 namespace Kernels {
     template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
     ConvolutionKernel<IEEE754_t> *gaussianKernel(unsigned int size, IEEE754_t sigma) {
-        auto elements = new IEEE754_t[size * size];
-        IEEE754_t sumOfValues = 0;
+        // Since exp(-(x² + y²) / (2σ²)) = exp(-x² / (2σ²)) * exp(-y² / (2σ²)), only `size` exponentials are needed, one per distance from the center.
+        auto profile = new IEEE754_t[size];
 
-        if (size % 2 != 0) {
-            for (int i = 0; i < size; i++) {
-                for (int j = 0; j < size; j++) {
-                    auto x = (static_cast<IEEE754_t>(i) - static_cast<IEEE754_t>(size - 1) / 2);
-                    auto y = (static_cast<IEEE754_t>(j) - static_cast<IEEE754_t>(size - 1) / 2);
+        for (int i = 0; i < size; i++) {
+            auto x = (static_cast<IEEE754_t>(i) - static_cast<IEEE754_t>(size - 1) / 2);
 
-                    elements[i * size + j] = 1.0 / (2 * M_PI * sigma * sigma) * exp(-(x*x + y*y) / (2*sigma * sigma));
-                    sumOfValues += elements[i * size + j];
-                }
-            }
-        } else {
-            for (int i = 0; i < size; i++) {
-                for (int j = 0; j < size; j++) {
-                    auto x = (static_cast<IEEE754_t>(i) - static_cast<IEEE754_t>(size - 1) / 2);
-                    auto y = (static_cast<IEEE754_t>(j) - static_cast<IEEE754_t>(size - 1) / 2);
-
-                    x += (x < 0) ? -0.5 : 0.5;
-                    y += (y < 0) ? -0.5 : 0.5;
-
-                    elements[i * size + j] = 1.0 / (2 * M_PI * sigma * sigma) * exp(-(x*x + y*y) / (2*sigma * sigma));
-                    sumOfValues += elements[i * size + j];
-                }
+            if (size % 2 == 0) {
+                x += (x < 0) ? -0.5 : 0.5;
             }
+
+            profile[i] = exp(-(x*x) / (2*sigma * sigma));
         }
 
+        auto elements = new IEEE754_t[size * size];
+        IEEE754_t sumOfValues = 0;
+
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                elements[i * size + j] = 1.0 / (2 * M_PI * sigma * sigma) * profile[i] * profile[j];
+                sumOfValues += elements[i * size + j];
+            }
+        }
 
         for (int i = 0; i < size * size; i++) {
             elements[i] /= sumOfValues;
         }
 
-        return new ConvolutionKernel(elements, size, size, ROW_MAJOR);
+        auto kernel = new ConvolutionKernel(elements, size, size, ROW_MAJOR);
+
+        delete[] profile;
+        delete[] elements;
+
+        return kernel;
     }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <type_traits>
 #include <cassert>
+#include <cstring>
 #include  "../ConvolutionKernel.h"
 
 namespace Kernels {
@@ -8,15 +9,18 @@ namespace Kernels {
         assert(size % 2 != 0);
 
         auto elements = new IEEE754_t[size * size];
-        memset(elements, 0, size * sizeof(IEEE754_t));
+        memset(elements, 0, size * size * sizeof(IEEE754_t));
 
         elements[(size - 1)/2 * size + (size - 1)/2] = 1.0;
 
-        return new ConvolutionKernel<IEEE754_t>(
+        auto kernel = new ConvolutionKernel<IEEE754_t>(
             elements,
             size,
             size,
             ROW_MAJOR
         );
+
+        delete[] elements;
+        return kernel;
     }
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "FilterClient.h"
+
+#include <unistd.h>
+
+#include "UnixSocket.h"
+
+FilterClient::FilterClient(int connectedSocket) : connectedSocket(connectedSocket) {
+
+}
+
+FilterClient::~FilterClient() {
+    close(this->connectedSocket);
+}
+
+FilterClient *FilterClient::connectTo(const std::filesystem::path &socketPath) {
+    auto connectedSocket = UnixSocket::connectTo(socketPath);
+
+    if (connectedSocket < 0) {
+        return nullptr;
+    }
+
+    return new FilterClient(connectedSocket);
+}
+
+std::optional<std::string> FilterClient::request(const std::string &line) {
+    if (!UnixSocket::writeLine(this->connectedSocket, line)) {
+        return std::nullopt;
+    }
+
+    return UnixSocket::readLine(this->connectedSocket, this->pending);
+}
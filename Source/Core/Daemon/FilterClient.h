@@ -0,0 +1,35 @@
+#ifndef IMAGECONVOLUTIONKERNEL_FILTERCLIENT_H
+#define IMAGECONVOLUTIONKERNEL_FILTERCLIENT_H
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+/*
+ * A connection to a `FilterDaemon`. Requests on the same connection are served in order, so a client can keep its connection open and
+ * send requests one after the other; clients wanting parallelism open several connections.
+ */
+class FilterClient {
+private:
+    int connectedSocket;
+    std::string pending;
+
+    explicit FilterClient(int connectedSocket);
+
+public:
+    FilterClient(const FilterClient&) = delete;
+    FilterClient& operator=(const FilterClient&) = delete;
+    ~FilterClient();
+
+    /*
+     * A client connected to the daemon listening on `socketPath`, or nullptr if there's none.
+     */
+    static FilterClient* connectTo(const std::filesystem::path& socketPath);
+
+    /*
+     * Sends the command `line` and waits for its reply. Empty if the daemon closed the connection.
+     */
+    std::optional<std::string> request(const std::string& line);
+};
+
+#endif
@@ -0,0 +1,409 @@
+#include "FilterDaemon.h"
+
+#include <cerrno>
+#include <chrono>
+#include <exception>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "UnixSocket.h"
+#include "../ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../Instrumentation/Instrumentation.h"
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+FilterDaemon<IEEE754_t>::FilterDaemon(const std::filesystem::path &socketPath, unsigned int workersCount, unsigned int maxPooledImagesPerSize)
+    : socketPath(socketPath), listeningSocket(UnixSocket::listenOn(socketPath)), ppmPool(maxPooledImagesPerSize), pgmPool(maxPooledImagesPerSize), scheduler(workersCount) {
+    if (pipe2(this->wakeUpPipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        this->wakeUpPipe[0] = -1;
+        this->wakeUpPipe[1] = -1;
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+FilterDaemon<IEEE754_t>::~FilterDaemon() {
+    if (this->listeningSocket >= 0) {
+        close(this->listeningSocket);
+        std::filesystem::remove(this->socketPath);
+    }
+
+    for (auto descriptor : this->wakeUpPipe) {
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+bool FilterDaemon<IEEE754_t>::isListening() const {
+    return this->listeningSocket >= 0 && this->wakeUpPipe[0] >= 0;
+}
+
+/*
+ * A single thread polls the listening socket and the connections no worker is serving, reads what they send, and submits each complete
+ * line to the scheduler; the worker serving it wakes this thread up once the reply is written, so that the connection is polled again.
+ *
+ * Once stopped, no further request is read: the requests in progress still get their reply, then all connections are closed.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void FilterDaemon<IEEE754_t>::serve() {
+    if (!this->isListening()) {
+        return;
+    }
+
+    auto descriptors = std::vector<pollfd>();
+
+    while (!this->isStopping) {
+        descriptors.clear();
+        descriptors.push_back({this->listeningSocket, POLLIN, 0});
+        descriptors.push_back({this->wakeUpPipe[0], POLLIN, 0});
+
+        {
+            std::lock_guard lock(this->connectionsMutex);
+
+            for (const auto& [connection, state] : this->connections) {
+                if (!state.isServing) {
+                    descriptors.push_back({connection, POLLIN, 0});
+                }
+            }
+        }
+
+        if (poll(descriptors.data(), descriptors.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        if (descriptors[1].revents != 0) {
+            char buffer[64];
+            while (read(this->wakeUpPipe[0], buffer, sizeof(buffer)) > 0) {}
+        }
+
+        if (this->isStopping) {
+            break;
+        }
+
+        if (descriptors[0].revents != 0) {
+            this->acceptConnection();
+        }
+
+        for (size_t i = 2; i < descriptors.size(); i++) {
+            if (descriptors[i].revents != 0) {
+                this->receiveFrom(descriptors[i].fd);
+            }
+        }
+
+        this->dispatchRequests();
+    }
+
+    this->scheduler.wait();
+
+    std::lock_guard lock(this->connectionsMutex);
+
+    for (const auto& [connection, state] : this->connections) {
+        close(connection);
+    }
+
+    this->connections.clear();
+}
+
+/*
+ * Only async-signal-safe calls: an atomic store and a write to the pipe.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void FilterDaemon<IEEE754_t>::stop() {
+    this->isStopping = true;
+    this->wakeUp();
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void FilterDaemon<IEEE754_t>::wakeUp() {
+    if (this->wakeUpPipe[1] >= 0) {
+        // A full pipe already guarantees a wake up, so a failed write needs no handling.
+        char byte = 0;
+        [[maybe_unused]] auto written = write(this->wakeUpPipe[1], &byte, 1);
+    }
+}
+
+/*
+ * A client not reading its replies makes the worker writing them wait at most `REPLY_TIMEOUT_SECONDS`, after which the connection is closed.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void FilterDaemon<IEEE754_t>::acceptConnection() {
+    auto connection = accept4(this->listeningSocket, nullptr, nullptr, SOCK_CLOEXEC);
+
+    if (connection < 0) {
+        return;
+    }
+
+    timeval timeout{REPLY_TIMEOUT_SECONDS, 0};
+    setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::lock_guard lock(this->connectionsMutex);
+    this->connections[connection] = Connection();
+}
+
+/*
+ * A single read, so that it can't block: `connection` was just reported readable.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void FilterDaemon<IEEE754_t>::receiveFrom(int connection) {
+    char buffer[4096];
+    auto received = recv(connection, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+    if (received < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return;
+    }
+
+    std::lock_guard lock(this->connectionsMutex);
+    auto& state = this->connections.at(connection);
+
+    if (received <= 0) {
+        state.isClosing = true;
+    } else {
+        state.pending.append(buffer, received);
+    }
+}
+
+/*
+ * Submits the next request of each connection no worker is serving, and closes the connections that are done: closed by the peer with no
+ * complete line left, or sending a line longer than `MAX_LINE_LENGTH`.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void FilterDaemon<IEEE754_t>::dispatchRequests() {
+    std::lock_guard lock(this->connectionsMutex);
+
+    for (auto iterator = this->connections.begin(); iterator != this->connections.end();) {
+        auto connection = iterator->first;
+        auto& state = iterator->second;
+
+        if (!state.isServing) {
+            if (auto line = UnixSocket::takeLine(state.pending)) {
+                state.isServing = true;
+                this->scheduler.submit([this, connection, line = std::move(line.value())] { this->serveRequest(connection, line); });
+            } else if (state.isClosing || state.pending.size() > MAX_LINE_LENGTH) {
+                close(connection);
+                iterator = this->connections.erase(iterator);
+                continue;
+            }
+        }
+
+        ++iterator;
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void FilterDaemon<IEEE754_t>::serveRequest(int connection, const std::string &line) {
+    auto isWritten = UnixSocket::writeLine(connection, this->handle(line));
+
+    {
+        std::lock_guard lock(this->connectionsMutex);
+        auto& state = this->connections.at(connection);
+
+        state.isServing = false;
+        state.isClosing = state.isClosing || !isWritten;
+    }
+
+    this->wakeUp();
+}
+
+/*
+ * A request that throws (e.g. on a malformed input file, or when out of memory) gets an `error` reply like any other failure, so that
+ * the connection keeps being served and the exception doesn't reach the scheduler.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+std::string FilterDaemon<IEEE754_t>::handle(const std::string &line) {
+    try {
+        return this->replyTo(line);
+    } catch (const std::exception& error) {
+        return std::string("error ") + error.what();
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+std::string FilterDaemon<IEEE754_t>::replyTo(const std::string &line) {
+    auto tokens = FilterRequest::tokenized(line);
+    auto command = tokens.has_value() && !tokens->empty() ? tokens->front() : "";
+
+    if (command == "filter") {
+        auto start = std::chrono::steady_clock::now();
+        auto error = std::string();
+        auto request = FilterRequest::parse(line, error);
+
+        if (!request.has_value()) {
+            return "error " + error;
+        }
+
+        auto input = request->input.string();
+        auto output = request->output.string();
+        auto isShared = input.starts_with(SHARED_SEGMENT_PREFIX) && output.starts_with(SHARED_SEGMENT_PREFIX);
+        auto reply = std::string();
+
+        if (isShared) {
+            auto inputSegment = input.substr(std::string_view(SHARED_SEGMENT_PREFIX).size());
+            auto outputSegment = output.substr(std::string_view(SHARED_SEGMENT_PREFIX).size());
+            auto probe = SharedImage<IEEE754_t, PGMImage<IEEE754_t>>::open(inputSegment);
+            auto channelsCount = probe != nullptr ? probe->getChannelsCount() : 0;
+            delete probe;
+
+            if (channelsCount == 1) {
+                reply = this->filteredSharedWith<PGMImage<IEEE754_t>>(inputSegment, outputSegment, request.value());
+            } else if (channelsCount == 3) {
+                reply = this->filteredSharedWith<PPMImage<IEEE754_t>>(inputSegment, outputSegment, request.value());
+            } else {
+                reply = "error Could not open the input segment";
+            }
+        } else if (request->input.extension() == ".pgm") {
+            reply = this->filteredWith(request.value(), this->pgmPool);
+        } else {
+            reply = this->filteredWith(request.value(), this->ppmPool);
+        }
+
+        if (reply != "ok") {
+            return reply;
+        }
+
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        this->latencies.record(nanoseconds);
+
+        return "ok " + std::to_string(nanoseconds);
+    }
+
+    if (command == "stats") {
+        std::ostringstream json;
+        json << "{\"latency\":" << this->latencies.report().toJSON()
+             << ",\"allocatedImages\":" << this->ppmPool.getAllocatedImagesCount() + this->pgmPool.getAllocatedImagesCount()
+             << ",\"reusedImages\":" << this->ppmPool.getReusedImagesCount() + this->pgmPool.getReusedImagesCount()
+             << ",\"cachedKernels\":" << KernelCache<IEEE754_t>::getCachedKernelsCount() << "}";
+
+        return "ok " + json.str();
+    }
+
+    if (command == "shutdown") {
+        this->stop();
+        return "ok";
+    }
+
+    return "error Unknown command " + command;
+}
+
+/*
+ * Identity and average kernels come from `KernelCache`, which holds at most one per odd size up to `MAX_REQUEST_KERNEL_SIZE`. Gaussian
+ * kernels are generated for the request instead: the cache never frees its kernels, and a client looping over sigmas would fill it with
+ * kernels of up to 255x255 coefficients. Either way, the kernel is handed back to `releaseKernel` once the request is served.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const ConvolutionKernel<IEEE754_t> *FilterDaemon<IEEE754_t>::kernelFor(const FilterRequest &request) const {
+    switch (request.kernelType) {
+        case KernelType::IDENTITY:
+            return KernelCache<IEEE754_t>::identity(request.kernelSize);
+        case KernelType::AVERAGE:
+            return KernelCache<IEEE754_t>::averageKernel(request.kernelSize);
+        case KernelType::GAUSSIAN:
+        default:
+            return Kernels::gaussianKernel<IEEE754_t>(request.kernelSize, static_cast<IEEE754_t>(request.sigma));
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void FilterDaemon<IEEE754_t>::releaseKernel(const FilterRequest &request, const ConvolutionKernel<IEEE754_t> *kernel) const {
+    if (request.kernelType == KernelType::GAUSSIAN) {
+        delete kernel;
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const MatrixPaddingStrategy<IEEE754_t> *FilterDaemon<IEEE754_t>::paddingStrategyFor(const FilterRequest &request) const {
+    if (request.padding == PaddingMode::ZERO) {
+        return &this->zeroPadding;
+    }
+
+    return &this->periodicPadding;
+}
+
+/*
+ * The output image comes from `pool` and goes back to it once written, so that serving images of a size seen before allocates
+ * nothing but the decoded input.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Derived>
+std::string FilterDaemon<IEEE754_t>::filteredWith(const FilterRequest &request, ImagePool<IEEE754_t, Derived> &pool) {
+    INSTRUMENTATION_SCOPE("FilterDaemon::filter");
+
+    auto source = NetpbmImage<IEEE754_t, Derived>::loadImage(request.input);
+    if (source == nullptr) {
+        return "error Could not parse the input image";
+    }
+
+    auto destination = pool.acquire(source);
+    auto kernel = this->kernelFor(request);
+    auto reply = std::string("ok");
+
+    try {
+        source->filteredInto(destination, kernel, this->paddingStrategyFor(request));
+        destination->writeToFile(request.output, request.encoding);
+    } catch (const std::exception& error) {
+        reply = std::string("error ") + error.what();
+    }
+
+    this->releaseKernel(request, kernel);
+    delete source;
+    pool.release(destination);
+    return reply;
+}
+
+/*
+ * The output segment is created, shaped like the input one, when it doesn't exist yet; either way it's left for the client to remove.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Derived>
+std::string FilterDaemon<IEEE754_t>::filteredSharedWith(const std::string &inputSegment, const std::string &outputSegment, const FilterRequest &request) {
+    INSTRUMENTATION_SCOPE("FilterDaemon::filterShared");
+
+    auto source = SharedImage<IEEE754_t, Derived>::open(inputSegment);
+    if (source == nullptr) {
+        return "error Could not open the input segment";
+    }
+
+    auto destination = SharedImage<IEEE754_t, Derived>::open(outputSegment);
+    if (destination == nullptr) {
+        destination = SharedImage<IEEE754_t, Derived>::create(outputSegment, source->getWidth(), source->getHeight(), source->getChannelsCount(), source->getMaxValue(), source->getMatrixLayout(), source->getArrangement());
+    }
+
+    auto reply = std::string("ok");
+    if (destination == nullptr) {
+        reply = "error Could not open the output segment";
+    } else if (destination->getWidth() != source->getWidth() || destination->getHeight() != source->getHeight() || destination->getChannelsCount() != source->getChannelsCount()) {
+        reply = "error The output segment doesn't have the shape of the input one";
+    } else {
+        auto kernel = this->kernelFor(request);
+
+        try {
+            source->filteredInto(destination, kernel, this->paddingStrategyFor(request));
+        } catch (const std::exception& error) {
+            reply = std::string("error ") + error.what();
+        }
+
+        this->releaseKernel(request, kernel);
+    }
+
+    delete source;
+    delete destination;
+    return reply;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+LatencyReport FilterDaemon<IEEE754_t>::getLatencyReport() const {
+    return this->latencies.report();
+}
+
+template class FilterDaemon<float>;
+template class FilterDaemon<double>;
+template class FilterDaemon<long double>;
@@ -0,0 +1,113 @@
+#ifndef IMAGECONVOLUTIONKERNEL_FILTERDAEMON_H
+#define IMAGECONVOLUTIONKERNEL_FILTERDAEMON_H
+
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "FilterRequest.h"
+#include "LatencyRecorder.h"
+#include "../Image/ImageFormats/PPM/PPMImage.h"
+#include "../Image/ImageFormats/PGM/PGMImage.h"
+#include "../MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+#include "../Pool/ImagePool.h"
+#include "../Scheduler/WorkStealingScheduler.h"
+#include "../SharedMemory/SharedImage.h"
+
+// How long a worker waits for a client to make room for its reply, before giving up on the connection.
+constexpr unsigned int REPLY_TIMEOUT_SECONDS = 10;
+
+/*
+ * A long running filtering service on a Unix domain socket, so that filtering an image costs a request instead of a process: the worker
+ * threads, the identity and average kernels of `KernelCache`, the output images of the `ImagePool`s and the scratch buffers that filtering
+ * keeps per thread all stay warm from one request to the next.
+ *
+ * Clients (see `FilterClient`) send one command per line and get one reply line for each; a connection sending a line longer than
+ * `MAX_LINE_LENGTH`, or not reading its replies for `REPLY_TIMEOUT_SECONDS`, is closed:
+ *
+ * - `filter ...` (see `FilterRequest`): loads, filters and writes an image, replies `ok <nanoseconds taken>` or `error <reason>`. When both
+ *   the input and the output are `shm:<segment name>`, the image is read from and filtered into `SharedImage` segments instead of files.
+ * - `stats`: replies `ok` followed by a JSON object with the latency percentiles of the served requests and the pool and cache counters.
+ * - `shutdown`: replies `ok` and stops the daemon, once the requests in progress have been answered.
+ *
+ * The thread calling `serve` polls all the connections, and hands each complete request line to a worker of the scheduler: requests are
+ * served in parallel up to `workersCount` of them, while the requests of a connection are served one at a time, in order. Idle clients
+ * hold no worker, however many of them stay connected.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class FilterDaemon {
+private:
+    std::filesystem::path socketPath;
+    int listeningSocket;
+    std::atomic<bool> isStopping = false;
+    // Written to by `stop` and by the workers done with a request, to wake the thread polling the connections.
+    int wakeUpPipe[2] = {-1, -1};
+
+    struct Connection {
+        // Received bytes not yet handed to a worker.
+        std::string pending;
+        // Whether a worker is serving a request of the connection, during which it isn't read.
+        bool isServing = false;
+        // Whether the peer closed the connection, or a reply couldn't be written: it's closed once its pending lines are served.
+        bool isClosing = false;
+    };
+
+    std::mutex connectionsMutex;
+    std::map<int, Connection> connections;
+
+    ZeroPaddingMatrixPaddingStrategy<IEEE754_t> zeroPadding;
+    PeriodicExtensionMatrixPaddingStrategy<IEEE754_t> periodicPadding;
+    ImagePool<IEEE754_t, PPMImage<IEEE754_t>> ppmPool;
+    ImagePool<IEEE754_t, PGMImage<IEEE754_t>> pgmPool;
+    LatencyRecorder latencies;
+
+    // Last, so that its workers are joined before anything they use is destroyed.
+    WorkStealingScheduler scheduler;
+
+    const ConvolutionKernel<IEEE754_t>* kernelFor(const FilterRequest& request) const;
+    void releaseKernel(const FilterRequest& request, const ConvolutionKernel<IEEE754_t>* kernel) const;
+    const MatrixPaddingStrategy<IEEE754_t>* paddingStrategyFor(const FilterRequest& request) const;
+
+    template<typename Derived>
+    std::string filteredWith(const FilterRequest& request, ImagePool<IEEE754_t, Derived>& pool);
+    template<typename Derived>
+    std::string filteredSharedWith(const std::string& inputSegment, const std::string& outputSegment, const FilterRequest& request);
+    void acceptConnection();
+    void receiveFrom(int connection);
+    void dispatchRequests();
+    void serveRequest(int connection, const std::string& line);
+    void wakeUp();
+    std::string replyTo(const std::string& line);
+
+public:
+    explicit FilterDaemon(const std::filesystem::path& socketPath, unsigned int workersCount = std::thread::hardware_concurrency(), unsigned int maxPooledImagesPerSize = 4);
+    FilterDaemon(const FilterDaemon&) = delete;
+    FilterDaemon& operator=(const FilterDaemon&) = delete;
+    ~FilterDaemon();
+
+    [[nodiscard]] bool isListening() const;
+
+    /*
+     * Accepts and serves connections until `stop` is called or a client sends `shutdown`.
+     */
+    void serve();
+
+    /*
+     * Makes `serve` return. Only async-signal-safe calls, so that it can be called from a signal handler.
+     */
+    void stop();
+
+    /*
+     * The reply to the command `line`, as sent to the clients.
+     */
+    std::string handle(const std::string& line);
+
+    [[nodiscard]] LatencyReport getLatencyReport() const;
+};
+
+#endif
@@ -0,0 +1,191 @@
+#include "FilterRequest.h"
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+
+namespace {
+    template<typename Number>
+    bool parsedNumber(const std::string& value, Number& number) {
+        auto end = value.data() + value.size();
+        auto [parsedUntil, errorCode] = std::from_chars(value.data(), end, number);
+
+        return errorCode == std::errc() && parsedUntil == end;
+    }
+
+    std::string formattedNumber(double number) {
+        char buffer[32];
+        auto [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+
+        return {buffer, end};
+    }
+
+    const char* nameOf(KernelType kernelType) {
+        switch (kernelType) {
+            case KernelType::IDENTITY:
+                return "identity";
+            case KernelType::AVERAGE:
+                return "average";
+            case KernelType::GAUSSIAN:
+            default:
+                return "gaussian";
+        }
+    }
+}
+
+std::optional<std::vector<std::string>> FilterRequest::tokenized(const std::string &line) {
+    auto tokens = std::vector<std::string>();
+    auto token = std::string();
+    auto isInToken = false;
+    auto isQuoted = false;
+
+    for (size_t i = 0; i < line.size(); i++) {
+        auto character = line[i];
+
+        if (isQuoted) {
+            if (character == '\\' && i + 1 < line.size()) {
+                token += line[++i];
+            } else if (character == '"') {
+                isQuoted = false;
+            } else {
+                token += character;
+            }
+        } else if (std::isspace(static_cast<unsigned char>(character))) {
+            if (isInToken) {
+                tokens.push_back(token);
+                token.clear();
+                isInToken = false;
+            }
+        } else {
+            isInToken = true;
+
+            if (character == '"') {
+                isQuoted = true;
+            } else {
+                token += character;
+            }
+        }
+    }
+
+    if (isQuoted) {
+        return std::nullopt;
+    }
+
+    if (isInToken) {
+        tokens.push_back(token);
+    }
+
+    return tokens;
+}
+
+std::string FilterRequest::quoted(const std::string &value) {
+    auto needsQuotes = value.empty();
+    for (auto character : value) {
+        needsQuotes = needsQuotes || std::isspace(static_cast<unsigned char>(character)) || character == '"' || character == '\\';
+    }
+
+    if (!needsQuotes) {
+        return value;
+    }
+
+    auto quotedValue = std::string("\"");
+    for (auto character : value) {
+        if (character == '"' || character == '\\') {
+            quotedValue += '\\';
+        }
+        quotedValue += character;
+    }
+
+    return quotedValue + "\"";
+}
+
+std::string FilterRequest::toLine() const {
+    return "filter input=" + quoted(this->input.string())
+        + " output=" + quoted(this->output.string())
+        + " kernel=" + nameOf(this->kernelType)
+        + " size=" + std::to_string(this->kernelSize)
+        + " sigma=" + formattedNumber(this->sigma)
+        + " padding=" + (this->padding == PaddingMode::ZERO ? "zero" : "periodic")
+        + " encoding=" + (this->encoding == ImageChannelsEncoding::PLAIN ? "plain" : "binary");
+}
+
+std::optional<FilterRequest> FilterRequest::parse(const std::string &line, std::string &error) {
+    auto tokens = tokenized(line);
+
+    if (!tokens.has_value()) {
+        error = "Unterminated quoted value";
+        return std::nullopt;
+    }
+
+    if (tokens->empty() || tokens->front() != "filter") {
+        error = "Not a filter request";
+        return std::nullopt;
+    }
+
+    auto request = FilterRequest();
+
+    for (size_t i = 1; i < tokens->size(); i++) {
+        const auto& token = (*tokens)[i];
+        auto separator = token.find('=');
+
+        if (separator == std::string::npos) {
+            error = "Expected key=value, got " + token;
+            return std::nullopt;
+        }
+
+        auto key = token.substr(0, separator);
+        auto value = token.substr(separator + 1);
+        auto isValid = true;
+
+        if (key == "input") {
+            request.input = value;
+        } else if (key == "output") {
+            request.output = value;
+        } else if (key == "kernel") {
+            if (value == "identity") {
+                request.kernelType = KernelType::IDENTITY;
+            } else if (value == "average") {
+                request.kernelType = KernelType::AVERAGE;
+            } else if (value == "gaussian") {
+                request.kernelType = KernelType::GAUSSIAN;
+            } else {
+                isValid = false;
+            }
+        } else if (key == "size") {
+            isValid = parsedNumber(value, request.kernelSize) && request.kernelSize % 2 == 1 && request.kernelSize <= MAX_REQUEST_KERNEL_SIZE;
+        } else if (key == "sigma") {
+            isValid = parsedNumber(value, request.sigma) && std::isfinite(request.sigma) && request.sigma > 0;
+        } else if (key == "padding") {
+            if (value == "zero") {
+                request.padding = PaddingMode::ZERO;
+            } else if (value == "periodic") {
+                request.padding = PaddingMode::PERIODIC;
+            } else {
+                isValid = false;
+            }
+        } else if (key == "encoding") {
+            if (value == "plain") {
+                request.encoding = ImageChannelsEncoding::PLAIN;
+            } else if (value == "binary") {
+                request.encoding = ImageChannelsEncoding::BINARY;
+            } else {
+                isValid = false;
+            }
+        } else {
+            error = "Unknown field " + key;
+            return std::nullopt;
+        }
+
+        if (!isValid) {
+            error = "Invalid " + key + ": " + value;
+            return std::nullopt;
+        }
+    }
+
+    if (request.input.empty() || request.output.empty()) {
+        error = "Both input and output are required";
+        return std::nullopt;
+    }
+
+    return request;
+}
@@ -0,0 +1,56 @@
+#ifndef IMAGECONVOLUTIONKERNEL_FILTERREQUEST_H
+#define IMAGECONVOLUTIONKERNEL_FILTERREQUEST_H
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../ConvolutionKernel/KernelCache/KernelCache.h"
+#include "../Image/Image.h"
+
+// Prefix of the `input` and `output` of the requests naming `SharedImage` segments rather than files.
+constexpr const char* SHARED_SEGMENT_PREFIX = "shm:";
+
+// Largest `size` accepted by `FilterRequest::parse`, far beyond any useful kernel but small enough for its coefficients to fit in memory.
+constexpr unsigned int MAX_REQUEST_KERNEL_SIZE = 255;
+
+enum class PaddingMode {
+    ZERO = 0,
+    PERIODIC = 1
+};
+
+/*
+ * A request to `FilterDaemon`, sent as a single line of whitespace separated `key=value` fields after the `filter` command:
+ *
+ *   filter input=in.ppm output=out kernel=gaussian size=9 sigma=1.3 padding=periodic encoding=binary
+ *
+ * `input` and `output` are required, the other fields default to the values below. Values containing whitespace or quotes are written
+ * between double quotes, with `\"` and `\\` escapes (see `quoted`). As with `Image::writeToFile`, `output` is expected without extension.
+ * Whether the input is a PGM or a PPM image is told by its extension, anything but `.pgm` is read as PPM. `shm:<segment name>` as both
+ * the input and the output names shared memory segments instead (see `SharedImage`).
+ */
+struct FilterRequest {
+    std::filesystem::path input;
+    std::filesystem::path output;
+    KernelType kernelType = KernelType::GAUSSIAN;
+    unsigned int kernelSize = 3;
+    double sigma = 1.0;
+    PaddingMode padding = PaddingMode::PERIODIC;
+    ImageChannelsEncoding encoding = ImageChannelsEncoding::BINARY;
+
+    [[nodiscard]] std::string toLine() const;
+
+    /*
+     * The request of `line`, or empty with the reason in `error` when it's malformed or names an unknown field or value.
+     */
+    static std::optional<FilterRequest> parse(const std::string& line, std::string& error);
+
+    /*
+     * The words of `line`, with the quotes of quoted values removed. Empty if a quote isn't closed.
+     */
+    static std::optional<std::vector<std::string>> tokenized(const std::string& line);
+    static std::string quoted(const std::string& value);
+};
+
+#endif
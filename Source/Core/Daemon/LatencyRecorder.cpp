@@ -0,0 +1,77 @@
+#include "LatencyRecorder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
+std::string LatencyReport::toJSON() const {
+    std::ostringstream json;
+    json << "{\"count\":" << this->count
+         << ",\"meanNanoseconds\":" << this->meanNanoseconds
+         << ",\"p50Nanoseconds\":" << this->p50Nanoseconds
+         << ",\"p90Nanoseconds\":" << this->p90Nanoseconds
+         << ",\"p99Nanoseconds\":" << this->p99Nanoseconds
+         << ",\"maxNanoseconds\":" << this->maxNanoseconds << "}";
+
+    return json.str();
+}
+
+LatencyRecorder::LatencyRecorder(size_t capacity) : capacity(capacity) {
+    assert(capacity > 0);
+}
+
+void LatencyRecorder::record(long long nanoseconds) {
+    std::lock_guard lock(this->mutex);
+
+    if (this->samples.size() < this->capacity) {
+        this->samples.push_back(nanoseconds);
+    } else {
+        this->samples[this->nextSample] = nanoseconds;
+    }
+
+    this->nextSample = (this->nextSample + 1) % this->capacity;
+    this->recordedSamples++;
+}
+
+LatencyReport LatencyRecorder::report() const {
+    std::vector<long long> sortedSamples;
+    auto report = LatencyReport();
+
+    {
+        std::lock_guard lock(this->mutex);
+        sortedSamples = this->samples;
+        report.count = this->recordedSamples;
+    }
+
+    if (sortedSamples.empty()) {
+        return report;
+    }
+
+    std::sort(sortedSamples.begin(), sortedSamples.end());
+
+    auto percentile = [&sortedSamples](size_t percent) {
+        auto rank = (percent * sortedSamples.size() + 99) / 100;
+        return sortedSamples[std::max<size_t>(rank, 1) - 1];
+    };
+
+    long double total = 0;
+    for (auto sample : sortedSamples) {
+        total += sample;
+    }
+
+    report.meanNanoseconds = static_cast<long long>(total / sortedSamples.size());
+    report.p50Nanoseconds = percentile(50);
+    report.p90Nanoseconds = percentile(90);
+    report.p99Nanoseconds = percentile(99);
+    report.maxNanoseconds = sortedSamples.back();
+
+    return report;
+}
+
+void LatencyRecorder::reset() {
+    std::lock_guard lock(this->mutex);
+
+    this->samples.clear();
+    this->nextSample = 0;
+    this->recordedSamples = 0;
+}
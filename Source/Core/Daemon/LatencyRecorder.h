@@ -0,0 +1,41 @@
+#ifndef IMAGECONVOLUTIONKERNEL_LATENCYRECORDER_H
+#define IMAGECONVOLUTIONKERNEL_LATENCYRECORDER_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct LatencyReport {
+    unsigned long long count = 0;
+    long long meanNanoseconds = 0;
+    long long p50Nanoseconds = 0;
+    long long p90Nanoseconds = 0;
+    long long p99Nanoseconds = 0;
+    long long maxNanoseconds = 0;
+
+    [[nodiscard]] std::string toJSON() const;
+};
+
+/*
+ * Latencies of the requests served by a long running process. Only the last `capacity` samples are kept, so that the percentiles follow the
+ * current load rather than the whole uptime, and memory stays bounded; `count` is still the total number of recorded samples.
+ *
+ * Percentiles are nearest-rank: p50 is the smallest kept sample that at least half of the kept samples don't exceed. Thread safe.
+ */
+class LatencyRecorder {
+private:
+    mutable std::mutex mutex;
+    std::vector<long long> samples;
+    size_t capacity;
+    size_t nextSample = 0;
+    unsigned long long recordedSamples = 0;
+
+public:
+    explicit LatencyRecorder(size_t capacity = 1 << 16);
+
+    void record(long long nanoseconds);
+    [[nodiscard]] LatencyReport report() const;
+    void reset();
+};
+
+#endif
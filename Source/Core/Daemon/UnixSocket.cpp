@@ -0,0 +1,124 @@
+#include "UnixSocket.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    bool addressOf(const std::filesystem::path& path, sockaddr_un& address) {
+        auto pathString = path.string();
+
+        if (pathString.empty() || pathString.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, pathString.c_str(), pathString.size() + 1);
+        return true;
+    }
+}
+
+int UnixSocket::listenOn(const std::filesystem::path &path, int backlog) {
+    sockaddr_un address{};
+    if (!addressOf(path, address)) {
+        return -1;
+    }
+
+    auto listeningSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listeningSocket < 0) {
+        return -1;
+    }
+
+    unlink(address.sun_path);
+
+    if (bind(listeningSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listeningSocket, backlog) != 0) {
+        close(listeningSocket);
+        return -1;
+    }
+
+    return listeningSocket;
+}
+
+int UnixSocket::connectTo(const std::filesystem::path &path) {
+    sockaddr_un address{};
+    if (!addressOf(path, address)) {
+        return -1;
+    }
+
+    auto connectedSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (connectedSocket < 0) {
+        return -1;
+    }
+
+    if (connect(connectedSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(connectedSocket);
+        return -1;
+    }
+
+    return connectedSocket;
+}
+
+std::optional<std::string> UnixSocket::readLine(int socket, std::string &pending) {
+    char buffer[4096];
+
+    while (true) {
+        if (auto line = takeLine(pending)) {
+            return line;
+        }
+
+        if (pending.size() > MAX_LINE_LENGTH) {
+            return std::nullopt;
+        }
+
+        auto received = recv(socket, buffer, sizeof(buffer), 0);
+
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (received <= 0) {
+            return std::nullopt;
+        }
+
+        pending.append(buffer, received);
+    }
+}
+
+std::optional<std::string> UnixSocket::takeLine(std::string &pending) {
+    auto terminator = pending.find('\n');
+
+    if (terminator == std::string::npos) {
+        return std::nullopt;
+    }
+
+    auto line = pending.substr(0, terminator);
+    pending.erase(0, terminator + 1);
+    return line;
+}
+
+/*
+ * MSG_NOSIGNAL: a peer that went away is a failed write, not a SIGPIPE killing the process.
+ */
+bool UnixSocket::writeLine(int socket, const std::string &line) {
+    auto message = line + "\n";
+    size_t sent = 0;
+
+    while (sent < message.size()) {
+        auto written = send(socket, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (written <= 0) {
+            return false;
+        }
+
+        sent += written;
+    }
+
+    return true;
+}
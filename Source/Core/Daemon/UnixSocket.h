@@ -0,0 +1,42 @@
+#ifndef IMAGECONVOLUTIONKERNEL_UNIXSOCKET_H
+#define IMAGECONVOLUTIONKERNEL_UNIXSOCKET_H
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+// Longest line `UnixSocket::readLine` waits for, so that a peer never sending a terminator can't make it buffer without end.
+constexpr size_t MAX_LINE_LENGTH = 64 * 1024;
+
+/*
+ * The few socket calls shared by `FilterDaemon` and `FilterClient`: stream sockets bound to a filesystem path, exchanging
+ * newline terminated text lines. All of them work on plain file descriptors, which the caller closes.
+ */
+namespace UnixSocket {
+    /*
+     * A socket listening on `path`, replacing any stale socket file left there. -1 if it can't be bound.
+     */
+    int listenOn(const std::filesystem::path& path, int backlog = 64);
+
+    /*
+     * A socket connected to the one listening on `path`, or -1.
+     */
+    int connectTo(const std::filesystem::path& path);
+
+    /*
+     * The next line received on `socket`, without its terminator. Bytes received past the terminator are kept in `pending`, to be
+     * passed again to the next call. Empty once the peer closed the connection (or on error) with no complete line left, or once more than
+     * `MAX_LINE_LENGTH` bytes were received without a terminator, in which case the caller should close the connection.
+     */
+    std::optional<std::string> readLine(int socket, std::string& pending);
+
+    /*
+     * The first complete line of `pending`, without its terminator, removed from `pending`. Empty if there's none yet.
+     */
+    std::optional<std::string> takeLine(std::string& pending);
+
+    bool writeLine(int socket, const std::string& line);
+}
+
+#endif
@@ -0,0 +1,232 @@
+#include "EdgeDetector.h"
+
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+#include "../ConvolutionKernel/Kernels/EdgeKernels.cpp"
+#include "../Instrumentation/Instrumentation.h"
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+EdgeDetector<IEEE754_t>::EdgeDetector(EdgeOperator edgeOperator, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) : edgeOperator(edgeOperator), paddingStrategy(withPaddingStrategy) {
+    assert(withPaddingStrategy != nullptr);
+
+    ConvolutionKernel<IEEE754_t>* horizontalKernel;
+    ConvolutionKernel<IEEE754_t>* verticalKernel;
+
+    switch (edgeOperator) {
+        case EdgeOperator::SOBEL:
+            horizontalKernel = Kernels::sobelX<IEEE754_t>();
+            verticalKernel = Kernels::sobelY<IEEE754_t>();
+            break;
+        case EdgeOperator::SCHARR:
+            horizontalKernel = Kernels::scharrX<IEEE754_t>();
+            verticalKernel = Kernels::scharrY<IEEE754_t>();
+            break;
+        case EdgeOperator::PREWITT:
+        default:
+            horizontalKernel = Kernels::prewittX<IEEE754_t>();
+            verticalKernel = Kernels::prewittY<IEEE754_t>();
+            break;
+    }
+
+    for (int i = -1; i <= 1; i++) {
+        for (int j = -1; j <= 1; j++) {
+            this->horizontalKernelValues.push_back(horizontalKernel->getValue(i, j));
+            this->verticalKernelValues.push_back(verticalKernel->getValue(i, j));
+        }
+    }
+
+    delete horizontalKernel;
+    delete verticalKernel;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+EdgeOperator EdgeDetector<IEEE754_t>::getEdgeOperator() const {
+    return this->edgeOperator;
+}
+
+/*
+ * Calls `store(row, column, horizontalDerivative, verticalDerivative)` for each pixel of `channel`.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Store>
+void EdgeDetector<IEEE754_t>::forEachGradient(const Channel<IEEE754_t> *channel, Store store) const {
+    assert(channel != nullptr);
+
+    auto horizontalValues = this->horizontalKernelValues.data();
+    auto verticalValues = this->verticalKernelValues.data();
+
+    channel->forEachBlockWithHalo({0, 0, channel->getRows(), channel->getColumns()}, -1, 1, -1, 1, this->paddingStrategy,
+        [horizontalValues, verticalValues, &store](const MatrixRegion& block, const IEEE754_t* values, int stride) {
+            for (unsigned int row = 0; row < block.rows; row++) {
+                for (unsigned int column = 0; column < block.columns; column++) {
+                    auto windowOrigin = values + row * stride + column;
+                    IEEE754_t horizontalDerivative = 0;
+                    IEEE754_t verticalDerivative = 0;
+
+                    for (int i = 0; i < 3; i++) {
+                        for (int j = 0; j < 3; j++) {
+                            auto value = windowOrigin[i * stride + j];
+
+                            horizontalDerivative += value * horizontalValues[i * 3 + j];
+                            verticalDerivative += value * verticalValues[i * 3 + j];
+                        }
+                    }
+
+                    store(block.row + row, block.column + column, horizontalDerivative, verticalDerivative);
+                }
+            }
+        }
+    );
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+EdgeMaps<IEEE754_t> EdgeDetector<IEEE754_t>::gradient(const Channel<IEEE754_t> *channel) const {
+    assert(channel != nullptr);
+    INSTRUMENTATION_SCOPE("EdgeDetector::gradient");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, channel->getRows() * channel->getColumns());
+
+    auto rows = channel->getRows();
+    auto columns = channel->getColumns();
+    auto layout = channel->getMatrixLayout();
+
+    auto magnitudes = new IEEE754_t[rows * columns];
+    auto orientations = new IEEE754_t[rows * columns];
+
+    this->forEachGradient(channel, [channel, magnitudes, orientations, rows, columns, layout](unsigned int row, unsigned int column, IEEE754_t horizontalDerivative, IEEE754_t verticalDerivative) {
+        auto flatIndex = flatIndexOf(row, column, rows, columns, layout);
+        auto orientation = std::atan2(verticalDerivative, horizontalDerivative) * 180 / std::numbers::pi_v<IEEE754_t>;
+
+        magnitudes[flatIndex] = channel->saturated(std::hypot(horizontalDerivative, verticalDerivative));
+        orientations[flatIndex] = orientation < 0 ? orientation + 360 : orientation;
+    });
+
+    auto edgeMaps = EdgeMaps<IEEE754_t>{
+        new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), magnitudes, rows, columns, layout),
+        new Channel<IEEE754_t>(360, orientations, rows, columns, layout)
+    };
+
+    delete[] magnitudes;
+    delete[] orientations;
+
+    return edgeMaps;
+}
+
+/*
+ * Canny-like edge map: pixels are 0, or the maximum value of `channel` on edges.
+ *
+ * When `suppressNonMaxima` is set, only the pixels whose gradient magnitude is a maximum along the direction of the gradient (quantized to
+ * 45 degrees, the pixels outside the channel count as 0) are edge candidates. Candidates with a magnitude of at least `highThreshold` are edges,
+ * and so are those of at least `lowThreshold` 8-connected to an edge (hysteresis). Passing the same value for both thresholds gives a plain
+ * threshold of the magnitude.
+ *
+ * Magnitudes are compared before rounding and saturation, so thresholds above the maximum value of the channel are meaningful.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *EdgeDetector<IEEE754_t>::edges(const Channel<IEEE754_t> *channel, IEEE754_t lowThreshold, IEEE754_t highThreshold, bool suppressNonMaxima) const {
+    assert(channel != nullptr);
+    assert(lowThreshold <= highThreshold);
+    INSTRUMENTATION_SCOPE("EdgeDetector::edges");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, channel->getRows() * channel->getColumns());
+
+    enum Direction : unsigned char { HORIZONTAL, DIAGONAL, VERTICAL, ANTIDIAGONAL };
+
+    auto rows = static_cast<int>(channel->getRows());
+    auto columns = static_cast<int>(channel->getColumns());
+
+    auto magnitudes = std::vector<IEEE754_t>(rows * columns);
+    auto directions = std::vector<Direction>(rows * columns);
+
+    this->forEachGradient(channel, [&magnitudes, &directions, columns](unsigned int row, unsigned int column, IEEE754_t horizontalDerivative, IEEE754_t verticalDerivative) {
+        // tan(22.5°) and tan(67.5°), to quantize the direction without computing the angle.
+        constexpr IEEE754_t lowerSlope = 0.41421356237309504880;
+        constexpr IEEE754_t upperSlope = 2.41421356237309504880;
+
+        auto absoluteHorizontal = std::abs(horizontalDerivative);
+        auto absoluteVertical = std::abs(verticalDerivative);
+        auto index = row * columns + column;
+
+        magnitudes[index] = std::hypot(horizontalDerivative, verticalDerivative);
+
+        if (absoluteVertical <= absoluteHorizontal * lowerSlope) {
+            directions[index] = HORIZONTAL;
+        } else if (absoluteVertical >= absoluteHorizontal * upperSlope) {
+            directions[index] = VERTICAL;
+        } else {
+            directions[index] = (horizontalDerivative > 0) == (verticalDerivative > 0) ? DIAGONAL : ANTIDIAGONAL;
+        }
+    });
+
+    auto magnitudeAt = [&magnitudes, rows, columns](int row, int column) {
+        return row >= 0 && row < rows && column >= 0 && column < columns ? magnitudes[row * columns + column] : static_cast<IEEE754_t>(0);
+    };
+
+    // Offsets (row, column) of the neighbour along the gradient, for each direction; the other neighbour is the opposite one.
+    constexpr int neighbourOffsets[4][2] = {{0, 1}, {1, 1}, {1, 0}, {1, -1}};
+
+    auto candidates = std::vector<IEEE754_t>(rows * columns);
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            auto index = row * columns + column;
+            auto magnitude = magnitudes[index];
+
+            if (suppressNonMaxima) {
+                auto offset = neighbourOffsets[directions[index]];
+
+                if (magnitude < magnitudeAt(row + offset[0], column + offset[1]) || magnitude < magnitudeAt(row - offset[0], column - offset[1])) {
+                    magnitude = 0;
+                }
+            }
+
+            candidates[index] = magnitude;
+        }
+    }
+
+    auto isEdge = std::vector<bool>(rows * columns, false);
+    auto pendingEdges = std::vector<int>();
+
+    for (int index = 0; index < rows * columns; index++) {
+        if (candidates[index] >= highThreshold && candidates[index] > 0) {
+            isEdge[index] = true;
+            pendingEdges.push_back(index);
+        }
+    }
+
+    while (!pendingEdges.empty()) {
+        auto index = pendingEdges.back();
+        pendingEdges.pop_back();
+
+        auto row = index / columns;
+        auto column = index % columns;
+
+        for (int i = std::max(row - 1, 0); i <= std::min(row + 1, rows - 1); i++) {
+            for (int j = std::max(column - 1, 0); j <= std::min(column + 1, columns - 1); j++) {
+                auto neighbourIndex = i * columns + j;
+
+                if (!isEdge[neighbourIndex] && candidates[neighbourIndex] >= lowThreshold && candidates[neighbourIndex] > 0) {
+                    isEdge[neighbourIndex] = true;
+                    pendingEdges.push_back(neighbourIndex);
+                }
+            }
+        }
+    }
+
+    auto layout = channel->getMatrixLayout();
+    auto edgeElements = new IEEE754_t[rows * columns];
+
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            edgeElements[flatIndexOf(row, column, rows, columns, layout)] = isEdge[row * columns + column] ? channel->getMaxTheoreticalValue() : 0;
+        }
+    }
+
+    auto edgeChannel = new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), edgeElements, rows, columns, layout);
+    delete[] edgeElements;
+
+    return edgeChannel;
+}
+
+template class EdgeDetector<float>;
+template class EdgeDetector<double>;
+template class EdgeDetector<long double>;
@@ -0,0 +1,52 @@
+#ifndef IMAGECONVOLUTIONKERNEL_EDGEDETECTOR_H
+#define IMAGECONVOLUTIONKERNEL_EDGEDETECTOR_H
+
+#include <type_traits>
+#include <vector>
+
+#include "../Channel/Channel.h"
+
+enum class EdgeOperator {
+    SOBEL = 0,
+    SCHARR = 1,
+    PREWITT = 2
+};
+
+/*
+ * The gradient of a channel: `magnitude` has the same maximum value of the filtered channel and saturates like `Channel::filtered` does,
+ * `orientation` holds the direction of the gradient in degrees, in [0, 360[, measured from the column axis towards the row axis.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+struct EdgeMaps {
+    Channel<IEEE754_t>* magnitude;
+    Channel<IEEE754_t>* orientation;
+};
+
+/*
+ * Edge detection with the 3x3 first derivative operators of `Kernels` (see EdgeKernels.cpp).
+ *
+ * Both derivatives, the magnitude and the orientation are computed in a single tiled pass over the channel, reading each neighbourhood once,
+ * instead of filtering twice and combining two intermediate channels. The derivatives are accumulated in the same order as `Channel::filtered`
+ * with the operator kernels, so the results match the unfused computation.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class EdgeDetector {
+private:
+    EdgeOperator edgeOperator;
+    const MatrixPaddingStrategy<IEEE754_t>* paddingStrategy;
+    std::vector<IEEE754_t> horizontalKernelValues;
+    std::vector<IEEE754_t> verticalKernelValues;
+
+    template<typename Store>
+    void forEachGradient(const Channel<IEEE754_t>* channel, Store store) const;
+
+public:
+    EdgeDetector(EdgeOperator edgeOperator, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy);
+
+    [[nodiscard]] EdgeOperator getEdgeOperator() const;
+
+    EdgeMaps<IEEE754_t> gradient(const Channel<IEEE754_t>* channel) const;
+    Channel<IEEE754_t>* edges(const Channel<IEEE754_t>* channel, IEEE754_t lowThreshold, IEEE754_t highThreshold, bool suppressNonMaxima = true) const;
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "GuidedFilter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "../Instrumentation/Instrumentation.h"
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+GuidedFilter<IEEE754_t>::GuidedFilter(unsigned int radius, IEEE754_t epsilon) : radius(radius), epsilon(epsilon) {
+    assert(epsilon > 0);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int GuidedFilter<IEEE754_t>::getRadius() const {
+    return this->radius;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+IEEE754_t GuidedFilter<IEEE754_t>::getEpsilon() const {
+    return this->epsilon;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *GuidedFilter<IEEE754_t>::filtered(const Channel<IEEE754_t> *channel, const Channel<IEEE754_t> *guide) const {
+    assert(channel != nullptr && guide != nullptr);
+    assert(channel->getRows() == guide->getRows() && channel->getColumns() == guide->getColumns());
+    INSTRUMENTATION_SCOPE("GuidedFilter::filtered");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, channel->getRows() * channel->getColumns());
+
+    using Sum = std::conditional_t<(sizeof(IEEE754_t) < sizeof(double)), double, IEEE754_t>;
+
+    auto rows = static_cast<int>(channel->getRows());
+    auto columns = static_cast<int>(channel->getColumns());
+    auto layout = channel->getMatrixLayout();
+    auto radius = static_cast<int>(this->radius);
+    auto epsilon = static_cast<Sum>(this->epsilon);
+
+    auto filteredChannel = new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), rows, columns, layout);
+    auto destination = filteredChannel->getMutableElements();
+
+    auto rowsInWindow = [rows, radius](int row) {
+        return std::min(row + radius, rows - 1) - std::max(row - radius, 0) + 1;
+    };
+
+    // Box sums along a row of column sums, through its prefix sums: `boxSums[c]` is the sum over the columns of the window around c.
+    auto prefixSums = std::vector<Sum>(columns + 1);
+    auto boxAlongRow = [&prefixSums, columns, radius](const std::vector<Sum>& columnSums, std::vector<Sum>& boxSums) {
+        prefixSums[0] = 0;
+        for (int column = 0; column < columns; column++) {
+            prefixSums[column + 1] = prefixSums[column] + columnSums[column];
+        }
+
+        for (int column = 0; column < columns; column++) {
+            boxSums[column] = prefixSums[std::min(column + radius + 1, columns)] - prefixSums[std::max(column - radius, 0)];
+        }
+    };
+
+    auto guideSums = std::vector<Sum>(columns, 0);
+    auto channelSums = std::vector<Sum>(columns, 0);
+    auto guideSquaresSums = std::vector<Sum>(columns, 0);
+    auto productsSums = std::vector<Sum>(columns, 0);
+
+    // Adds (`sign` = 1) or removes (-1) a row of the inputs to the running column sums of the first pass.
+    auto updateInputSums = [&](int row, Sum sign) {
+        for (int column = 0; column < columns; column++) {
+            Sum guideValue = guide->at(row, column);
+            Sum channelValue = channel->at(row, column);
+
+            guideSums[column] += sign * guideValue;
+            channelSums[column] += sign * channelValue;
+            guideSquaresSums[column] += sign * guideValue * guideValue;
+            productsSums[column] += sign * guideValue * channelValue;
+        }
+    };
+
+    auto ringRows = 2 * radius + 2;
+    auto slopes = std::vector<Sum>(static_cast<size_t>(ringRows) * columns);
+    auto intercepts = std::vector<Sum>(static_cast<size_t>(ringRows) * columns);
+    auto slopesSums = std::vector<Sum>(columns, 0);
+    auto interceptsSums = std::vector<Sum>(columns, 0);
+
+    // Adds or removes a row of coefficients to the running column sums of the second pass.
+    auto updateCoefficientsSums = [&](int row, Sum sign) {
+        auto slopesRow = slopes.data() + static_cast<size_t>(row % ringRows) * columns;
+        auto interceptsRow = intercepts.data() + static_cast<size_t>(row % ringRows) * columns;
+
+        for (int column = 0; column < columns; column++) {
+            slopesSums[column] += sign * slopesRow[column];
+            interceptsSums[column] += sign * interceptsRow[column];
+        }
+    };
+
+    auto guideBoxSums = std::vector<Sum>(columns);
+    auto channelBoxSums = std::vector<Sum>(columns);
+    auto guideSquaresBoxSums = std::vector<Sum>(columns);
+    auto productsBoxSums = std::vector<Sum>(columns);
+    auto slopesBoxSums = std::vector<Sum>(columns);
+    auto interceptsBoxSums = std::vector<Sum>(columns);
+
+    for (int row = 0; row < std::min(radius, rows); row++) {
+        updateInputSums(row, 1);
+    }
+
+    // Row `row` of coefficients is produced at step `row`, row `row - radius` of the output right after.
+    for (int step = 0; step < rows + radius; step++) {
+        if (step < rows) {
+            if (step + radius < rows) {
+                updateInputSums(step + radius, 1);
+            }
+            if (step - radius - 1 >= 0) {
+                updateInputSums(step - radius - 1, -1);
+            }
+
+            boxAlongRow(guideSums, guideBoxSums);
+            boxAlongRow(channelSums, channelBoxSums);
+            boxAlongRow(guideSquaresSums, guideSquaresBoxSums);
+            boxAlongRow(productsSums, productsBoxSums);
+
+            auto slopesRow = slopes.data() + static_cast<size_t>(step % ringRows) * columns;
+            auto interceptsRow = intercepts.data() + static_cast<size_t>(step % ringRows) * columns;
+            auto windowRows = rowsInWindow(step);
+
+            for (int column = 0; column < columns; column++) {
+                auto pixelsInWindow = static_cast<Sum>(windowRows * (std::min(column + radius, columns - 1) - std::max(column - radius, 0) + 1));
+
+                auto guideMean = guideBoxSums[column] / pixelsInWindow;
+                auto channelMean = channelBoxSums[column] / pixelsInWindow;
+                auto guideVariance = guideSquaresBoxSums[column] / pixelsInWindow - guideMean * guideMean;
+                auto covariance = productsBoxSums[column] / pixelsInWindow - guideMean * channelMean;
+
+                slopesRow[column] = covariance / (guideVariance + epsilon);
+                interceptsRow[column] = channelMean - slopesRow[column] * guideMean;
+            }
+
+            updateCoefficientsSums(step, 1);
+        }
+
+        if (step - 2 * radius - 1 >= 0) {
+            updateCoefficientsSums(step - 2 * radius - 1, -1);
+        }
+
+        auto outputRow = step - radius;
+        if (outputRow < 0) {
+            continue;
+        }
+
+        boxAlongRow(slopesSums, slopesBoxSums);
+        boxAlongRow(interceptsSums, interceptsBoxSums);
+        auto windowRows = rowsInWindow(outputRow);
+
+        for (int column = 0; column < columns; column++) {
+            auto pixelsInWindow = static_cast<Sum>(windowRows * (std::min(column + radius, columns - 1) - std::max(column - radius, 0) + 1));
+            auto filteredValue = slopesBoxSums[column] / pixelsInWindow * guide->at(outputRow, column) + interceptsBoxSums[column] / pixelsInWindow;
+
+            destination[flatIndexOf(outputRow, column, rows, columns, layout)] = channel->saturated(static_cast<IEEE754_t>(filteredValue));
+        }
+    }
+
+    return filteredChannel;
+}
+
+template class GuidedFilter<float>;
+template class GuidedFilter<double>;
+template class GuidedFilter<long double>;
@@ -0,0 +1,39 @@
+#ifndef IMAGECONVOLUTIONKERNEL_GUIDEDFILTER_H
+#define IMAGECONVOLUTIONKERNEL_GUIDEDFILTER_H
+
+#include <type_traits>
+
+#include "../Channel/Channel.h"
+
+/*
+ * The guided filter of He, Sun and Tang (2010): within each (2 · radius + 1)² window, the output is modelled as a linear function
+ * a · guide + b of the guidance channel, fitted to the input by least squares with a penalty `epsilon` on a (in squared levels: windows
+ * whose guide varies much less than √epsilon get smoothed, edges stronger than that are kept). Each pixel averages the models of the windows
+ * covering it. With the input as its own guide it's an edge preserving smoother, with another channel as guide it transfers its structure,
+ * e.g. to refine a matte along the edges of the image.
+ *
+ * All the window means are box means computed with running sums, so the cost per pixel doesn't depend on the radius. The computation streams
+ * down the rows in two fused passes: the first keeps running column sums of guide, input, guide² and guide · input and produces a row of the
+ * coefficients a and b at a time, the second keeps running column sums of those and produces the output `radius` rows behind. Only
+ * 2 · radius + 2 rows of coefficients are alive at any time, no full size intermediate plane is allocated. Sums are kept in double precision
+ * (at least), as running sums accumulate roundoff along the channel.
+ *
+ * Windows are cropped at the borders and the means taken over the pixels inside, as in the reference implementation.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class GuidedFilter {
+private:
+    unsigned int radius;
+    IEEE754_t epsilon;
+
+public:
+    GuidedFilter(unsigned int radius, IEEE754_t epsilon);
+
+    [[nodiscard]] unsigned int getRadius() const;
+    [[nodiscard]] IEEE754_t getEpsilon() const;
+
+    // `guide` must have the same size as `channel`; passing `channel` itself gives the self-guided filter.
+    Channel<IEEE754_t>* filtered(const Channel<IEEE754_t>* channel, const Channel<IEEE754_t>* guide) const;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#include "Im2colConvolution.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "../Matrix/Gemm.h"
+#include "../Instrumentation/Instrumentation.h"
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Im2colConvolution<IEEE754_t>::Im2colConvolution(std::span<const ConvolutionKernel<IEEE754_t>* const> usingKernels) : kernelsCount(usingKernels.size()) {
+    assert(!usingKernels.empty());
+
+    for (auto kernel : usingKernels) {
+        assert(kernel != nullptr);
+
+        this->lowerRowOffset = std::min(this->lowerRowOffset, kernel->getLowerBoundRowIndex());
+        this->upperRowOffset = std::max(this->upperRowOffset, kernel->getUpperBoundRowIndex());
+        this->lowerColumnOffset = std::min(this->lowerColumnOffset, kernel->getLowerBoundColumnIndex());
+        this->upperColumnOffset = std::max(this->upperColumnOffset, kernel->getUpperBoundColumnIndex());
+    }
+
+    auto windowColumns = this->upperColumnOffset - this->lowerColumnOffset + 1;
+    this->weights = std::vector<IEEE754_t>(this->kernelsCount * this->getWindowSize(), 0);
+
+    for (unsigned int k = 0; k < this->kernelsCount; k++) {
+        auto kernel = usingKernels[k];
+        auto kernelWeights = this->weights.data() + k * this->getWindowSize();
+
+        for (int i = kernel->getLowerBoundRowIndex(); i <= kernel->getUpperBoundRowIndex(); i++) {
+            for (int j = kernel->getLowerBoundColumnIndex(); j <= kernel->getUpperBoundColumnIndex(); j++) {
+                kernelWeights[(i - this->lowerRowOffset) * windowColumns + (j - this->lowerColumnOffset)] = kernel->getValue(i, j);
+            }
+        }
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int Im2colConvolution<IEEE754_t>::getKernelsCount() const {
+    return this->kernelsCount;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int Im2colConvolution<IEEE754_t>::getWindowSize() const {
+    return (this->upperRowOffset - this->lowerRowOffset + 1) * (this->upperColumnOffset - this->lowerColumnOffset + 1);
+}
+
+/*
+ * One channel per kernel, in the order of the bank, with the maximum value and layout of `channel`.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+std::vector<Channel<IEEE754_t> *> Im2colConvolution<IEEE754_t>::filtered(const Channel<IEEE754_t> *channel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(channel != nullptr);
+    assert(withPaddingStrategy != nullptr);
+    INSTRUMENTATION_SCOPE("Im2colConvolution::filtered");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, channel->getRows() * channel->getColumns() * this->kernelsCount);
+
+    auto rows = channel->getRows();
+    auto columns = channel->getColumns();
+    auto layout = channel->getMatrixLayout();
+
+    auto filteredChannels = std::vector<Channel<IEEE754_t>*>();
+    for (unsigned int k = 0; k < this->kernelsCount; k++) {
+        filteredChannels.push_back(new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), rows, columns, layout));
+    }
+
+    auto windowRows = this->upperRowOffset - this->lowerRowOffset + 1;
+    auto windowColumns = this->upperColumnOffset - this->lowerColumnOffset + 1;
+    auto windowSize = this->getWindowSize();
+    auto kernelsCount = this->kernelsCount;
+    auto weights = this->weights.data();
+
+    thread_local std::vector<IEEE754_t> patches;
+    thread_local std::vector<IEEE754_t> products;
+
+    channel->forEachBlockWithHalo({0, 0, rows, columns}, this->lowerRowOffset, this->upperRowOffset, this->lowerColumnOffset, this->upperColumnOffset, withPaddingStrategy,
+        [&](const MatrixRegion& block, const IEEE754_t* values, int stride) {
+            auto blockPixels = block.rows * block.columns;
+
+            // Row (i, j) of the patches holds, for each pixel of the block, its neighbour at (i, j) in the window.
+            patches.resize(windowSize * blockPixels);
+            for (int i = 0; i < windowRows; i++) {
+                for (int j = 0; j < windowColumns; j++) {
+                    auto patchRow = patches.data() + (i * windowColumns + j) * blockPixels;
+
+                    for (unsigned int row = 0; row < block.rows; row++) {
+                        std::memcpy(patchRow + row * block.columns, values + (row + i) * stride + j, block.columns * sizeof(IEEE754_t));
+                    }
+                }
+            }
+
+            products.assign(kernelsCount * blockPixels, 0);
+            multiplyAccumulate(weights, windowSize, patches.data(), blockPixels, products.data(), blockPixels, kernelsCount, blockPixels, windowSize);
+
+            for (unsigned int k = 0; k < kernelsCount; k++) {
+                auto kernelProducts = products.data() + k * blockPixels;
+                auto destination = filteredChannels[k]->getMutableElements();
+
+                for (unsigned int row = 0; row < block.rows; row++) {
+                    for (unsigned int column = 0; column < block.columns; column++) {
+                        auto flatIndex = flatIndexOf(block.row + row, block.column + column, rows, columns, layout);
+                        destination[flatIndex] = channel->saturated(kernelProducts[row * block.columns + column]);
+                    }
+                }
+            }
+        }
+    );
+
+    return filteredChannels;
+}
+
+template class Im2colConvolution<float>;
+template class Im2colConvolution<double>;
+template class Im2colConvolution<long double>;
@@ -0,0 +1,44 @@
+#ifndef IMAGECONVOLUTIONKERNEL_IM2COLCONVOLUTION_H
+#define IMAGECONVOLUTIONKERNEL_IM2COLCONVOLUTION_H
+
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "../Channel/Channel.h"
+
+/*
+ * Kernel banks from this size up are filtered by `Im2colConvolution` rather than kernel by kernel (see `Channel::filteredBank`).
+ */
+constexpr unsigned int IM2COL_MIN_KERNELS = 4;
+
+/*
+ * Filters a channel with a bank of kernels as a matrix product.
+ *
+ * The kernels are stacked once, as the rows of a weights matrix over the window that covers all of them (smaller kernels are zero outside
+ * of their own window). The channel is then lowered tile by tile (see `Channel::forEachBlockWithHalo`): the neighbourhoods of the pixels of
+ * a tile become the columns of a patch matrix, and the weights times the patches give the filtered tile for every kernel at once, through
+ * the cache blocked, register tiled `multiplyAccumulate`. Only one tile of patches exists at a time, at most `MATRIX_TILE_SIZE`² columns.
+ *
+ * The products of each pixel are summed in the same order as `Channel::filtered`, so the results are the same.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class Im2colConvolution {
+private:
+    std::vector<IEEE754_t> weights;
+    unsigned int kernelsCount;
+    int lowerRowOffset = 0;
+    int upperRowOffset = 0;
+    int lowerColumnOffset = 0;
+    int upperColumnOffset = 0;
+
+public:
+    explicit Im2colConvolution(std::span<const ConvolutionKernel<IEEE754_t>* const> usingKernels);
+
+    [[nodiscard]] unsigned int getKernelsCount() const;
+    [[nodiscard]] unsigned int getWindowSize() const;
+
+    std::vector<Channel<IEEE754_t>*> filtered(const Channel<IEEE754_t>* channel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const;
+};
+
+#endif
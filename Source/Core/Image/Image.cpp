@@ -3,6 +3,8 @@
 #include <fstream>
 #include <errno.h>
 
+#include "../Instrumentation/Instrumentation.h"
+
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 Image<IEEE754_t>::Image(unsigned int width, unsigned int height, std::initializer_list<Channel<IEEE754_t> *> channels) : width(width), height(height) {
@@ -24,8 +26,15 @@ Image<IEEE754_t>::Image(unsigned int width, unsigned int height, std::vector<Cha
     }
 }
 
+/*
+ * An image owns its channels, they're deleted along with it.
+ */
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 Image<IEEE754_t>::~Image() {
+    for (auto channel : this->channels) {
+        delete channel;
+    }
+
     this->channels.clear();
 }
 
@@ -51,6 +60,7 @@ Channel<IEEE754_t>* Image<IEEE754_t>::getChannel(unsigned int channelIndex) cons
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 void Image<IEEE754_t>::writeToFile(const std::filesystem::path& filepath, const ImageChannelsEncoding& encoding) const {
+    INSTRUMENTATION_SCOPE("writeToFile");
     this->writeHeaderToFile(filepath, encoding);
     this->writeChannelsToFile(filepath, encoding);
 }
@@ -33,9 +33,11 @@ private:
 public:
     Image(unsigned int width, unsigned int height, std::initializer_list<Channel<IEEE754_t>*> channels);
     Image(unsigned int width, unsigned int height, std::vector<Channel<IEEE754_t>*> channels);
-    ~Image();
+    virtual ~Image();
 
     virtual Image* filtered(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const = 0;
+    virtual Image* filteredRegion(const MatrixRegion& region, const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const = 0;
+    virtual Image* refiltered(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) = 0;
 
     [[nodiscard]] unsigned int getWidth() const;
     [[nodiscard]] unsigned int getHeight() const;
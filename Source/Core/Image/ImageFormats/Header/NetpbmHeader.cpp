@@ -4,6 +4,7 @@
 #include <optional>
 
 #include "../../../Utils/FileUtils.h"
+#include "../../../Instrumentation/Instrumentation.h"
 
 NetpbmHeader::NetpbmHeader(
     ImageNetpbmFormat format,
@@ -16,6 +17,7 @@ NetpbmHeader::NetpbmHeader(
 }
 
 NetpbmHeader *NetpbmHeader::parsing(const std::filesystem::path &filePath) {
+    INSTRUMENTATION_SCOPE("parseHeader");
     std::ifstream fileHandler(filePath.string().c_str(), std::ios::binary);
 
     std::cout << filePath.string() << std::endl;
@@ -60,12 +62,11 @@ NetpbmHeader *NetpbmHeader::parsing(const std::filesystem::path &filePath) {
         return nullptr;
     }
 
+    // As per specification, a single whitespace separates the max value from the raster. Skipping more than one
+    // would swallow binary pixel values that happen to match a whitespace character.
     char nextCharacter;
-    while (fileHandler.get(nextCharacter)) {
-        if (!std::isspace(nextCharacter)) {
-            fileHandler.unget();
-            break;
-        }
+    if (fileHandler.get(nextCharacter) && !std::isspace(nextCharacter)) {
+        fileHandler.unget();
     }
 
     auto firstPixelPosition = fileHandler.tellg();
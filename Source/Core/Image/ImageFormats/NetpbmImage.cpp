@@ -1,13 +1,19 @@
 #include "NetpbmImage.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "../../Utils/FileUtils.h"
+#include "../../Scheduler/WorkStealingScheduler.h"
+#include "../../Bilateral/BilateralFilter.h"
+#include "../../Guided/GuidedFilter.h"
+#include "../../Instrumentation/Instrumentation.h"
 #include "PPM/PPMImage.h"
 #include "PGM//PGMImage.h"
 
@@ -24,6 +30,7 @@ NetpbmImage<IEEE754_t, Derived>::NetpbmImage(unsigned int width, unsigned int he
 
 template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
 NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::filtered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    INSTRUMENTATION_SCOPE("filtered");
     assert(NetpbmImage::getExpectedChannelsCount().has_value());
     assert(this->getChannelsCount() == NetpbmImage::getExpectedChannelsCount());
 
@@ -37,6 +44,188 @@ NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::filtered(const
     return new Derived(NetpbmImage::getWidth(), NetpbmImage::getHeight(), newChannels);
 }
 
+/*
+ * Filters only the pixels within `region`, e.g. a crop or a tile being re-rendered. The output is an image of the size of the region,
+ * whose pixels match the corresponding ones of `filtered`.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::filteredRegion(const MatrixRegion &region, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(this->getChannelsCount() == NetpbmImage::getExpectedChannelsCount());
+    assert(region.isWithin(this->getHeight(), this->getWidth()));
+    INSTRUMENTATION_SCOPE("filteredRegion");
+
+    auto newChannels = std::vector<Channel<IEEE754_t> *>();
+
+    for (int i = 0; i < this->getChannelsCount(); i++) {
+        newChannels.push_back(this->getChannel(i)->filteredRegion(region, usingKernel, withPaddingStrategy));
+    }
+
+    return new Derived(region.columns, region.rows, newChannels);
+}
+
+/*
+ * Filters and decimates by `stride` at once, e.g. for thumbnails: see `Channel::filterStridedInto`. The output is `stride` times smaller
+ * along both axes (rounding up).
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::filteredStrided(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, unsigned int stride) const {
+    assert(this->getChannelsCount() == NetpbmImage::getExpectedChannelsCount());
+    INSTRUMENTATION_SCOPE("filteredStrided");
+
+    auto newChannels = std::vector<Channel<IEEE754_t> *>();
+
+    for (int i = 0; i < this->getChannelsCount(); i++) {
+        newChannels.push_back(this->getChannel(i)->filteredStrided(usingKernel, withPaddingStrategy, stride));
+    }
+
+    return new Derived(Channel<IEEE754_t>::stridedSize(this->getWidth(), stride), Channel<IEEE754_t>::stridedSize(this->getHeight(), stride), newChannels);
+}
+
+/*
+ * Edge preserving smoothing of each channel, see `BilateralFilter`.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::bilateralFiltered(IEEE754_t spatialSigma, IEEE754_t rangeSigma) const {
+    assert(this->getChannelsCount() == NetpbmImage::getExpectedChannelsCount());
+    INSTRUMENTATION_SCOPE("bilateralFiltered");
+
+    auto bilateralFilter = BilateralFilter<IEEE754_t>(spatialSigma, rangeSigma);
+    auto newChannels = std::vector<Channel<IEEE754_t> *>();
+
+    for (int i = 0; i < this->getChannelsCount(); i++) {
+        newChannels.push_back(bilateralFilter.filtered(this->getChannel(i)));
+    }
+
+    return new Derived(this->getWidth(), this->getHeight(), newChannels);
+}
+
+/*
+ * Guided filtering of each channel, see `GuidedFilter`. The guide is either an image with as many channels, each guiding the channel at the same
+ * index, or a single channel image (e.g. the luminance) guiding all of them; `nullptr` makes each channel its own guide.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::guidedFiltered(const Image<IEEE754_t> *guide, unsigned int radius, IEEE754_t epsilon) const {
+    assert(this->getChannelsCount() == NetpbmImage::getExpectedChannelsCount());
+    assert(guide == nullptr || guide->getChannelsCount() == 1 || guide->getChannelsCount() == this->getChannelsCount());
+    INSTRUMENTATION_SCOPE("guidedFiltered");
+
+    auto guidedFilter = GuidedFilter<IEEE754_t>(radius, epsilon);
+    auto newChannels = std::vector<Channel<IEEE754_t> *>();
+
+    for (int i = 0; i < this->getChannelsCount(); i++) {
+        auto guideChannel = guide == nullptr ? this->getChannel(i) : guide->getChannel(guide->getChannelsCount() == 1 ? 0 : i);
+        newChannels.push_back(guidedFilter.filtered(this->getChannel(i), guideChannel));
+    }
+
+    return new Derived(this->getWidth(), this->getHeight(), newChannels);
+}
+
+/*
+ * Same as `filtered`, but the output goes to `destination`, an image of the same size and layout (e.g. one from `ImagePool`), see
+ * `Channel::filteredInto`.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+void NetpbmImage<IEEE754_t, Derived>::filteredInto(NetpbmImage *destination, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(destination != nullptr && destination->getChannelsCount() == this->getChannelsCount());
+    INSTRUMENTATION_SCOPE("filteredInto");
+
+    for (int i = 0; i < this->getChannelsCount(); i++) {
+        this->getChannel(i)->filteredInto(destination->getChannel(i), usingKernel, withPaddingStrategy);
+    }
+}
+
+/*
+ * Same as `filtered`, but each channel only filters again the pixels edited since the previous call with the same kernel and padding
+ * strategy (see `Channel::refiltered`). The channels of the returned image are copies, so it can outlive the next edits of this image.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::refiltered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) {
+    assert(this->getChannelsCount() == NetpbmImage::getExpectedChannelsCount());
+    INSTRUMENTATION_SCOPE("refiltered");
+
+    auto newChannels = std::vector<Channel<IEEE754_t> *>();
+
+    for (int i = 0; i < this->getChannelsCount(); i++) {
+        auto refilteredChannel = this->getChannel(i)->refiltered(usingKernel, withPaddingStrategy);
+        newChannels.push_back(new Channel<IEEE754_t>(refilteredChannel->getMaxTheoreticalValue(), refilteredChannel));
+    }
+
+    return new Derived(this->getWidth(), this->getHeight(), newChannels);
+}
+
+/*
+ * Filters every channel of every image in `images` on the workers of `scheduler`. Each (image, channel, band of `tileRows` rows)
+ * triple is a separate task, so that a batch mixing small and large images still keeps every worker busy; small tiles balance
+ * better, large tiles have less overhead. The scheduler statistics can be used to tune `tileRows`.
+ *
+ * The output has the same order as `images`, and each filtered image matches the one returned by `filtered`.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+std::vector<NetpbmImage<IEEE754_t, Derived> *> NetpbmImage<IEEE754_t, Derived>::filteredBatch(
+    const std::vector<const NetpbmImage *> &images,
+    const ConvolutionKernel<IEEE754_t> *usingKernel,
+    const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy,
+    WorkStealingScheduler &scheduler,
+    unsigned int tileRows
+) {
+    assert(tileRows > 0);
+    INSTRUMENTATION_SCOPE("filteredBatch");
+
+    // Every buffer is allocated before the first task is submitted, so that an allocation failure can't free the buffer of a running task;
+    // the buffers are owned here, so that they're freed when `wait` rethrows the exception of a task.
+    auto filteredElements = std::vector<std::vector<std::unique_ptr<IEEE754_t[]>>>();
+
+    for (auto image : images) {
+        assert(image != nullptr);
+        assert(image->getChannelsCount() == NetpbmImage::getExpectedChannelsCount());
+
+        filteredElements.emplace_back();
+        for (unsigned int k = 0; k < image->getChannelsCount(); k++) {
+            auto channel = image->getChannel(k);
+            filteredElements.back().push_back(std::make_unique_for_overwrite<IEEE754_t[]>(static_cast<size_t>(channel->getRows()) * channel->getColumns()));
+        }
+    }
+
+    for (size_t i = 0; i < images.size(); i++) {
+        for (unsigned int k = 0; k < images[i]->getChannelsCount(); k++) {
+            auto channel = images[i]->getChannel(k);
+            auto destination = filteredElements[i][k].get();
+
+            for (unsigned int firstRow = 0; firstRow < channel->getRows(); firstRow += tileRows) {
+                auto lastRow = std::min(firstRow + tileRows, channel->getRows());
+
+                scheduler.submit([=] {
+                    channel->filterRowsInto(destination, firstRow, lastRow, usingKernel, withPaddingStrategy);
+                });
+            }
+        }
+    }
+
+    scheduler.wait();
+
+    auto filteredImages = std::vector<NetpbmImage*>();
+    for (size_t i = 0; i < images.size(); i++) {
+        auto newChannels = std::vector<Channel<IEEE754_t> *>();
+
+        for (unsigned int k = 0; k < images[i]->getChannelsCount(); k++) {
+            auto channel = images[i]->getChannel(k);
+            newChannels.push_back(new Channel<IEEE754_t>(
+                channel->getMaxTheoreticalValue(),
+                filteredElements[i][k].get(),
+                channel->getRows(),
+                channel->getColumns(),
+                channel->getMatrixLayout()
+            ));
+
+            filteredElements[i][k].reset();
+        }
+
+        filteredImages.push_back(new Derived(images[i]->getWidth(), images[i]->getHeight(), newChannels));
+    }
+
+    return filteredImages;
+}
+
 template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
 void NetpbmImage<IEEE754_t, Derived>::writeHeaderToFile(const std::filesystem::path& filepath, const ImageChannelsEncoding& encoding) const {
     assert(this->getExpectedChannelsCount().has_value());
@@ -44,6 +233,7 @@ void NetpbmImage<IEEE754_t, Derived>::writeHeaderToFile(const std::filesystem::p
     assert(this->getFileExtension().has_value());
     assert(this->getMaxChannelValue().has_value() || this->header.has_value());
     assert(this->getChannelsCount() == NetpbmImage::getExpectedChannelsCount());
+    INSTRUMENTATION_SCOPE("encodeHeader");
 
     std::ofstream fileHandle;
 
@@ -63,6 +253,7 @@ void NetpbmImage<IEEE754_t, Derived>::writeHeaderToFile(const std::filesystem::p
         fileHandle << std::to_string(NetpbmImage::getMaxChannelValue().value()) << std::endl;
     }
 
+    INSTRUMENTATION_COUNT(BYTES_WRITTEN, static_cast<unsigned long long>(fileHandle.tellp()));
     fileHandle.close();
 }
 
@@ -74,8 +265,10 @@ void NetpbmImage<IEEE754_t, Derived>::writeChannelsToFile(const std::filesystem:
     assert(this->getFileExtension().has_value());
     assert(this->getMaxChannelValue().has_value() || this->header.has_value());
     assert(this->getChannelsCount() == NetpbmImage::getExpectedChannelsCount());
+    INSTRUMENTATION_SCOPE("encodeRaster");
 
     std::ofstream fileHandle;
+    unsigned long long writtenBytes = 0;
 
     fileHandle.open((filepath.string() + "." + NetpbmImage::getFileExtension().value()).c_str(),
         encoding == ImageChannelsEncoding::PLAIN ? std::ios::app : std::ios::app | std::ios::binary);
@@ -89,10 +282,6 @@ void NetpbmImage<IEEE754_t, Derived>::writeChannelsToFile(const std::filesystem:
             for (auto k = 0; k < this->getChannelsCount(); k++) {
 
                 auto currentChannel = this->getChannel(k);
-                if (currentChannel->getMatrixLayout() == COLUMN_MAJOR) {
-                    currentChannel = currentChannel->transposedChannel();
-                }
-
                 int currentPixelValue = static_cast<int>(currentChannel->at(i, j));
 
                 if (this->header.has_value()) {
@@ -102,21 +291,26 @@ void NetpbmImage<IEEE754_t, Derived>::writeChannelsToFile(const std::filesystem:
                 }
 
                 if (encoding == ImageChannelsEncoding::PLAIN) {
-                    fileHandle << std::to_string(currentPixelValue) << " ";
+                    auto plainValue = std::to_string(currentPixelValue);
+                    fileHandle << plainValue << " ";
+                    writtenBytes += plainValue.size() + 1;
                 } else {
                     if (NetpbmImage::getMaxChannelValue().value() < 256) {
                         auto byte = static_cast<uint8_t>(currentPixelValue);
                         fileHandle.write(reinterpret_cast<const char*>(&byte), 1);
+                        writtenBytes += 1;
                     } else {
                         auto word = static_cast<uint16_t>(currentPixelValue);
                         uint8_t bytes[2] = {static_cast<uint8_t>(word >> 8), static_cast<uint8_t>(word & 0xFF)};
                         fileHandle.write(reinterpret_cast<const char*>(bytes), 2);
+                        writtenBytes += 2;
                     }
                 }
             }
         }
     }
 
+    INSTRUMENTATION_COUNT(BYTES_WRITTEN, writtenBytes);
     fileHandle.close();
 }
 
@@ -124,9 +318,21 @@ void NetpbmImage<IEEE754_t, Derived>::writeChannelsToFile(const std::filesystem:
 
 
 
+/*
+ * Makes an image of the `Derived` format out of already computed channels, for the stages that build images outside of this class.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::withChannels(unsigned int width, unsigned int height, std::vector<Channel<IEEE754_t> *> channels) {
+    assert(channels.size() == NetpbmImage::getExpectedChannelsCount());
+    return new Derived(width, height, std::move(channels));
+}
+
+
 template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
-NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::loadImage(const std::filesystem::path &filepath) {
+NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::loadImage(const std::filesystem::path &filepath, MatrixLayout layout) {
     assert(NetpbmImage::getExpectedChannelsCount().has_value());
+    INSTRUMENTATION_SCOPE("loadImage");
+
     auto parsedHeader = NetpbmHeader::parsing(filepath);
 
     if (!parsedHeader) {
@@ -136,14 +342,22 @@ NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::loadImage(cons
     std::ifstream fileHandle(filepath.string(), std::ios::binary);
     fileHandle.seekg(parsedHeader->getPositionOfFirstPixel());
 
+    // Pixels are decoded straight to their position in `layout`, so that no conversion pass is needed afterwards.
+    auto rows = parsedHeader->getRows();
+    auto columns = parsedHeader->getColumns();
+    auto channelsCount = NetpbmImage::getExpectedChannelsCount().value();
+
     auto channels = std::vector<std::vector<IEEE754_t>>();
-    for (auto i = 0; i < NetpbmImage::getExpectedChannelsCount(); i++) {
-        channels.push_back(std::vector<IEEE754_t>());
+    for (auto i = 0; i < channelsCount; i++) {
+        channels.push_back(std::vector<IEEE754_t>(rows * columns));
     }
 
     auto inputPixelValueCount = 0;
     auto pixelsPerValue = static_cast<unsigned int>(ceil(log2(static_cast<float>(parsedHeader->getMaxPixelValue() + 1)) / 8));
 
+    INSTRUMENTATION_COUNT(BYTES_READ, std::filesystem::file_size(filepath));
+    INSTRUMENTATION_SCOPE("decodeRaster");
+
     while (true) {
         std::optional<std::string> nextValue;
 
@@ -157,7 +371,13 @@ NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::loadImage(cons
             auto pixelValue = static_cast<IEEE754_t>(std::stol(nextValue.value()));
             assert(pixelValue >= 0 && pixelValue <= parsedHeader->getMaxPixelValue());
 
-            channels[inputPixelValueCount % NetpbmImage::getExpectedChannelsCount().value()].push_back(pixelValue);
+            auto pixelIndex = inputPixelValueCount / channelsCount;
+            if (pixelIndex >= rows * columns) {
+                inputPixelValueCount++;
+                break;
+            }
+
+            channels[inputPixelValueCount % channelsCount][flatIndexOf(pixelIndex / columns, pixelIndex % columns, rows, columns, layout)] = pixelValue;
             inputPixelValueCount++;
         } else {
             break;
@@ -170,12 +390,13 @@ NetpbmImage<IEEE754_t, Derived> *NetpbmImage<IEEE754_t, Derived>::loadImage(cons
 
     auto outputChannels = std::vector<Channel<IEEE754_t>*>();
     std::ranges::transform(channels, std::back_inserter(outputChannels),
-    [parsedHeader](std::vector<IEEE754_t>& channelValues) {  // Pass by REFERENCE
+    [parsedHeader, layout](std::vector<IEEE754_t>& channelValues) {  // Pass by REFERENCE
         return new Channel<IEEE754_t>(
             parsedHeader->getMaxPixelValue(),
             channelValues.data(),
             parsedHeader->getRows(),
-            parsedHeader->getColumns()
+            parsedHeader->getColumns(),
+            layout
         );
     });
 
@@ -8,6 +8,8 @@
 #include "../Image.h"
 #include "../ImageFormats/Header/NetpbmHeader.h"
 
+class WorkStealingScheduler;
+
 template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
 class NetpbmImage: public Image<IEEE754_t> {
 private:
@@ -24,10 +26,24 @@ public:
     NetpbmImage(unsigned int width, unsigned int height, std::vector<Channel<IEEE754_t>*> channels, std::optional<NetpbmHeader*> header = std::nullopt);
 
     NetpbmImage* filtered(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const override;
+    NetpbmImage* filteredRegion(const MatrixRegion& region, const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const override;
+    NetpbmImage* filteredStrided(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy, unsigned int stride) const;
+    NetpbmImage* bilateralFiltered(IEEE754_t spatialSigma, IEEE754_t rangeSigma) const;
+    NetpbmImage* guidedFiltered(const Image<IEEE754_t>* guide, unsigned int radius, IEEE754_t epsilon) const;
+    NetpbmImage* refiltered(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) override;
+    void filteredInto(NetpbmImage* destination, const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const;
     void writeHeaderToFile(const std::filesystem::path& filepath, const ImageChannelsEncoding& encoding) const override;
     void writeChannelsToFile(const std::filesystem::path& filepath, const ImageChannelsEncoding& encoding) const override;
 
-    static NetpbmImage* loadImage(const std::filesystem::path& filepath);
+    static NetpbmImage* withChannels(unsigned int width, unsigned int height, std::vector<Channel<IEEE754_t>*> channels);
+    static NetpbmImage* loadImage(const std::filesystem::path& filepath, MatrixLayout layout = ROW_MAJOR);
+    static std::vector<NetpbmImage*> filteredBatch(
+        const std::vector<const NetpbmImage*>& images,
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        WorkStealingScheduler& scheduler,
+        unsigned int tileRows = 32
+    );
 };
 
 
@@ -2,6 +2,7 @@
 #include <cassert>
 #include <fstream>
 #include "../../Image.h"
+#include "../../../Instrumentation/Instrumentation.h"
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 PGMImage<IEEE754_t>::PGMImage(unsigned int width, unsigned int height, Channel<IEEE754_t> *G, std::optional<NetpbmHeader *> header) : header(header), NetpbmImage<IEEE754_t, PGMImage>(width, height, {G}) {
@@ -36,6 +37,7 @@ template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 PGMImage<IEEE754_t> *PGMImage<IEEE754_t>::filtered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    INSTRUMENTATION_SCOPE("filtered");
     assert(PGMImage::getExpectedChannelsCount().has_value());
     assert(this->getChannelsCount() == PGMImage::getExpectedChannelsCount());
 
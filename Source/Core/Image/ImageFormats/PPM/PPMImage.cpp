@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "../../../Utils/FileUtils.h"
+#include "../../../Instrumentation/Instrumentation.h"
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 PPMImage<IEEE754_t>::PPMImage(unsigned int width, unsigned int height, Channel<IEEE754_t> *R, Channel<IEEE754_t> *G, Channel<IEEE754_t> *B, std::optional<NetpbmHeader*> header) : NetpbmImage<IEEE754_t, PPMImage>(
@@ -48,6 +49,7 @@ template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 PPMImage<IEEE754_t> *PPMImage<IEEE754_t>::filtered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    INSTRUMENTATION_SCOPE("filtered");
     assert(PPMImage::getExpectedChannelsCount().has_value());
     assert(this->getChannelsCount() == PPMImage::getExpectedChannelsCount());
 
@@ -61,6 +63,21 @@ PPMImage<IEEE754_t> *PPMImage<IEEE754_t>::filtered(const ConvolutionKernel<IEEE7
     return new PPMImage(PPMImage::getWidth(), PPMImage::getHeight(), newChannels);
 }
 
+/*
+ * Filters the luma only, or the chroma too at half resolution, see `LumaChromaFilter`: for sharpening and denoising, about a third of the
+ * cost of `filtered`, which filters the three RGB channels.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+PPMImage<IEEE754_t> *PPMImage<IEEE754_t>::lumaFiltered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, ChromaFiltering chromaFiltering) const {
+    INSTRUMENTATION_SCOPE("lumaFiltered");
+    assert(this->getChannelsCount() == PPMImage::getExpectedChannelsCount());
+
+    auto lumaChromaFilter = LumaChromaFilter<IEEE754_t>(usingKernel, withPaddingStrategy, chromaFiltering);
+    auto newChannels = lumaChromaFilter.filtered(this->getChannel(0), this->getChannel(1), this->getChannel(2));
+
+    return new PPMImage(PPMImage::getWidth(), PPMImage::getHeight(), newChannels);
+}
+
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 [[nodiscard]] std::optional<std::string> PPMImage<IEEE754_t>::getFileExtension() {
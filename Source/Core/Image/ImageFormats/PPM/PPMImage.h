@@ -8,6 +8,7 @@
 #include "../../Image.h"
 #include "../Header/NetpbmHeader.h"
 #include "../NetpbmImage.h"
+#include "../../../Color/LumaChromaFilter.h"
 
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 class PPMImage : public NetpbmImage<IEEE754_t, PPMImage<IEEE754_t>> {
@@ -21,6 +22,11 @@ protected:
 public:
     PPMImage(unsigned int width, unsigned int height, Channel<IEEE754_t>* R, Channel<IEEE754_t>* G, Channel<IEEE754_t>* B, std::optional<NetpbmHeader*> header = std::nullopt);
     PPMImage* filtered(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const override;
+    PPMImage* lumaFiltered(
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        ChromaFiltering chromaFiltering = ChromaFiltering::UNFILTERED
+    ) const;
 
 protected:
     PPMImage(unsigned int width, unsigned int height, std::vector<Channel<IEEE754_t>*> channels, std::optional<NetpbmHeader*> header = std::nullopt);
@@ -0,0 +1,205 @@
+#include "QOICodec.h"
+
+#include <cstring>
+
+namespace {
+    constexpr uint8_t QOI_OP_INDEX = 0x00;
+    constexpr uint8_t QOI_OP_DIFF = 0x40;
+    constexpr uint8_t QOI_OP_LUMA = 0x80;
+    constexpr uint8_t QOI_OP_RUN = 0xc0;
+    constexpr uint8_t QOI_OP_RGB = 0xfe;
+    constexpr uint8_t QOI_OP_RGBA = 0xff;
+    constexpr uint8_t QOI_MASK = 0xc0;
+
+    constexpr unsigned int QOI_MAX_RUN = 62;
+    constexpr uint8_t QOI_MAGIC[4] = {'q', 'o', 'i', 'f'};
+    constexpr uint8_t QOI_END_MARKER[QOI_END_MARKER_SIZE] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+    // Images of more pixels than this are rejected when loading, as in the reference implementation.
+    constexpr unsigned long long QOI_MAX_PIXELS = 400000000ull;
+
+    inline unsigned int hashOf(const uint8_t* pixel) {
+        return (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64;
+    }
+
+    void writeBigEndian(std::ostream& output, uint32_t value) {
+        uint8_t bytes[4] = {static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)};
+        output.write(reinterpret_cast<const char*>(bytes), 4);
+    }
+
+    uint32_t readBigEndian(const uint8_t* bytes) {
+        return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 | static_cast<uint32_t>(bytes[2]) << 8 | bytes[3];
+    }
+}
+
+void QOIHeader::writeTo(std::ostream &output) const {
+    output.write(reinterpret_cast<const char*>(QOI_MAGIC), 4);
+    writeBigEndian(output, this->width);
+    writeBigEndian(output, this->height);
+    output.put(static_cast<char>(this->channelsCount));
+    output.put(static_cast<char>(this->colorspace));
+}
+
+/*
+ * nullopt if `data` doesn't start with a valid header, or is too short to hold the pixels it announces even if they were all encoded as
+ * runs of `QOI_MAX_RUN` pixels per byte, so that a tiny file can't make the loader allocate a huge image.
+ */
+std::optional<QOIHeader> QOIHeader::parsing(const uint8_t *data, size_t size) {
+    if (size < QOI_HEADER_SIZE + QOI_END_MARKER_SIZE || std::memcmp(data, QOI_MAGIC, 4) != 0) {
+        return std::nullopt;
+    }
+
+    auto header = QOIHeader{readBigEndian(data + 4), readBigEndian(data + 8), data[12], data[13]};
+    auto pixelsCount = static_cast<unsigned long long>(header.width) * header.height;
+
+    auto chunksSize = size - QOI_HEADER_SIZE - QOI_END_MARKER_SIZE;
+
+    if (header.width == 0 || header.height == 0 || pixelsCount > QOI_MAX_PIXELS || pixelsCount > QOI_MAX_RUN * static_cast<unsigned long long>(chunksSize)) {
+        return std::nullopt;
+    }
+
+    if ((header.channelsCount != 3 && header.channelsCount != 4) || header.colorspace > 1) {
+        return std::nullopt;
+    }
+
+    return header;
+}
+
+QOIEncoder::QOIEncoder(std::ostream &output) : output(output) {
+
+}
+
+void QOIEncoder::flushRun() {
+    if (this->run > 0) {
+        this->chunks.push_back(QOI_OP_RUN | (this->run - 1));
+        this->run = 0;
+    }
+}
+
+/*
+ * `pixels` holds `pixelsCount` interleaved RGB pixels. They're encoded in a buffer first, so that the stream sees a single write per call.
+ */
+void QOIEncoder::encode(const uint8_t *pixels, size_t pixelsCount) {
+    // An RGB chunk, the largest, takes 4 bytes.
+    this->chunks.clear();
+    this->chunks.reserve(pixelsCount * 4 + 1);
+
+    for (size_t i = 0; i < pixelsCount; i++) {
+        uint8_t pixel[4] = {pixels[3 * i], pixels[3 * i + 1], pixels[3 * i + 2], 255};
+
+        if (std::memcmp(pixel, this->previous, 4) == 0) {
+            this->run++;
+
+            if (this->run == QOI_MAX_RUN) {
+                this->flushRun();
+            }
+
+            continue;
+        }
+
+        this->flushRun();
+
+        auto hash = hashOf(pixel);
+        if (std::memcmp(this->index[hash], pixel, 4) == 0) {
+            this->chunks.push_back(QOI_OP_INDEX | hash);
+        } else {
+            std::memcpy(this->index[hash], pixel, 4);
+
+            auto redDifference = static_cast<int8_t>(pixel[0] - this->previous[0]);
+            auto greenDifference = static_cast<int8_t>(pixel[1] - this->previous[1]);
+            auto blueDifference = static_cast<int8_t>(pixel[2] - this->previous[2]);
+            auto redGreenDifference = redDifference - greenDifference;
+            auto blueGreenDifference = blueDifference - greenDifference;
+
+            if (redDifference >= -2 && redDifference <= 1 && greenDifference >= -2 && greenDifference <= 1 && blueDifference >= -2 && blueDifference <= 1) {
+                this->chunks.push_back(QOI_OP_DIFF | (redDifference + 2) << 4 | (greenDifference + 2) << 2 | (blueDifference + 2));
+            } else if (greenDifference >= -32 && greenDifference <= 31 && redGreenDifference >= -8 && redGreenDifference <= 7 && blueGreenDifference >= -8 && blueGreenDifference <= 7) {
+                this->chunks.push_back(QOI_OP_LUMA | (greenDifference + 32));
+                this->chunks.push_back((redGreenDifference + 8) << 4 | (blueGreenDifference + 8));
+            } else {
+                this->chunks.insert(this->chunks.end(), {QOI_OP_RGB, pixel[0], pixel[1], pixel[2]});
+            }
+        }
+
+        std::memcpy(this->previous, pixel, 4);
+    }
+
+    this->output.write(reinterpret_cast<const char*>(this->chunks.data()), static_cast<std::streamsize>(this->chunks.size()));
+    this->writtenBytes += this->chunks.size();
+}
+
+/*
+ * Writes the pending run and the end marker. False if the stream failed at any point.
+ */
+bool QOIEncoder::finish() {
+    this->chunks.clear();
+    this->flushRun();
+    this->chunks.insert(this->chunks.end(), std::begin(QOI_END_MARKER), std::end(QOI_END_MARKER));
+
+    this->output.write(reinterpret_cast<const char*>(this->chunks.data()), static_cast<std::streamsize>(this->chunks.size()));
+    this->writtenBytes += this->chunks.size();
+    this->output.flush();
+
+    return this->output.good();
+}
+
+unsigned long long QOIEncoder::getWrittenBytes() const {
+    return this->writtenBytes;
+}
+
+/*
+ * `data` is the whole file, header included, which must have been validated by `QOIHeader::parsing`.
+ */
+QOIDecoder::QOIDecoder(const uint8_t *data, size_t size) : data(data), size(size) {
+
+}
+
+/*
+ * Stores the next pixel in `rgb`. False if the chunks ran out before it, i.e. the file is truncated.
+ */
+bool QOIDecoder::next(uint8_t *rgb) {
+    if (this->run > 0) {
+        this->run--;
+    } else {
+        auto chunksEnd = this->size - QOI_END_MARKER_SIZE;
+        if (this->position >= chunksEnd) {
+            return false;
+        }
+
+        auto tag = this->data[this->position++];
+
+        if (tag == QOI_OP_RGB || tag == QOI_OP_RGBA) {
+            auto componentsCount = tag == QOI_OP_RGB ? 3u : 4u;
+            if (this->position + componentsCount > chunksEnd) {
+                return false;
+            }
+
+            std::memcpy(this->pixel, this->data + this->position, componentsCount);
+            this->position += componentsCount;
+        } else if ((tag & QOI_MASK) == QOI_OP_INDEX) {
+            std::memcpy(this->pixel, this->index[tag], 4);
+        } else if ((tag & QOI_MASK) == QOI_OP_DIFF) {
+            this->pixel[0] += ((tag >> 4) & 0x03) - 2;
+            this->pixel[1] += ((tag >> 2) & 0x03) - 2;
+            this->pixel[2] += (tag & 0x03) - 2;
+        } else if ((tag & QOI_MASK) == QOI_OP_LUMA) {
+            if (this->position >= chunksEnd) {
+                return false;
+            }
+
+            auto differences = this->data[this->position++];
+            auto greenDifference = (tag & 0x3f) - 32;
+
+            this->pixel[0] += greenDifference - 8 + ((differences >> 4) & 0x0f);
+            this->pixel[1] += greenDifference;
+            this->pixel[2] += greenDifference - 8 + (differences & 0x0f);
+        } else {
+            this->run = tag & 0x3f;
+        }
+
+        std::memcpy(this->index[hashOf(this->pixel)], this->pixel, 4);
+    }
+
+    std::memcpy(rgb, this->pixel, 3);
+    return true;
+}
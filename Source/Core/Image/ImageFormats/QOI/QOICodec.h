@@ -0,0 +1,69 @@
+#ifndef IMAGECONVOLUTIONKERNEL_QOICODEC_H
+#define IMAGECONVOLUTIONKERNEL_QOICODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+constexpr size_t QOI_HEADER_SIZE = 14;
+constexpr size_t QOI_END_MARKER_SIZE = 8;
+
+struct QOIHeader {
+    uint32_t width;
+    uint32_t height;
+    uint8_t channelsCount;
+    uint8_t colorspace;
+
+    void writeTo(std::ostream& output) const;
+    static std::optional<QOIHeader> parsing(const uint8_t* data, size_t size);
+};
+
+/*
+ * Encodes 8 bit RGB pixels in the "Quite OK Image" format (https://qoiformat.org/qoi-specification.pdf): each pixel becomes a run of the
+ * previous one, a reference into a hash table of the 64 last seen pixels, a small difference from the previous pixel, or the pixel itself.
+ * It is lossless, needs a single pass and no entropy coder, and smooth content (e.g. blurred images) shrinks well below its raw size.
+ *
+ * Pixels are fed in raster order, in as many calls of `encode` as wanted (e.g. a band of rows at a time, as they're filtered): the state
+ * carries over from one call to the next, so the output doesn't depend on how the pixels were split. `finish` terminates the stream.
+ */
+class QOIEncoder {
+private:
+    std::ostream& output;
+    std::vector<uint8_t> chunks;
+    uint8_t index[64][4] = {};
+    uint8_t previous[4] = {0, 0, 0, 255};
+    unsigned int run = 0;
+    unsigned long long writtenBytes = 0;
+
+    void flushRun();
+
+public:
+    explicit QOIEncoder(std::ostream& output);
+
+    void encode(const uint8_t* pixels, size_t pixelsCount);
+    bool finish();
+
+    [[nodiscard]] unsigned long long getWrittenBytes() const;
+};
+
+/*
+ * Decodes the pixels following a QOI header, one at a time in raster order. RGBA chunks are accepted, their alpha is dropped.
+ */
+class QOIDecoder {
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position = QOI_HEADER_SIZE;
+    uint8_t index[64][4] = {};
+    uint8_t pixel[4] = {0, 0, 0, 255};
+    unsigned int run = 0;
+
+public:
+    QOIDecoder(const uint8_t* data, size_t size);
+
+    bool next(uint8_t* rgb);
+};
+
+#endif
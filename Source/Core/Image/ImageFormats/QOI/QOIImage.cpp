@@ -0,0 +1,271 @@
+#include "QOIImage.h"
+
+#include <cassert>
+#include <fstream>
+#include <stdexcept>
+
+#include "../../../Instrumentation/Instrumentation.h"
+
+namespace {
+    std::filesystem::path qoiPathOf(const std::filesystem::path& filepath) {
+        return filepath.string() + ".qoi";
+    }
+
+    /*
+     * Appends the rows [firstRow, firstRow + rowsCount[ of `channels` to `pixels` as interleaved 8 bit RGB pixels. `rowOffset` is the row
+     * of `channels` holding image row `firstRow`, for channels that only hold a band of the image. A single channel is repeated as gray.
+     */
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    void appendPixels(const std::vector<const Channel<IEEE754_t>*>& channels, unsigned int firstRow, unsigned int rowsCount, unsigned int rowOffset, std::vector<uint8_t>& pixels) {
+        auto columns = channels[0]->getColumns();
+
+        for (unsigned int row = firstRow; row < firstRow + rowsCount; row++) {
+            for (unsigned int column = 0; column < columns; column++) {
+                for (unsigned int k = 0; k < 3; k++) {
+                    auto channel = channels[channels.size() == 1 ? 0 : k];
+                    auto value = static_cast<int>(channel->at(row - rowOffset, column));
+
+                    assert(value >= 0 && value <= 255);
+                    pixels.push_back(static_cast<uint8_t>(value));
+                }
+            }
+        }
+    }
+
+    /*
+     * QOI only stores 8 bit samples: writing the channels of a 16 bit image would silently truncate them, in a format meant to be lossless.
+     */
+    template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    void requireEightBitSamples(const Image<IEEE754_t>* image) {
+        for (unsigned int k = 0; k < image->getChannelsCount(); k++) {
+            if (image->getChannel(k)->getMaxTheoreticalValue() > 255) {
+                throw std::invalid_argument("QOI images only hold samples up to 255");
+            }
+        }
+    }
+
+    std::ofstream openedForWriting(const std::filesystem::path& filepath, std::ios::openmode mode) {
+        auto fileHandle = std::ofstream(qoiPathOf(filepath), mode | std::ios::binary);
+
+        if (fileHandle.fail()) {
+            throw std::runtime_error("Could not open the specified file");
+        }
+
+        return fileHandle;
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+QOIImage<IEEE754_t>::QOIImage(unsigned int width, unsigned int height, std::vector<Channel<IEEE754_t> *> channels) : Image<IEEE754_t>(width, height, std::move(channels)) {
+    assert(this->getChannelsCount() == 3 && "QOIImage must have exactly 3 channels (R, G, B)");
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+QOIImage<IEEE754_t> *QOIImage<IEEE754_t>::filtered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    INSTRUMENTATION_SCOPE("filtered");
+
+    auto newChannels = std::vector<Channel<IEEE754_t> *>();
+    for (unsigned int i = 0; i < this->getChannelsCount(); i++) {
+        newChannels.push_back(this->getChannel(i)->filtered(usingKernel, withPaddingStrategy));
+    }
+
+    return new QOIImage(this->getWidth(), this->getHeight(), newChannels);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+QOIImage<IEEE754_t> *QOIImage<IEEE754_t>::filteredRegion(const MatrixRegion &region, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(region.isWithin(this->getHeight(), this->getWidth()));
+    INSTRUMENTATION_SCOPE("filteredRegion");
+
+    auto newChannels = std::vector<Channel<IEEE754_t> *>();
+    for (unsigned int i = 0; i < this->getChannelsCount(); i++) {
+        newChannels.push_back(this->getChannel(i)->filteredRegion(region, usingKernel, withPaddingStrategy));
+    }
+
+    return new QOIImage(region.columns, region.rows, newChannels);
+}
+
+/*
+ * See `NetpbmImage::refiltered`.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+QOIImage<IEEE754_t> *QOIImage<IEEE754_t>::refiltered(const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) {
+    INSTRUMENTATION_SCOPE("refiltered");
+
+    auto newChannels = std::vector<Channel<IEEE754_t> *>();
+    for (unsigned int i = 0; i < this->getChannelsCount(); i++) {
+        auto refilteredChannel = this->getChannel(i)->refiltered(usingKernel, withPaddingStrategy);
+        newChannels.push_back(new Channel<IEEE754_t>(refilteredChannel->getMaxTheoreticalValue(), refilteredChannel));
+    }
+
+    return new QOIImage(this->getWidth(), this->getHeight(), newChannels);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void QOIImage<IEEE754_t>::writeHeaderToFile(const std::filesystem::path &filepath, const ImageChannelsEncoding &) const {
+    INSTRUMENTATION_SCOPE("encodeHeader");
+    requireEightBitSamples(this);
+
+    auto fileHandle = openedForWriting(filepath, std::ios::trunc);
+    QOIHeader{this->getWidth(), this->getHeight(), 3, 0}.writeTo(fileHandle);
+
+    INSTRUMENTATION_COUNT(BYTES_WRITTEN, QOI_HEADER_SIZE);
+}
+
+/*
+ * The pixels are converted and encoded `QOI_BAND_ROWS` rows at a time, so that the 8 bit copy never holds more than a band.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void QOIImage<IEEE754_t>::writeChannelsToFile(const std::filesystem::path &filepath, const ImageChannelsEncoding &) const {
+    INSTRUMENTATION_SCOPE("encodeRaster");
+
+    auto fileHandle = openedForWriting(filepath, std::ios::app);
+    auto encoder = QOIEncoder(fileHandle);
+    auto channels = std::vector<const Channel<IEEE754_t>*>();
+    auto pixels = std::vector<uint8_t>();
+
+    for (unsigned int i = 0; i < this->getChannelsCount(); i++) {
+        channels.push_back(this->getChannel(i));
+    }
+
+    for (unsigned int firstRow = 0; firstRow < this->getHeight(); firstRow += QOI_BAND_ROWS) {
+        auto rowsCount = std::min(QOI_BAND_ROWS, this->getHeight() - firstRow);
+
+        pixels.clear();
+        appendPixels(channels, firstRow, rowsCount, 0, pixels);
+        encoder.encode(pixels.data(), pixels.size() / 3);
+    }
+
+    auto isWritten = encoder.finish();
+    INSTRUMENTATION_COUNT(BYTES_WRITTEN, encoder.getWrittenBytes());
+
+    if (!isWritten) {
+        throw std::runtime_error("Could not write the specified file");
+    }
+}
+
+/*
+ * A QOI image with copies of the channels of `image`, which must have one (gray) or three (RGB) channels. Throws `std::invalid_argument`
+ * if the samples of `image` may exceed 255.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+QOIImage<IEEE754_t> *QOIImage<IEEE754_t>::fromImage(const Image<IEEE754_t> *image) {
+    assert(image != nullptr);
+    assert(image->getChannelsCount() == 1 || image->getChannelsCount() == 3);
+    requireEightBitSamples(image);
+
+    auto channels = std::vector<Channel<IEEE754_t> *>();
+    for (unsigned int k = 0; k < 3; k++) {
+        auto channel = image->getChannel(image->getChannelsCount() == 1 ? 0 : k);
+        channels.push_back(new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), channel));
+    }
+
+    return new QOIImage(image->getWidth(), image->getHeight(), channels);
+}
+
+/*
+ * The whole file is read at once and decoded in a single pass, straight to the position of each pixel in `layout`. nullptr if the file
+ * can't be read, isn't a QOI file or is truncated.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+QOIImage<IEEE754_t> *QOIImage<IEEE754_t>::loadImage(const std::filesystem::path &filepath, MatrixLayout layout) {
+    INSTRUMENTATION_SCOPE("loadImage");
+
+    auto fileHandle = std::ifstream(filepath, std::ios::binary);
+    if (!fileHandle.is_open()) {
+        return nullptr;
+    }
+
+    auto bytes = std::vector<uint8_t>(std::filesystem::file_size(filepath));
+    if (!fileHandle.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+        return nullptr;
+    }
+
+    INSTRUMENTATION_COUNT(BYTES_READ, bytes.size());
+
+    auto header = QOIHeader::parsing(bytes.data(), bytes.size());
+    if (!header.has_value()) {
+        return nullptr;
+    }
+
+    INSTRUMENTATION_SCOPE("decodeRaster");
+
+    auto rows = header->height;
+    auto columns = header->width;
+    auto planes = std::vector<std::vector<IEEE754_t>>(3, std::vector<IEEE754_t>(static_cast<size_t>(rows) * columns));
+    auto decoder = QOIDecoder(bytes.data(), bytes.size());
+
+    for (unsigned int row = 0; row < rows; row++) {
+        for (unsigned int column = 0; column < columns; column++) {
+            uint8_t rgb[3];
+            if (!decoder.next(rgb)) {
+                return nullptr;
+            }
+
+            auto i = flatIndexOf(row, column, rows, columns, layout);
+            planes[0][i] = rgb[0];
+            planes[1][i] = rgb[1];
+            planes[2][i] = rgb[2];
+        }
+    }
+
+    auto channels = std::vector<Channel<IEEE754_t> *>();
+    for (auto& plane : planes) {
+        channels.push_back(new Channel<IEEE754_t>(255, plane.data(), rows, columns, layout));
+    }
+
+    return new QOIImage(columns, rows, channels);
+}
+
+/*
+ * Filters `image` (one or three channels) and writes the result to a QOI file at `filepath` (plus the "qoi" extension) as it goes: each
+ * band of `bandRows` rows is filtered with `Channel::filteredRegion`, so it matches `filtered`, then encoded and written before the next
+ * one is filtered. Neither the filtered image nor its encoded form is ever held whole. Returns the size of the file. Throws
+ * `std::invalid_argument`, before creating the file, if the samples of `image` may exceed 255.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned long long QOIImage<IEEE754_t>::filteredToFile(const Image<IEEE754_t> *image, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, const std::filesystem::path &filepath, unsigned int bandRows) {
+    assert(image != nullptr);
+    assert(image->getChannelsCount() == 1 || image->getChannelsCount() == 3);
+    assert(bandRows > 0);
+    INSTRUMENTATION_SCOPE("filteredToFile");
+    requireEightBitSamples(image);
+
+    auto fileHandle = openedForWriting(filepath, std::ios::trunc);
+    QOIHeader{image->getWidth(), image->getHeight(), 3, 0}.writeTo(fileHandle);
+
+    auto encoder = QOIEncoder(fileHandle);
+    auto bandChannels = std::vector<const Channel<IEEE754_t>*>();
+    auto pixels = std::vector<uint8_t>();
+
+    for (unsigned int firstRow = 0; firstRow < image->getHeight(); firstRow += bandRows) {
+        auto rowsCount = std::min(bandRows, image->getHeight() - firstRow);
+        auto band = MatrixRegion{firstRow, 0, rowsCount, image->getWidth()};
+
+        bandChannels.clear();
+        for (unsigned int k = 0; k < image->getChannelsCount(); k++) {
+            bandChannels.push_back(image->getChannel(k)->filteredRegion(band, usingKernel, withPaddingStrategy));
+        }
+
+        pixels.clear();
+        appendPixels(bandChannels, firstRow, rowsCount, firstRow, pixels);
+        encoder.encode(pixels.data(), pixels.size() / 3);
+
+        for (auto bandChannel : bandChannels) {
+            delete bandChannel;
+        }
+    }
+
+    auto isWritten = encoder.finish();
+    INSTRUMENTATION_COUNT(BYTES_WRITTEN, QOI_HEADER_SIZE + encoder.getWrittenBytes());
+
+    if (!isWritten) {
+        throw std::runtime_error("Could not write the specified file");
+    }
+
+    return QOI_HEADER_SIZE + encoder.getWrittenBytes();
+}
+
+template class QOIImage<float>;
+template class QOIImage<double>;
+template class QOIImage<long double>;
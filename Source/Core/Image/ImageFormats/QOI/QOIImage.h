@@ -0,0 +1,45 @@
+#ifndef IMAGECONVOLUTIONKERNEL_QOIIMAGE_H
+#define IMAGECONVOLUTIONKERNEL_QOIIMAGE_H
+
+#include <filesystem>
+#include <type_traits>
+#include <vector>
+
+#include "../../Image.h"
+#include "QOICodec.h"
+
+// How many rows are converted and encoded at a time when writing, which bounds the memory taken by the conversion to 8 bit pixels.
+constexpr unsigned int QOI_BAND_ROWS = 64;
+
+/*
+ * An RGB image stored in the QOI format (see `QOIEncoder`), a lossless alternative to binary PPM that usually takes a fraction of its size.
+ * Samples must be integers in [0, 255], as for 8 bit PPM images: images whose maximum value is higher are rejected with
+ * `std::invalid_argument` rather than truncated. Files are written with the "qoi" extension, and the encoding passed to `writeToFile`
+ * is ignored, QOI being binary only.
+ *
+ * Images of other formats are written as QOI through `fromImage`, or filtered straight to a QOI file with `filteredToFile`, which encodes
+ * each band of rows as soon as it's filtered. Single channel images are stored as gray RGB pixels, and are loaded back as RGB images.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class QOIImage : public Image<IEEE754_t> {
+public:
+    QOIImage(unsigned int width, unsigned int height, std::vector<Channel<IEEE754_t>*> channels);
+
+    QOIImage* filtered(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const override;
+    QOIImage* filteredRegion(const MatrixRegion& region, const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const override;
+    QOIImage* refiltered(const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) override;
+    void writeHeaderToFile(const std::filesystem::path& filepath, const ImageChannelsEncoding& encoding) const override;
+    void writeChannelsToFile(const std::filesystem::path& filepath, const ImageChannelsEncoding& encoding) const override;
+
+    static QOIImage* fromImage(const Image<IEEE754_t>* image);
+    static QOIImage* loadImage(const std::filesystem::path& filepath, MatrixLayout layout = ROW_MAJOR);
+    static unsigned long long filteredToFile(
+        const Image<IEEE754_t>* image,
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        const std::filesystem::path& filepath,
+        unsigned int bandRows = QOI_BAND_ROWS
+    );
+};
+
+#endif
@@ -0,0 +1,192 @@
+#include "Instrumentation.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+    thread_local unsigned int currentScopeDepth = 0;
+
+    std::string escaped(const std::string& text) {
+        std::string escapedText;
+        for (auto character : text) {
+            if (character == '"' || character == '\\') {
+                escapedText += '\\';
+            }
+            escapedText += character;
+        }
+
+        return escapedText;
+    }
+}
+
+Instrumentation::Instrumentation() : epoch(std::chrono::steady_clock::now()) {
+
+}
+
+Instrumentation &Instrumentation::shared() {
+    static Instrumentation instrumentation;
+    return instrumentation;
+}
+
+const char *Instrumentation::nameOf(InstrumentationCounter counter) {
+    switch (counter) {
+        case InstrumentationCounter::BYTES_READ:
+            return "bytesRead";
+        case InstrumentationCounter::BYTES_WRITTEN:
+            return "bytesWritten";
+        case InstrumentationCounter::PIXELS_PROCESSED:
+            return "pixelsProcessed";
+        case InstrumentationCounter::ALLOCATIONS:
+            return "allocations";
+        default:
+            return "unknown";
+    }
+}
+
+long long Instrumentation::nanosecondsSinceEpoch() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->epoch).count();
+}
+
+/*
+ * Threads are numbered in order of their first event, which gives stable and readable `tid`s in the trace viewer.
+ * Must be called while holding `mutex`.
+ */
+unsigned int Instrumentation::indexOfCurrentThread() {
+    auto [entry, _] = this->threadIndices.try_emplace(std::this_thread::get_id(), this->threadIndices.size());
+    return entry->second;
+}
+
+void Instrumentation::recordEvent(const std::string &stage, unsigned int depth, long long startNanoseconds, long long endNanoseconds) {
+    std::lock_guard lock(this->mutex);
+    this->events.push_back({stage, this->indexOfCurrentThread(), depth, startNanoseconds, endNanoseconds - startNanoseconds});
+}
+
+void Instrumentation::addToCounter(InstrumentationCounter counter, unsigned long long amount) {
+    this->counters[static_cast<int>(counter)] += amount;
+}
+
+std::vector<InstrumentationEvent> Instrumentation::getEvents() const {
+    std::lock_guard lock(this->mutex);
+    return this->events;
+}
+
+unsigned long long Instrumentation::getCounter(InstrumentationCounter counter) const {
+    return this->counters[static_cast<int>(counter)];
+}
+
+void Instrumentation::reset() {
+    std::lock_guard lock(this->mutex);
+    this->events.clear();
+
+    for (auto& counter : this->counters) {
+        counter = 0;
+    }
+}
+
+/*
+ * The utilisation of a thread is the time spent in its outermost scopes over the wall time spanned by all the recorded events,
+ * nested scopes are not counted twice.
+ */
+std::string Instrumentation::toJSON() const {
+    struct StageSummary {
+        unsigned long long count = 0;
+        long long totalNanoseconds = 0;
+        long long maxNanoseconds = 0;
+    };
+
+    auto recordedEvents = this->getEvents();
+
+    std::map<std::string, StageSummary> stages;
+    std::map<unsigned int, long long> busyNanosecondsPerThread;
+    long long firstStart = recordedEvents.empty() ? 0 : recordedEvents.front().startNanoseconds;
+    long long lastEnd = firstStart;
+
+    for (const auto& event : recordedEvents) {
+        auto& summary = stages[event.stage];
+        summary.count++;
+        summary.totalNanoseconds += event.durationNanoseconds;
+        summary.maxNanoseconds = std::max(summary.maxNanoseconds, event.durationNanoseconds);
+
+        if (event.depth == 0) {
+            busyNanosecondsPerThread[event.threadIndex] += event.durationNanoseconds;
+        }
+
+        firstStart = std::min(firstStart, event.startNanoseconds);
+        lastEnd = std::max(lastEnd, event.startNanoseconds + event.durationNanoseconds);
+    }
+
+    auto wallNanoseconds = lastEnd - firstStart;
+
+    std::ostringstream json;
+    json << "{\"wallNanoseconds\":" << wallNanoseconds << ",\"stages\":{";
+
+    auto isFirst = true;
+    for (const auto& [stage, summary] : stages) {
+        json << (isFirst ? "" : ",") << "\"" << escaped(stage) << "\":{"
+             << "\"count\":" << summary.count
+             << ",\"totalNanoseconds\":" << summary.totalNanoseconds
+             << ",\"maxNanoseconds\":" << summary.maxNanoseconds << "}";
+        isFirst = false;
+    }
+
+    json << "},\"counters\":{";
+    for (int i = 0; i < static_cast<int>(InstrumentationCounter::COUNT); i++) {
+        auto counter = static_cast<InstrumentationCounter>(i);
+        json << (i == 0 ? "" : ",") << "\"" << nameOf(counter) << "\":" << this->getCounter(counter);
+    }
+
+    json << "},\"threads\":[";
+    isFirst = true;
+    for (const auto& [threadIndex, busyNanoseconds] : busyNanosecondsPerThread) {
+        auto utilisation = wallNanoseconds > 0 ? static_cast<double>(busyNanoseconds) / static_cast<double>(wallNanoseconds) : 0.0;
+
+        json << (isFirst ? "" : ",") << "{\"thread\":" << threadIndex
+             << ",\"busyNanoseconds\":" << busyNanoseconds
+             << ",\"utilisation\":" << utilisation << "}";
+        isFirst = false;
+    }
+    json << "]}";
+
+    return json.str();
+}
+
+/*
+ * Each event becomes a complete ("X") event, timestamps are in microseconds as the format requires.
+ * Counters are appended as a single counter ("C") event at the end of the trace.
+ */
+std::string Instrumentation::toChromeTrace() const {
+    auto recordedEvents = this->getEvents();
+
+    std::ostringstream trace;
+    trace << "{\"traceEvents\":[";
+
+    long long lastEnd = 0;
+    for (size_t i = 0; i < recordedEvents.size(); i++) {
+        const auto& event = recordedEvents[i];
+        lastEnd = std::max(lastEnd, event.startNanoseconds + event.durationNanoseconds);
+
+        trace << (i == 0 ? "" : ",") << "{\"name\":\"" << escaped(event.stage) << "\""
+              << ",\"cat\":\"ImageConvolutionKernel\",\"ph\":\"X\""
+              << ",\"ts\":" << static_cast<double>(event.startNanoseconds) / 1000.0
+              << ",\"dur\":" << static_cast<double>(event.durationNanoseconds) / 1000.0
+              << ",\"pid\":1,\"tid\":" << event.threadIndex << "}";
+    }
+
+    trace << (recordedEvents.empty() ? "" : ",") << "{\"name\":\"counters\",\"ph\":\"C\",\"ts\":" << static_cast<double>(lastEnd) / 1000.0 << ",\"pid\":1,\"args\":{";
+    for (int i = 0; i < static_cast<int>(InstrumentationCounter::COUNT); i++) {
+        auto counter = static_cast<InstrumentationCounter>(i);
+        trace << (i == 0 ? "" : ",") << "\"" << nameOf(counter) << "\":" << this->getCounter(counter);
+    }
+    trace << "}}]}";
+
+    return trace.str();
+}
+
+Instrumentation::Scope::Scope(const char *stage) : stage(stage), depth(currentScopeDepth++), startNanoseconds(Instrumentation::shared().nanosecondsSinceEpoch()) {
+
+}
+
+Instrumentation::Scope::~Scope() {
+    currentScopeDepth--;
+    Instrumentation::shared().recordEvent(this->stage, this->depth, this->startNanoseconds, Instrumentation::shared().nanosecondsSinceEpoch());
+}
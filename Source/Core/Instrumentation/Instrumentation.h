@@ -0,0 +1,93 @@
+#ifndef IMAGECONVOLUTIONKERNEL_INSTRUMENTATION_H
+#define IMAGECONVOLUTIONKERNEL_INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class InstrumentationCounter {
+    BYTES_READ = 0,
+    BYTES_WRITTEN = 1,
+    PIXELS_PROCESSED = 2,
+    ALLOCATIONS = 3,
+    COUNT = 4
+};
+
+struct InstrumentationEvent {
+    std::string stage;
+    unsigned int threadIndex;
+    unsigned int depth;
+    long long startNanoseconds;
+    long long durationNanoseconds;
+};
+
+/*
+ * Collects wall time of the stages of the hot path (parsing, decoding, filtering, encoding...) and a few counters.
+ *
+ * The library only talks to this class through the `INSTRUMENTATION_SCOPE` and `INSTRUMENTATION_COUNT` macros, which expand to nothing
+ * unless the project is configured with `-DIMAGECONVOLUTIONKERNEL_INSTRUMENTATION=ON`, so that a regular build pays nothing for it.
+ *
+ * Results can be exported either as a JSON summary (per stage totals, counters and per thread utilisation) or in the Chrome
+ * trace-event format, that can be loaded in chrome://tracing or Perfetto.
+ */
+class Instrumentation {
+private:
+    std::chrono::steady_clock::time_point epoch;
+
+    mutable std::mutex mutex;
+    std::vector<InstrumentationEvent> events;
+    std::map<std::thread::id, unsigned int> threadIndices;
+    std::atomic<unsigned long long> counters[static_cast<int>(InstrumentationCounter::COUNT)] = {};
+
+    unsigned int indexOfCurrentThread();
+
+public:
+    Instrumentation();
+
+    static Instrumentation& shared();
+    static const char* nameOf(InstrumentationCounter counter);
+
+    [[nodiscard]] long long nanosecondsSinceEpoch() const;
+    void recordEvent(const std::string& stage, unsigned int depth, long long startNanoseconds, long long endNanoseconds);
+    void addToCounter(InstrumentationCounter counter, unsigned long long amount);
+
+    [[nodiscard]] std::vector<InstrumentationEvent> getEvents() const;
+    [[nodiscard]] unsigned long long getCounter(InstrumentationCounter counter) const;
+    void reset();
+
+    [[nodiscard]] std::string toJSON() const;
+    [[nodiscard]] std::string toChromeTrace() const;
+
+    /*
+     * Records the wall time between its construction and destruction as an event of `stage` on the current thread.
+     */
+    class Scope {
+    private:
+        const char* stage;
+        unsigned int depth;
+        long long startNanoseconds;
+
+    public:
+        explicit Scope(const char* stage);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+    };
+};
+
+#define INSTRUMENTATION_CONCATENATE_IMPL(lhs, rhs) lhs##rhs
+#define INSTRUMENTATION_CONCATENATE(lhs, rhs) INSTRUMENTATION_CONCATENATE_IMPL(lhs, rhs)
+
+#ifdef IMAGECONVOLUTIONKERNEL_INSTRUMENTATION
+    #define INSTRUMENTATION_SCOPE(stage) Instrumentation::Scope INSTRUMENTATION_CONCATENATE(instrumentationScope, __LINE__)(stage)
+    #define INSTRUMENTATION_COUNT(counter, amount) Instrumentation::shared().addToCounter(InstrumentationCounter::counter, amount)
+#else
+    #define INSTRUMENTATION_SCOPE(stage) do { } while (false)
+    #define INSTRUMENTATION_COUNT(counter, amount) do { } while (false)
+#endif
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef IMAGECONVOLUTIONKERNEL_GEMM_H
+#define IMAGECONVOLUTIONKERNEL_GEMM_H
+
+#include <algorithm>
+#include <cstddef>
+
+/*
+ * Blocking of `multiplyAccumulate`: the panels of the right operand (`GEMM_DEPTH_BLOCK` x `GEMM_COLUMNS_BLOCK` values) and of the left one
+ * (`GEMM_ROWS_BLOCK` x `GEMM_DEPTH_BLOCK`) are sized to stay in L2 and L1 respectively, and each `GEMM_REGISTER_ROWS` x `GEMM_REGISTER_COLUMNS`
+ * tile of the result is accumulated in registers over a whole depth block before being stored.
+ */
+constexpr size_t GEMM_ROWS_BLOCK = 64;
+constexpr size_t GEMM_COLUMNS_BLOCK = 256;
+constexpr size_t GEMM_DEPTH_BLOCK = 128;
+constexpr size_t GEMM_REGISTER_ROWS = 4;
+constexpr size_t GEMM_REGISTER_COLUMNS = 8;
+
+/*
+ * The `tileRows` x `tileColumns` tile of the result at `result`, plus the products over `depth` values. Full tiles have compile time bounds,
+ * so the compiler keeps the tile in registers and vectorises along the columns.
+ */
+template<size_t tileRows, size_t tileColumns, typename IEEE754_t>
+inline void multiplyAccumulateTile(const IEEE754_t* left, size_t leftStride, const IEEE754_t* right, size_t rightStride, IEEE754_t* result, size_t resultStride, size_t depth) {
+    IEEE754_t tile[tileRows][tileColumns];
+
+    for (size_t i = 0; i < tileRows; i++) {
+        for (size_t j = 0; j < tileColumns; j++) {
+            tile[i][j] = result[i * resultStride + j];
+        }
+    }
+
+    for (size_t k = 0; k < depth; k++) {
+        auto rightRow = right + k * rightStride;
+
+        for (size_t i = 0; i < tileRows; i++) {
+            auto leftValue = left[i * leftStride + k];
+
+            for (size_t j = 0; j < tileColumns; j++) {
+                tile[i][j] += leftValue * rightRow[j];
+            }
+        }
+    }
+
+    for (size_t i = 0; i < tileRows; i++) {
+        for (size_t j = 0; j < tileColumns; j++) {
+            result[i * resultStride + j] = tile[i][j];
+        }
+    }
+}
+
+template<typename IEEE754_t>
+inline void multiplyAccumulateEdgeTile(const IEEE754_t* left, size_t leftStride, const IEEE754_t* right, size_t rightStride, IEEE754_t* result, size_t resultStride, size_t tileRows, size_t tileColumns, size_t depth) {
+    for (size_t i = 0; i < tileRows; i++) {
+        for (size_t j = 0; j < tileColumns; j++) {
+            auto value = result[i * resultStride + j];
+
+            for (size_t k = 0; k < depth; k++) {
+                value += left[i * leftStride + k] * right[k * rightStride + j];
+            }
+
+            result[i * resultStride + j] = value;
+        }
+    }
+}
+
+/*
+ * result += left · right, with `left` a `rows` x `depth` matrix, `right` a `depth` x `columns` one and `result` a `rows` x `columns` one, all
+ * row-major with the given strides.
+ *
+ * Each value of the result sums its products in increasing depth order, like a plain triple loop would, so the blocking doesn't change
+ * the rounding.
+ */
+template<typename IEEE754_t>
+void multiplyAccumulate(const IEEE754_t* left, size_t leftStride, const IEEE754_t* right, size_t rightStride, IEEE754_t* result, size_t resultStride, size_t rows, size_t columns, size_t depth) {
+    for (size_t columnsBlock = 0; columnsBlock < columns; columnsBlock += GEMM_COLUMNS_BLOCK) {
+        auto lastColumn = std::min(columns, columnsBlock + GEMM_COLUMNS_BLOCK);
+
+        for (size_t depthBlock = 0; depthBlock < depth; depthBlock += GEMM_DEPTH_BLOCK) {
+            auto blockDepth = std::min(depth, depthBlock + GEMM_DEPTH_BLOCK) - depthBlock;
+
+            for (size_t rowsBlock = 0; rowsBlock < rows; rowsBlock += GEMM_ROWS_BLOCK) {
+                auto lastRow = std::min(rows, rowsBlock + GEMM_ROWS_BLOCK);
+
+                for (size_t row = rowsBlock; row < lastRow; row += GEMM_REGISTER_ROWS) {
+                    auto tileRows = std::min(GEMM_REGISTER_ROWS, lastRow - row);
+
+                    for (size_t column = columnsBlock; column < lastColumn; column += GEMM_REGISTER_COLUMNS) {
+                        auto tileColumns = std::min(GEMM_REGISTER_COLUMNS, lastColumn - column);
+
+                        auto tileLeft = left + row * leftStride + depthBlock;
+                        auto tileRight = right + depthBlock * rightStride + column;
+                        auto tileResult = result + row * resultStride + column;
+
+                        if (tileRows == GEMM_REGISTER_ROWS && tileColumns == GEMM_REGISTER_COLUMNS) {
+                            multiplyAccumulateTile<GEMM_REGISTER_ROWS, GEMM_REGISTER_COLUMNS>(tileLeft, leftStride, tileRight, rightStride, tileResult, resultStride, blockDepth);
+                        } else {
+                            multiplyAccumulateEdgeTile(tileLeft, leftStride, tileRight, rightStride, tileResult, resultStride, tileRows, tileColumns, blockDepth);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -1,7 +1,12 @@
 #include "Matrix.h"
 
 #include <cassert>
+#include <cstring>
 #include <random>
+#include <vector>
+
+#include "Gemm.h"
+#include "../Instrumentation/Instrumentation.h"
 
 
 #include <iostream>
@@ -13,10 +18,32 @@ Matrix<IEEE754_t>::Matrix(const IEEE754_t *elements, unsigned int rows, unsigned
     assert(columns > 0);
 
     auto theMatrix = new IEEE754_t[rows * columns];
+    INSTRUMENTATION_COUNT(ALLOCATIONS, 1);
     std::memcpy(theMatrix, elements, rows * columns * sizeof(IEEE754_t));
     this->matrix = theMatrix;
 }
 
+/*
+ * A matrix whose values are left uninitialized, for derived classes that write every value right after construction.
+ */
+template <typename IEEE754_t>
+    requires std::is_floating_point_v<IEEE754_t>
+Matrix<IEEE754_t>::Matrix(unsigned int rows, unsigned int columns, MatrixLayout layout) : layout(layout), rows(rows), columns(columns) {
+    assert(rows > 0);
+    assert(columns > 0);
+
+    this->matrix = new IEEE754_t[rows * columns];
+    INSTRUMENTATION_COUNT(ALLOCATIONS, 1);
+}
+
+template <typename IEEE754_t>
+    requires std::is_floating_point_v<IEEE754_t>
+Matrix<IEEE754_t>::Matrix(BorrowedStorage, IEEE754_t *elements, unsigned int rows, unsigned int columns, MatrixLayout layout) : matrix(elements), layout(layout), rows(rows), columns(columns), ownsElements(false) {
+    assert(elements != nullptr);
+    assert(rows > 0);
+    assert(columns > 0);
+}
+
 template <typename IEEE754_t>
     requires std::is_floating_point_v<IEEE754_t>
 IEEE754_t* Matrix<IEEE754_t>::operator[](int row) const {
@@ -25,14 +52,8 @@ IEEE754_t* Matrix<IEEE754_t>::operator[](int row) const {
     auto requestedRow = new IEEE754_t[this->columns];
     memset(requestedRow, 0, sizeof(IEEE754_t) * this->columns);
 
-    if (this->layout == ROW_MAJOR) {
-        for (int i = 0; i < this->columns; i++) {
-            requestedRow[i] = this->matrix[row * this->columns + i];
-        }
-    } else {
-        for (int i = 0; i < this->columns; i++) {
-            requestedRow[i] = this->matrix[row + this->rows * i];
-        }
+    for (unsigned int i = 0; i < this->columns; i++) {
+        requestedRow[i] = this->matrix[flatIndexOf(row, i, this->rows, this->columns, this->layout)];
     }
 
     return requestedRow;
@@ -42,27 +63,68 @@ IEEE754_t* Matrix<IEEE754_t>::operator[](int row) const {
 template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
 Matrix<IEEE754_t>* Matrix<IEEE754_t>::transposed() const {
     auto transposedMatrix = new IEEE754_t[this->rows * this->columns];
-    for ( int i = 0; i < this->rows * this->columns; i++ ) {
-        int row = this->layout == ROW_MAJOR ? i / this->columns : i % this->rows;
-        int col = this->layout == ROW_MAJOR ? i % this->columns : i / this->rows;
-
-        auto transposedIndex = this->layout == ROW_MAJOR ? col * this->rows + row : col + row * this->columns;
-        transposedMatrix[transposedIndex] = this->matrix[i];
+    for (unsigned int row = 0; row < this->rows; row++) {
+        for (unsigned int column = 0; column < this->columns; column++) {
+            auto transposedIndex = flatIndexOf(column, row, this->columns, this->rows, this->layout);
+            transposedMatrix[transposedIndex] = this->matrix[flatIndexOf(row, column, this->rows, this->columns, this->layout)];
+        }
     }
 
-    return new Matrix<IEEE754_t>(
+    auto transposed = new Matrix<IEEE754_t>(
         transposedMatrix,
         this->columns,
         this->rows,
         this->layout
     );
+    delete[] transposedMatrix;
+
+    return transposed;
 }
 
 
+/*
+ * The product this · other, with the layout of this matrix. Operands that aren't row-major are gathered into row-major copies first, the
+ * product itself is the cache blocked `multiplyAccumulate`.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Matrix<IEEE754_t>* Matrix<IEEE754_t>::multiplied(const Matrix *other) const {
+    assert(other != nullptr);
+    assert(this->columns == other->rows);
+    INSTRUMENTATION_SCOPE("Matrix::multiplied");
+
+    auto rowMajorElementsOf = [](const Matrix* matrix) {
+        auto elements = std::vector<IEEE754_t>(matrix->rows * matrix->columns);
+        for (unsigned int row = 0; row < matrix->rows; row++) {
+            for (unsigned int column = 0; column < matrix->columns; column++) {
+                elements[row * matrix->columns + column] = matrix->at(row, column);
+            }
+        }
+
+        return elements;
+    };
+
+    auto left = rowMajorElementsOf(this);
+    auto right = rowMajorElementsOf(other);
+    auto product = std::vector<IEEE754_t>(this->rows * other->columns, 0);
+
+    multiplyAccumulate(left.data(), this->columns, right.data(), other->columns, product.data(), other->columns, this->rows, other->columns, this->columns);
+
+    auto productMatrix = new Matrix<IEEE754_t>(this->rows, other->columns, this->layout);
+    for (unsigned int row = 0; row < this->rows; row++) {
+        for (unsigned int column = 0; column < other->columns; column++) {
+            productMatrix->matrix[flatIndexOf(row, column, this->rows, other->columns, this->layout)] = product[row * other->columns + column];
+        }
+    }
+
+    return productMatrix;
+}
+
 template <typename IEEE754_t>
     requires std::is_floating_point_v<IEEE754_t>
 Matrix<IEEE754_t>::~Matrix() {
-    delete[] this->matrix;
+    if (this->ownsElements) {
+        delete[] this->matrix;
+    }
 }
 
 template <typename IEEE754_t>
@@ -71,8 +133,23 @@ IEEE754_t Matrix<IEEE754_t>::at(unsigned int row, unsigned int column) const {
     assert(row >= 0 && row < this->rows);
     assert(column >= 0 && column < this->columns);
 
-    auto flatIndex = this->layout == ROW_MAJOR ? row * this->columns + column : row + this->rows * column;
-    return this->matrix[flatIndex];
+    return this->matrix[flatIndexOf(row, column, this->rows, this->columns, this->layout)];
+}
+
+/*
+ * Raw access to the storage, laid out according to `getMatrixLayout()`. Meant for subclasses that need to scan the elements
+ * without paying for the bound checks and the layout dispatch of `at` on every access.
+ */
+template <typename IEEE754_t>
+    requires std::is_floating_point_v<IEEE754_t>
+const IEEE754_t* Matrix<IEEE754_t>::getElements() const {
+    return this->matrix;
+}
+
+template <typename IEEE754_t>
+    requires std::is_floating_point_v<IEEE754_t>
+IEEE754_t* Matrix<IEEE754_t>::getMutableElements() {
+    return this->matrix;
 }
 
 // Getters
@@ -95,6 +172,12 @@ unsigned int Matrix<IEEE754_t>::getColumns() const {
     return this->columns;
 }
 
+template <typename IEEE754_t>
+    requires std::is_floating_point_v<IEEE754_t>
+bool Matrix<IEEE754_t>::isBorrowingStorage() const {
+    return !this->ownsElements;
+}
+
 template class Matrix<float>;
 template class Matrix<double>;
 template class Matrix<long double>;
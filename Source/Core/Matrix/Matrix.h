@@ -3,10 +3,13 @@
 
 #include <type_traits>
 
-enum MatrixLayout {
-    ROW_MAJOR,
-    COLUMN_MAJOR
-};
+#include "MatrixLayout.h"
+
+/*
+ * Tag of the constructors that use the given storage in place rather than copying it. The storage isn't freed with the matrix, so it
+ * must outlive it (see `Channel::borrowing`).
+ */
+struct BorrowedStorage {};
 
 template <typename IEEE754_t>
     requires std::is_floating_point_v<IEEE754_t>
@@ -16,6 +19,14 @@ private:
     MatrixLayout layout;
     unsigned int rows;
     unsigned int columns;
+    bool ownsElements = true;
+
+protected:
+    Matrix(unsigned int rows, unsigned int columns, MatrixLayout layout);
+    Matrix(BorrowedStorage, IEEE754_t* elements, unsigned int rows, unsigned int columns, MatrixLayout layout);
+
+    [[nodiscard]] const IEEE754_t* getElements() const;
+    [[nodiscard]] IEEE754_t* getMutableElements();
 
 public:
     Matrix(const IEEE754_t* elements, unsigned int rows, unsigned int columns, MatrixLayout layout = ROW_MAJOR);
@@ -24,11 +35,13 @@ public:
     IEEE754_t* operator[](int row) const;
 
     Matrix* transposed() const;
+    Matrix* multiplied(const Matrix* other) const;
 
     MatrixLayout getMatrixLayout() const;
     unsigned int getRows() const;
     unsigned int getColumns() const;
     IEEE754_t at(unsigned int, unsigned int) const;
+    [[nodiscard]] bool isBorrowingStorage() const;
 
     ~Matrix();
 };
@@ -0,0 +1,43 @@
+#ifndef IMAGECONVOLUTIONKERNEL_MATRIXLAYOUT_H
+#define IMAGECONVOLUTIONKERNEL_MATRIXLAYOUT_H
+
+#include <algorithm>
+#include <cstddef>
+
+/*
+ * How the elements of a matrix are laid out in memory.
+ *
+ * `TILED` stores the matrix as square tiles of `MATRIX_TILE_SIZE` elements per side, each of them contiguous and row-major; tiles follow each
+ * other in row-major order. The tiles along the bottom and right edges are cropped to the matrix rather than padded, so a tiled matrix takes
+ * exactly `rows * columns` elements like the other layouts. A 2D window is then spread over a few tiles instead of `rows` distant lines, which
+ * keeps both the horizontal and the vertical passes of a stencil cache and TLB friendly.
+ */
+enum MatrixLayout {
+    ROW_MAJOR,
+    COLUMN_MAJOR,
+    TILED
+};
+
+constexpr unsigned int MATRIX_TILE_SIZE = 32;
+
+/*
+ * Position in the storage of a `rows` x `columns` matrix with the given layout of the element at (row, column).
+ */
+inline size_t flatIndexOf(unsigned int row, unsigned int column, unsigned int rows, unsigned int columns, MatrixLayout layout) {
+    switch (layout) {
+        case ROW_MAJOR:
+            return static_cast<size_t>(row) * columns + column;
+        case COLUMN_MAJOR:
+            return row + static_cast<size_t>(rows) * column;
+        case TILED:
+        default:
+            auto bandRow = row - row % MATRIX_TILE_SIZE;
+            auto tileColumn = column - column % MATRIX_TILE_SIZE;
+            auto bandHeight = std::min(MATRIX_TILE_SIZE, rows - bandRow);
+            auto tileWidth = std::min(MATRIX_TILE_SIZE, columns - tileColumn);
+
+            return static_cast<size_t>(bandRow) * columns + static_cast<size_t>(tileColumn) * bandHeight + (row - bandRow) * tileWidth + (column - tileColumn);
+    }
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef IMAGECONVOLUTIONKERNEL_MATRIXREGION_H
+#define IMAGECONVOLUTIONKERNEL_MATRIXREGION_H
+
+#include <algorithm>
+
+/*
+ * A rectangle of a matrix: `rows` rows starting at `row`, and `columns` columns starting at `column`.
+ */
+struct MatrixRegion {
+    unsigned int row;
+    unsigned int column;
+    unsigned int rows;
+    unsigned int columns;
+
+    [[nodiscard]] bool isEmpty() const {
+        return rows == 0 || columns == 0;
+    }
+
+    [[nodiscard]] bool isWithin(unsigned int matrixRows, unsigned int matrixColumns) const {
+        return row + rows <= matrixRows && column + columns <= matrixColumns;
+    }
+
+    [[nodiscard]] unsigned int getLastRow() const {
+        return row + rows;
+    }
+
+    [[nodiscard]] unsigned int getLastColumn() const {
+        return column + columns;
+    }
+};
+
+#endif
@@ -19,6 +19,17 @@ public:
      * The purpose of this method is to parametrize what happens when you apply a convolution kernel at an output pixel where at least part of the kernel falls out of bounds with respect to the input matrix.
      */
     virtual IEEE754_t pad(const Matrix<IEEE754_t>&, int,  int) const = 0;
+
+    /*
+     * Whether the values returned for out of bounds indices never depend on the elements of the matrix, as for zero padding.
+     *
+     * When that's not the case (e.g. periodic extension), changing an element near the boundaries may change the output of a convolution on the
+     * other side of the matrix, therefore incremental re-filtering has to fall back to a full pass. Returning false is always safe.
+     */
+    [[nodiscard]] virtual bool isLocal() const {
+        return false;
+    }
+
     virtual ~MatrixPaddingStrategy() = default;
 };
 
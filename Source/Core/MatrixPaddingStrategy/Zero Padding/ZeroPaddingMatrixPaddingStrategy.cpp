@@ -15,6 +15,11 @@ template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
         }
     }
 
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+    bool ZeroPaddingMatrixPaddingStrategy<IEEE754_t>::isLocal() const {
+        return true;
+    }
+
 template class ZeroPaddingMatrixPaddingStrategy<float>;
 template class ZeroPaddingMatrixPaddingStrategy<double>;
 template class ZeroPaddingMatrixPaddingStrategy<long double>;
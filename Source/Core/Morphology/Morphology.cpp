@@ -0,0 +1,166 @@
+#include "Morphology.h"
+
+#include <cassert>
+#include <vector>
+
+#include "../Scheduler/Spans.h"
+#include "../Instrumentation/Instrumentation.h"
+
+namespace {
+    /*
+     * van Herk/Gil-Werman over `values`, a line of `windowSize` - 1 + `outputsCount` values: output i selects among values [i, i + windowSize[.
+     * `forwards` and `backwards` are scratch buffers as long as the line.
+     */
+    template<typename IEEE754_t, typename Select>
+    void selectAlongLine(const IEEE754_t* values, size_t outputsCount, size_t windowSize, IEEE754_t* forwards, IEEE754_t* backwards, IEEE754_t* outputs, Select select) {
+        auto lineLength = outputsCount + windowSize - 1;
+
+        for (size_t i = 0; i < lineLength; i++) {
+            forwards[i] = i % windowSize == 0 ? values[i] : select(forwards[i - 1], values[i]);
+        }
+
+        for (size_t i = lineLength; i-- > 0; ) {
+            backwards[i] = i % windowSize == windowSize - 1 || i == lineLength - 1 ? values[i] : select(backwards[i + 1], values[i]);
+        }
+
+        for (size_t i = 0; i < outputsCount; i++) {
+            outputs[i] = select(backwards[i], forwards[i + windowSize - 1]);
+        }
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Morphology<IEEE754_t>::Morphology(unsigned int elementRows, unsigned int elementColumns, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) :
+    elementRows(elementRows), elementColumns(elementColumns), paddingStrategy(withPaddingStrategy) {
+    assert(withPaddingStrategy != nullptr);
+    assert(elementRows % 2 == 1 && elementColumns % 2 == 1);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int Morphology<IEEE754_t>::getElementRows() const {
+    return this->elementRows;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int Morphology<IEEE754_t>::getElementColumns() const {
+    return this->elementColumns;
+}
+
+/*
+ * The horizontal pass also runs over the `elementRows` / 2 rows above and below the channel, as given by the padding strategy, so that
+ * the vertical pass never needs to pad: the result is exact for any padding strategy, not only for those that pad with a constant.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Select>
+Channel<IEEE754_t> *Morphology<IEEE754_t>::applied(const Channel<IEEE754_t> *channel, Select select, WorkStealingScheduler *scheduler) const {
+    assert(channel != nullptr);
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, channel->getRows() * channel->getColumns());
+
+    auto rows = channel->getRows();
+    auto columns = channel->getColumns();
+    auto layout = channel->getMatrixLayout();
+
+    auto rowsRadius = static_cast<int>(this->elementRows / 2);
+    auto columnsRadius = static_cast<int>(this->elementColumns / 2);
+    auto extendedRows = rows + 2 * rowsRadius;
+
+    // Horizontal pass, row-major over the extended rows.
+    auto horizontallySelected = std::vector<IEEE754_t>(static_cast<size_t>(extendedRows) * columns);
+    auto rowsPerSpan = std::max<size_t>(1, MIN_VALUES_PER_TASK / columns);
+
+    forEachSpan(extendedRows, spansCountFor(extendedRows, rowsPerSpan, scheduler), scheduler, [&](size_t, size_t begin, size_t end) {
+        auto lineLength = columns + 2 * columnsRadius;
+        auto line = std::vector<IEEE754_t>(lineLength);
+        auto forwards = std::vector<IEEE754_t>(lineLength);
+        auto backwards = std::vector<IEEE754_t>(lineLength);
+
+        for (auto extendedRow = begin; extendedRow < end; extendedRow++) {
+            auto row = static_cast<int>(extendedRow) - rowsRadius;
+            auto isRowInside = row >= 0 && row < static_cast<int>(rows);
+
+            for (int lineColumn = 0; lineColumn < static_cast<int>(lineLength); lineColumn++) {
+                auto column = lineColumn - columnsRadius;
+                auto isInside = isRowInside && column >= 0 && column < static_cast<int>(columns);
+
+                line[lineColumn] = isInside ? channel->at(row, column) : this->paddingStrategy->pad(*channel, row, column);
+            }
+
+            selectAlongLine(line.data(), columns, this->elementColumns, forwards.data(), backwards.data(), horizontallySelected.data() + extendedRow * columns, select);
+        }
+    });
+
+    // Vertical pass, on whole (spans of) rows at a time.
+    auto forwards = std::vector<IEEE754_t>(horizontallySelected.size());
+    auto backwards = std::vector<IEEE754_t>(horizontallySelected.size());
+
+    auto selectedChannel = new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), rows, columns, layout);
+    auto destination = selectedChannel->getMutableElements();
+    auto columnsPerSpan = std::max<size_t>(1, MIN_VALUES_PER_TASK / extendedRows);
+    auto windowSize = this->elementRows;
+
+    forEachSpan(columns, spansCountFor(columns, columnsPerSpan, scheduler), scheduler, [&](size_t, size_t begin, size_t end) {
+        auto values = horizontallySelected.data();
+
+        for (unsigned int row = 0; row < extendedRows; row++) {
+            auto offset = static_cast<size_t>(row) * columns;
+
+            for (auto column = begin; column < end; column++) {
+                forwards[offset + column] = row % windowSize == 0 ? values[offset + column] : select(forwards[offset - columns + column], values[offset + column]);
+            }
+        }
+
+        for (unsigned int row = extendedRows; row-- > 0; ) {
+            auto offset = static_cast<size_t>(row) * columns;
+            auto isSegmentEnd = row % windowSize == windowSize - 1 || row == extendedRows - 1;
+
+            for (auto column = begin; column < end; column++) {
+                backwards[offset + column] = isSegmentEnd ? values[offset + column] : select(backwards[offset + columns + column], values[offset + column]);
+            }
+        }
+
+        for (unsigned int row = 0; row < rows; row++) {
+            auto windowStart = static_cast<size_t>(row) * columns;
+            auto windowEnd = static_cast<size_t>(row + windowSize - 1) * columns;
+
+            for (auto column = begin; column < end; column++) {
+                destination[flatIndexOf(row, column, rows, columns, layout)] = select(backwards[windowStart + column], forwards[windowEnd + column]);
+            }
+        }
+    });
+
+    return selectedChannel;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *Morphology<IEEE754_t>::eroded(const Channel<IEEE754_t> *channel, WorkStealingScheduler *scheduler) const {
+    INSTRUMENTATION_SCOPE("Morphology::eroded");
+    return this->applied(channel, [](IEEE754_t a, IEEE754_t b) { return b < a ? b : a; }, scheduler);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *Morphology<IEEE754_t>::dilated(const Channel<IEEE754_t> *channel, WorkStealingScheduler *scheduler) const {
+    INSTRUMENTATION_SCOPE("Morphology::dilated");
+    return this->applied(channel, [](IEEE754_t a, IEEE754_t b) { return b > a ? b : a; }, scheduler);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *Morphology<IEEE754_t>::opened(const Channel<IEEE754_t> *channel, WorkStealingScheduler *scheduler) const {
+    auto erodedChannel = this->eroded(channel, scheduler);
+    auto openedChannel = this->dilated(erodedChannel, scheduler);
+    delete erodedChannel;
+
+    return openedChannel;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *Morphology<IEEE754_t>::closed(const Channel<IEEE754_t> *channel, WorkStealingScheduler *scheduler) const {
+    auto dilatedChannel = this->dilated(channel, scheduler);
+    auto closedChannel = this->eroded(dilatedChannel, scheduler);
+    delete dilatedChannel;
+
+    return closedChannel;
+}
+
+template class Morphology<float>;
+template class Morphology<double>;
+template class Morphology<long double>;
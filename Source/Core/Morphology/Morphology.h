@@ -0,0 +1,48 @@
+#ifndef IMAGECONVOLUTIONKERNEL_MORPHOLOGY_H
+#define IMAGECONVOLUTIONKERNEL_MORPHOLOGY_H
+
+#include <type_traits>
+
+#include "../Channel/Channel.h"
+
+class WorkStealingScheduler;
+
+/*
+ * Grayscale morphology with a rectangular structuring element of `elementRows` x `elementColumns` pixels (odd sizes, centred on the pixel):
+ * erosion is the minimum over the element, dilation the maximum. Values out of the channel come from the padding strategy, as for
+ * `Channel::filtered`.
+ *
+ * A rectangle is separable, so each operation is a horizontal pass followed by a vertical one, and each pass runs the van Herk/Gil-Werman
+ * algorithm: lines are cut in segments as long as the element, prefix minima (maxima) are taken forwards and suffix ones backwards within
+ * each segment, and the window of any pixel spans the suffix of a segment and the prefix of the next. That's 3 comparisons per pixel and
+ * pass, whatever the size of the element. The vertical pass works on whole rows at a time, so it reads the storage sequentially.
+ *
+ * Rows of the horizontal pass, and columns of the vertical one, are spread across the workers of `scheduler` when one is given.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class Morphology {
+private:
+    unsigned int elementRows;
+    unsigned int elementColumns;
+    const MatrixPaddingStrategy<IEEE754_t>* paddingStrategy;
+
+    template<typename Select>
+    Channel<IEEE754_t>* applied(const Channel<IEEE754_t>* channel, Select select, WorkStealingScheduler* scheduler) const;
+
+public:
+    Morphology(unsigned int elementRows, unsigned int elementColumns, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy);
+
+    [[nodiscard]] unsigned int getElementRows() const;
+    [[nodiscard]] unsigned int getElementColumns() const;
+
+    Channel<IEEE754_t>* eroded(const Channel<IEEE754_t>* channel, WorkStealingScheduler* scheduler = nullptr) const;
+    Channel<IEEE754_t>* dilated(const Channel<IEEE754_t>* channel, WorkStealingScheduler* scheduler = nullptr) const;
+
+    // Erosion then dilation, which removes the bright features smaller than the element.
+    Channel<IEEE754_t>* opened(const Channel<IEEE754_t>* channel, WorkStealingScheduler* scheduler = nullptr) const;
+
+    // Dilation then erosion, which fills the dark features smaller than the element.
+    Channel<IEEE754_t>* closed(const Channel<IEEE754_t>* channel, WorkStealingScheduler* scheduler = nullptr) const;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef IMAGECONVOLUTIONKERNEL_BOUNDEDQUEUE_H
+#define IMAGECONVOLUTIONKERNEL_BOUNDEDQUEUE_H
+
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/*
+ * A blocking FIFO queue with a fixed capacity, used to connect the stages of a pipeline.
+ *
+ * - `push` blocks while the queue is full, and returns false if the queue was closed in the meantime.
+ * - `pop` blocks while the queue is empty, and returns an empty optional once the queue is closed and drained.
+ * - `close` wakes up every waiting producer and consumer. Elements already enqueued can still be popped.
+ *
+ * Unlike the rest of the project this class isn't bound to a floating point type, therefore it is implemented in the header.
+ */
+template<typename Element>
+class BoundedQueue {
+private:
+    std::deque<Element> elements;
+    unsigned int capacity;
+    bool isClosed = false;
+
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+
+public:
+    explicit BoundedQueue(unsigned int capacity) : capacity(capacity) {
+        assert(capacity > 0);
+    }
+
+    bool push(Element element) {
+        std::unique_lock lock(this->mutex);
+        this->notFull.wait(lock, [this] { return this->isClosed || this->elements.size() < this->capacity; });
+
+        if (this->isClosed) {
+            return false;
+        }
+
+        this->elements.push_back(std::move(element));
+        lock.unlock();
+        this->notEmpty.notify_one();
+
+        return true;
+    }
+
+    std::optional<Element> pop() {
+        std::unique_lock lock(this->mutex);
+        this->notEmpty.wait(lock, [this] { return this->isClosed || !this->elements.empty(); });
+
+        if (this->elements.empty()) {
+            return std::nullopt;
+        }
+
+        auto element = std::move(this->elements.front());
+        this->elements.pop_front();
+        lock.unlock();
+        this->notFull.notify_one();
+
+        return element;
+    }
+
+    void close() {
+        {
+            std::lock_guard lock(this->mutex);
+            this->isClosed = true;
+        }
+
+        this->notFull.notify_all();
+        this->notEmpty.notify_all();
+    }
+};
+
+#endif
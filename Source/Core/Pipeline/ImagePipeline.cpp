@@ -0,0 +1,111 @@
+#include "ImagePipeline.h"
+
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <semaphore>
+#include <thread>
+
+#include "BoundedQueue.h"
+#include "../Image/ImageFormats/PPM/PPMImage.h"
+#include "../Image/ImageFormats/PGM/PGMImage.h"
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+ImagePipeline<IEEE754_t, Derived>::ImagePipeline(
+    const ConvolutionKernel<IEEE754_t> *usingKernel,
+    const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy,
+    ImageChannelsEncoding outputEncoding,
+    unsigned int maxImagesInFlight,
+    unsigned int computeWorkers
+) : kernel(usingKernel), paddingStrategy(withPaddingStrategy), outputEncoding(outputEncoding), maxImagesInFlight(maxImagesInFlight), computeWorkers(computeWorkers) {
+    assert(usingKernel != nullptr);
+    assert(withPaddingStrategy != nullptr);
+    assert(maxImagesInFlight > 0);
+    assert(computeWorkers > 0);
+}
+
+/*
+ * Jobs are read in order, but with more than one compute worker they may be filtered and written out of order.
+ * The returned results are always in the same order as `jobs`. A job fails if its input can't be parsed or its output can't be written,
+ * and that doesn't affect the others.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+std::vector<ImagePipelineResult> ImagePipeline<IEEE754_t, Derived>::run(const std::vector<ImagePipelineJob> &jobs) const {
+    using StagedImage = std::pair<size_t, NetpbmImage<IEEE754_t, Derived>*>;
+
+    auto results = std::vector<ImagePipelineResult>();
+    for (const auto& job : jobs) {
+        results.push_back({job, false, ""});
+    }
+
+    BoundedQueue<StagedImage> loadedImages(this->maxImagesInFlight);
+    BoundedQueue<StagedImage> filteredImages(this->maxImagesInFlight);
+    std::counting_semaphore<> slotsInFlight(this->maxImagesInFlight);
+    std::atomic<unsigned int> runningComputeWorkers = this->computeWorkers;
+
+    std::jthread reader([&] {
+        for (size_t i = 0; i < jobs.size(); i++) {
+            slotsInFlight.acquire();
+
+            auto loadedImage = NetpbmImage<IEEE754_t, Derived>::loadImage(jobs[i].input);
+            if (loadedImage == nullptr) {
+                results[i].error = "Could not parse the input image";
+                slotsInFlight.release();
+                continue;
+            }
+
+            loadedImages.push({i, loadedImage});
+        }
+
+        loadedImages.close();
+    });
+
+    auto computeStage = std::vector<std::jthread>();
+    for (unsigned int worker = 0; worker < this->computeWorkers; worker++) {
+        computeStage.emplace_back([&] {
+            while (auto stagedImage = loadedImages.pop()) {
+                auto [jobIndex, sourceImage] = stagedImage.value();
+                auto filteredImage = sourceImage->filtered(this->kernel, this->paddingStrategy);
+                delete sourceImage;
+
+                filteredImages.push({jobIndex, filteredImage});
+            }
+
+            if (--runningComputeWorkers == 0) {
+                filteredImages.close();
+            }
+        });
+    }
+
+    std::jthread writer([&] {
+        while (auto stagedImage = filteredImages.pop()) {
+            auto [jobIndex, filteredImage] = stagedImage.value();
+
+            try {
+                filteredImage->writeToFile(jobs[jobIndex].output, this->outputEncoding);
+                results[jobIndex].succeeded = true;
+            } catch (const std::exception& error) {
+                results[jobIndex].error = error.what();
+            }
+
+            delete filteredImage;
+            slotsInFlight.release();
+        }
+    });
+
+    reader.join();
+    for (auto& worker : computeStage) {
+        worker.join();
+    }
+    writer.join();
+
+    return results;
+}
+
+template class ImagePipeline<float, PPMImage<float>>;
+template class ImagePipeline<double, PPMImage<double>>;
+template class ImagePipeline<long double, PPMImage<long double>>;
+
+template class ImagePipeline<float, PGMImage<float>>;
+template class ImagePipeline<double, PGMImage<double>>;
+template class ImagePipeline<long double, PGMImage<long double>>;
@@ -0,0 +1,57 @@
+#ifndef IMAGECONVOLUTIONKERNEL_IMAGEPIPELINE_H
+#define IMAGECONVOLUTIONKERNEL_IMAGEPIPELINE_H
+
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../Image/ImageFormats/NetpbmImage.h"
+
+/*
+ * A single unit of work for the pipeline: the image at `input` is loaded, filtered and written to `output`.
+ * As with `Image::writeToFile`, `output` is expected without extension, the one of the image format is appended.
+ */
+struct ImagePipelineJob {
+    std::filesystem::path input;
+    std::filesystem::path output;
+};
+
+struct ImagePipelineResult {
+    ImagePipelineJob job;
+    bool succeeded;
+    std::string error;
+};
+
+/*
+ * Runs a batch of read → filter → write jobs as three concurrent stages connected by bounded queues:
+ *
+ * - A reader thread that runs `loadImage` for each job, in order.
+ * - `computeWorkers` threads that run `filtered` on the loaded images.
+ * - A writer thread that runs `writeToFile` on the filtered images.
+ *
+ * This way disk reads and writes of an image overlap with the convolution of the others. At most `maxImagesInFlight` jobs
+ * are between the start of their load and the end of their write at any time, which caps the memory used by the batch.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+class ImagePipeline {
+private:
+    const ConvolutionKernel<IEEE754_t>* kernel;
+    const MatrixPaddingStrategy<IEEE754_t>* paddingStrategy;
+    ImageChannelsEncoding outputEncoding;
+    unsigned int maxImagesInFlight;
+    unsigned int computeWorkers;
+
+public:
+    ImagePipeline(
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        ImageChannelsEncoding outputEncoding,
+        unsigned int maxImagesInFlight = 4,
+        unsigned int computeWorkers = 1
+    );
+
+    [[nodiscard]] std::vector<ImagePipelineResult> run(const std::vector<ImagePipelineJob>& jobs) const;
+};
+
+#endif
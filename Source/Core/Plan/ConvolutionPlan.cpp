@@ -0,0 +1,242 @@
+#include "ConvolutionPlan.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <limits>
+#include <sstream>
+#include <typeinfo>
+
+#include "../Instrumentation/Instrumentation.h"
+#include "../Scheduler/Spans.h"
+
+namespace {
+    // Each candidate is timed this many times while measuring, and the best time kept, which filters out most of the scheduling noise.
+    constexpr int MEASURED_RUNS = 3;
+    constexpr size_t PLAN_MIN_ROWS_PER_SPAN = 16;
+
+    const char* layoutNameOf(MatrixLayout layout) {
+        switch (layout) {
+            case ROW_MAJOR:
+                return "rowmajor";
+            case COLUMN_MAJOR:
+                return "columnmajor";
+            case TILED:
+                return "tiled";
+        }
+
+        return "unknown";
+    }
+}
+
+/*
+ * The signature is what the choice of a strategy depends on: scalar type, kernel shape and separability, channel shape and layout, padding
+ * strategy, worker count and whether roundoff is allowed. Kernel values are left out, so e.g. all 5x5 gaussians share their wisdom.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+ConvolutionPlan<IEEE754_t>::ConvolutionPlan(const ConvolutionKernel<IEEE754_t> *usingKernel, unsigned int rows, unsigned int columns, MatrixLayout layout, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, PlanningMode mode, WorkStealingScheduler *scheduler, bool allowsRoundoff) :
+    kernel(usingKernel), paddingStrategy(withPaddingStrategy), rows(rows), columns(columns), layout(layout), scheduler(scheduler), allowsRoundoff(allowsRoundoff) {
+    assert(usingKernel != nullptr);
+    assert(withPaddingStrategy != nullptr);
+    assert(rows > 0 && columns > 0);
+    INSTRUMENTATION_SCOPE("ConvolutionPlan::plan");
+
+    auto signatureStream = std::ostringstream();
+    signatureStream << "f" << sizeof(IEEE754_t) * 8
+                    << ":k" << usingKernel->getRows() << "x" << usingKernel->getColumns() << (usingKernel->isSeparable() ? "s" : "")
+                    << ":c" << rows << "x" << columns << ":" << layoutNameOf(layout)
+                    << ":" << typeid(*withPaddingStrategy).name()
+                    << ":w" << (scheduler != nullptr ? scheduler->getWorkersCount() : 0)
+                    << ":" << (allowsRoundoff ? "roundoff" : "exact");
+    this->signature = signatureStream.str();
+
+    if (allowsRoundoff && usingKernel->getRows() == 3 && usingKernel->getColumns() == 3) {
+        this->winogradConvolution = new WinogradConvolution<IEEE754_t>(usingKernel);
+    }
+
+    auto& wisdom = ConvolutionWisdom::shared();
+    auto knownEntry = wisdom.lookup(this->signature);
+
+    if (knownEntry.has_value() && this->isCandidate(*knownEntry)) {
+        this->entry = *knownEntry;
+        this->isFromWisdom = true;
+    } else if (mode == PlanningMode::MEASURE) {
+        this->entry = this->measured();
+        wisdom.record(this->signature, this->entry);
+    } else {
+        this->entry = this->estimated();
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+ConvolutionPlan<IEEE754_t>::~ConvolutionPlan() {
+    delete this->winogradConvolution;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+std::vector<WisdomEntry> ConvolutionPlan<IEEE754_t>::candidates() const {
+    auto planCandidates = std::vector<WisdomEntry>{{ConvolutionStrategy::DIRECT, 1}};
+
+    if (this->scheduler != nullptr && this->rows > 1) {
+        // As many spans as workers, and a few spans per worker for stealing to even out the load.
+        auto workersSpans = std::min<unsigned int>(this->scheduler->getWorkersCount(), this->rows);
+        auto balancedSpans = static_cast<unsigned int>(spansCountFor(this->rows, PLAN_MIN_ROWS_PER_SPAN, this->scheduler));
+
+        for (auto spansCount : {workersSpans, balancedSpans}) {
+            auto candidate = WisdomEntry{ConvolutionStrategy::DIRECT_PARALLEL, spansCount};
+
+            if (spansCount > 1 && std::find(planCandidates.begin(), planCandidates.end(), candidate) == planCandidates.end()) {
+                planCandidates.push_back(candidate);
+            }
+        }
+    }
+
+    if (this->allowsRoundoff && this->kernel->isSeparable()) {
+        planCandidates.push_back({ConvolutionStrategy::SEPARABLE, 1});
+    }
+
+    if (this->winogradConvolution != nullptr) {
+        planCandidates.push_back({ConvolutionStrategy::WINOGRAD, 1});
+    }
+
+    return planCandidates;
+}
+
+/*
+ * Whether `candidate` can run this plan, e.g. wisdom recorded by a run with a scheduler can't be used by a plan without one.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+bool ConvolutionPlan<IEEE754_t>::isCandidate(const WisdomEntry &candidate) const {
+    switch (candidate.strategy) {
+        case ConvolutionStrategy::DIRECT:
+            return true;
+        case ConvolutionStrategy::DIRECT_PARALLEL:
+            return this->scheduler != nullptr && candidate.spansCount > 1 && candidate.spansCount <= this->rows;
+        case ConvolutionStrategy::SEPARABLE:
+            return this->allowsRoundoff && this->kernel->isSeparable();
+        case ConvolutionStrategy::WINOGRAD:
+            return this->winogradConvolution != nullptr;
+    }
+
+    return false;
+}
+
+/*
+ * Winograd saves the most multiplications, then separable passes pay off once the kernel is wide enough for O(k) to beat O(k^2) per pixel,
+ * then channels large enough are split across the workers.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+WisdomEntry ConvolutionPlan<IEEE754_t>::estimated() const {
+    if (this->winogradConvolution != nullptr) {
+        return {ConvolutionStrategy::WINOGRAD, 1};
+    }
+
+    if (this->allowsRoundoff && this->kernel->isSeparable() && std::min(this->kernel->getRows(), this->kernel->getColumns()) >= 5) {
+        return {ConvolutionStrategy::SEPARABLE, 1};
+    }
+
+    if (this->scheduler != nullptr && this->rows > 1 && static_cast<unsigned long long>(this->rows) * this->columns >= PLAN_PARALLEL_MIN_PIXELS) {
+        auto spansCount = static_cast<unsigned int>(spansCountFor(this->rows, PLAN_MIN_ROWS_PER_SPAN, this->scheduler));
+        if (spansCount > 1) {
+            return {ConvolutionStrategy::DIRECT_PARALLEL, spansCount};
+        }
+    }
+
+    return {ConvolutionStrategy::DIRECT, 1};
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+WisdomEntry ConvolutionPlan<IEEE754_t>::measured() const {
+    INSTRUMENTATION_SCOPE("ConvolutionPlan::measure");
+
+    auto values = Matrix<IEEE754_t>::random(this->rows, this->columns, this->layout);
+    auto channel = Channel<IEEE754_t>(255, &values);
+    auto destination = Channel<IEEE754_t>(255, this->rows, this->columns, this->layout);
+
+    auto fastest = WisdomEntry();
+    auto fastestTime = std::chrono::steady_clock::duration::max();
+
+    for (const auto& candidate : this->candidates()) {
+        for (int run = 0; run < MEASURED_RUNS; run++) {
+            auto start = std::chrono::steady_clock::now();
+            this->run(candidate, &channel, &destination);
+            auto time = std::chrono::steady_clock::now() - start;
+
+            if (time < fastestTime) {
+                fastestTime = time;
+                fastest = candidate;
+            }
+        }
+    }
+
+    return fastest;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void ConvolutionPlan<IEEE754_t>::run(const WisdomEntry &strategy, const Channel<IEEE754_t> *channel, Channel<IEEE754_t> *destination) const {
+    switch (strategy.strategy) {
+        case ConvolutionStrategy::DIRECT:
+            channel->filteredInto(destination, this->kernel, this->paddingStrategy);
+            break;
+        case ConvolutionStrategy::DIRECT_PARALLEL: {
+            destination->recycle(channel->getMaxTheoreticalValue());
+            auto elements = destination->getMutableElements();
+
+            forEachSpan(this->rows, strategy.spansCount, this->scheduler, [this, channel, elements](size_t, size_t begin, size_t end) {
+                channel->filterRowsInto(elements, begin, end, this->kernel, this->paddingStrategy);
+            });
+            break;
+        }
+        case ConvolutionStrategy::SEPARABLE: {
+            // Only grown, so that executing the plan again allocates nothing.
+            thread_local std::vector<IEEE754_t> scratch;
+
+            destination->recycle(channel->getMaxTheoreticalValue());
+            channel->filterStridedInto(destination->getMutableElements(), scratch, this->kernel, this->paddingStrategy, 1);
+            break;
+        }
+        case ConvolutionStrategy::WINOGRAD:
+            this->winogradConvolution->filteredInto(channel, destination, this->paddingStrategy);
+            break;
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+const std::string &ConvolutionPlan<IEEE754_t>::getSignature() const {
+    return this->signature;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+ConvolutionStrategy ConvolutionPlan<IEEE754_t>::getStrategy() const {
+    return this->entry.strategy;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int ConvolutionPlan<IEEE754_t>::getSpansCount() const {
+    return this->entry.spansCount;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+bool ConvolutionPlan<IEEE754_t>::isPlannedFromWisdom() const {
+    return this->isFromWisdom;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+bool ConvolutionPlan<IEEE754_t>::fits(const Channel<IEEE754_t> *channel) const {
+    return channel->getRows() == this->rows && channel->getColumns() == this->columns && channel->getMatrixLayout() == this->layout;
+}
+
+/*
+ * Filters `channel`, which must fit this plan, into `destination`, of the same size and layout.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void ConvolutionPlan<IEEE754_t>::execute(const Channel<IEEE754_t> *channel, Channel<IEEE754_t> *destination) const {
+    assert(channel != nullptr && this->fits(channel));
+    assert(destination != nullptr && destination != channel && this->fits(destination));
+
+    this->run(this->entry, channel, destination);
+}
+
+template class ConvolutionPlan<float>;
+template class ConvolutionPlan<double>;
+template class ConvolutionPlan<long double>;
@@ -0,0 +1,79 @@
+#ifndef IMAGECONVOLUTIONKERNEL_CONVOLUTIONPLAN_H
+#define IMAGECONVOLUTIONKERNEL_CONVOLUTIONPLAN_H
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ConvolutionWisdom.h"
+#include "../Channel/Channel.h"
+#include "../Winograd/WinogradConvolution.h"
+
+enum class PlanningMode {
+    // Picks a strategy from the shapes alone, which costs nothing.
+    ESTIMATE,
+    // Times every candidate strategy on a random channel of the planned shape, and records the fastest in the wisdom.
+    MEASURE
+};
+
+// The smallest channel, in pixels, an estimated plan splits across the workers of its scheduler.
+constexpr unsigned int PLAN_PARALLEL_MIN_PIXELS = 1 << 16;
+
+/*
+ * How to filter channels of a given size and layout with a given kernel and padding strategy, decided once so that filtering with the
+ * plan (see `Channel::filtered(const ConvolutionPlan*)`) only dispatches on the chosen strategy.
+ *
+ * The candidates are the direct engine (`Channel::filterRowsInto`), split in row spans across the workers of `scheduler` when there's one,
+ * and, when `allowsRoundoff` is set, the separable two pass engine for separable kernels and `WinogradConvolution` for 3x3 ones; the
+ * latter two only match `Channel::filtered` up to rounding, so exact plans never pick them.
+ *
+ * Planning first looks the signature up in `ConvolutionWisdom::shared()`, and only estimates or measures when the wisdom doesn't know it.
+ * The kernel, padding strategy and scheduler must outlive the plan. Executing a plan is thread safe, unless it runs on a scheduler.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class ConvolutionPlan {
+private:
+    const ConvolutionKernel<IEEE754_t>* kernel;
+    const MatrixPaddingStrategy<IEEE754_t>* paddingStrategy;
+    unsigned int rows;
+    unsigned int columns;
+    MatrixLayout layout;
+    WorkStealingScheduler* scheduler;
+    bool allowsRoundoff;
+
+    std::string signature;
+    WisdomEntry entry;
+    bool isFromWisdom = false;
+    WinogradConvolution<IEEE754_t>* winogradConvolution = nullptr;
+
+    [[nodiscard]] std::vector<WisdomEntry> candidates() const;
+    [[nodiscard]] bool isCandidate(const WisdomEntry& candidate) const;
+    [[nodiscard]] WisdomEntry estimated() const;
+    [[nodiscard]] WisdomEntry measured() const;
+    void run(const WisdomEntry& strategy, const Channel<IEEE754_t>* channel, Channel<IEEE754_t>* destination) const;
+
+public:
+    ConvolutionPlan(
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        unsigned int rows,
+        unsigned int columns,
+        MatrixLayout layout,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy,
+        PlanningMode mode = PlanningMode::ESTIMATE,
+        WorkStealingScheduler* scheduler = nullptr,
+        bool allowsRoundoff = false
+    );
+    ConvolutionPlan(const ConvolutionPlan&) = delete;
+    ConvolutionPlan& operator=(const ConvolutionPlan&) = delete;
+    ~ConvolutionPlan();
+
+    [[nodiscard]] const std::string& getSignature() const;
+    [[nodiscard]] ConvolutionStrategy getStrategy() const;
+    [[nodiscard]] unsigned int getSpansCount() const;
+    [[nodiscard]] bool isPlannedFromWisdom() const;
+
+    [[nodiscard]] bool fits(const Channel<IEEE754_t>* channel) const;
+    void execute(const Channel<IEEE754_t>* channel, Channel<IEEE754_t>* destination) const;
+};
+
+#endif
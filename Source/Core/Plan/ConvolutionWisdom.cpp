@@ -0,0 +1,112 @@
+#include "ConvolutionWisdom.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace {
+    constexpr const char* STRATEGY_NAMES[] = {"direct", "parallel", "separable", "winograd"};
+}
+
+// A function local static avoids depending on the initialization order of globals across translation units.
+ConvolutionWisdom &ConvolutionWisdom::shared() {
+    static ConvolutionWisdom sharedWisdom;
+    return sharedWisdom;
+}
+
+const char *ConvolutionWisdom::nameOf(ConvolutionStrategy strategy) {
+    return STRATEGY_NAMES[static_cast<int>(strategy)];
+}
+
+std::optional<ConvolutionStrategy> ConvolutionWisdom::strategyNamed(const std::string &name) {
+    for (int i = 0; i < static_cast<int>(std::size(STRATEGY_NAMES)); i++) {
+        if (name == STRATEGY_NAMES[i]) {
+            return static_cast<ConvolutionStrategy>(i);
+        }
+    }
+
+    return std::nullopt;
+}
+
+/*
+ * False if the file couldn't be read. Blank lines, lines starting with '#' and malformed lines are skipped, so that a file written by a
+ * version knowing other strategies still loads what this one understands.
+ */
+bool ConvolutionWisdom::load(const std::filesystem::path &path) {
+    auto file = std::ifstream(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    auto loadedEntries = std::map<std::string, WisdomEntry>();
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        auto fields = std::istringstream(line);
+        std::string signature;
+        std::string strategyName;
+        unsigned int spansCount = 0;
+
+        if (!(fields >> signature >> strategyName >> spansCount) || spansCount == 0) {
+            continue;
+        }
+
+        auto strategy = strategyNamed(strategyName);
+        if (strategy.has_value()) {
+            loadedEntries[signature] = {*strategy, spansCount};
+        }
+    }
+
+    std::lock_guard lock(this->mutex);
+    for (const auto& [signature, entry] : loadedEntries) {
+        this->entries[signature] = entry;
+    }
+
+    return true;
+}
+
+bool ConvolutionWisdom::save(const std::filesystem::path &path) const {
+    auto file = std::ofstream(path, std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "# ImageConvolutionKernel wisdom: <signature> <strategy> <spans count>\n";
+
+    std::lock_guard lock(this->mutex);
+    for (const auto& [signature, entry] : this->entries) {
+        file << signature << ' ' << nameOf(entry.strategy) << ' ' << entry.spansCount << '\n';
+    }
+
+    file.flush();
+    return file.good();
+}
+
+std::optional<WisdomEntry> ConvolutionWisdom::lookup(const std::string &signature) const {
+    std::lock_guard lock(this->mutex);
+
+    auto entry = this->entries.find(signature);
+    if (entry == this->entries.end()) {
+        return std::nullopt;
+    }
+
+    return entry->second;
+}
+
+void ConvolutionWisdom::record(const std::string &signature, const WisdomEntry &entry) {
+    std::lock_guard lock(this->mutex);
+    this->entries[signature] = entry;
+}
+
+void ConvolutionWisdom::forget() {
+    std::lock_guard lock(this->mutex);
+    this->entries.clear();
+}
+
+size_t ConvolutionWisdom::getEntriesCount() const {
+    std::lock_guard lock(this->mutex);
+    return this->entries.size();
+}
@@ -0,0 +1,56 @@
+#ifndef IMAGECONVOLUTIONKERNEL_CONVOLUTIONWISDOM_H
+#define IMAGECONVOLUTIONKERNEL_CONVOLUTIONWISDOM_H
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+/*
+ * The engines a `ConvolutionPlan` can run a convolution with.
+ */
+enum class ConvolutionStrategy {
+    DIRECT = 0,
+    DIRECT_PARALLEL = 1,
+    SEPARABLE = 2,
+    WINOGRAD = 3
+};
+
+struct WisdomEntry {
+    ConvolutionStrategy strategy = ConvolutionStrategy::DIRECT;
+    unsigned int spansCount = 1;
+
+    bool operator==(const WisdomEntry&) const = default;
+};
+
+/*
+ * What measuring plans found out: the fastest strategy for each plan signature (see `ConvolutionPlan::getSignature`), so that plans of
+ * the same signature created later, including by later runs once saved and loaded back, skip the measurements.
+ *
+ * Wisdom files are text, one "<signature> <strategy> <spans count>" line per signature. Loading merges the file into the entries already
+ * known, the file winning on conflicts. Signatures embed the scalar type, the shapes and the worker count but not the CPU, so wisdom
+ * shouldn't be carried over to another machine. Thread safe.
+ */
+class ConvolutionWisdom {
+private:
+    mutable std::mutex mutex;
+    std::map<std::string, WisdomEntry> entries;
+
+public:
+    static ConvolutionWisdom& shared();
+
+    [[nodiscard]] static const char* nameOf(ConvolutionStrategy strategy);
+    [[nodiscard]] static std::optional<ConvolutionStrategy> strategyNamed(const std::string& name);
+
+    bool load(const std::filesystem::path& path);
+    bool save(const std::filesystem::path& path) const;
+
+    [[nodiscard]] std::optional<WisdomEntry> lookup(const std::string& signature) const;
+    void record(const std::string& signature, const WisdomEntry& entry);
+    void forget();
+
+    [[nodiscard]] size_t getEntriesCount() const;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "ChannelPool.h"
+
+#include <cassert>
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+ChannelPool<IEEE754_t>::ChannelPool(unsigned int maxPooledChannelsPerSize) : maxPooledChannelsPerSize(maxPooledChannelsPerSize) {
+
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+ChannelPool<IEEE754_t>::~ChannelPool() {
+    for (auto& [_, channels] : this->buckets) {
+        for (auto channel : channels) {
+            delete channel;
+        }
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *ChannelPool<IEEE754_t>::acquire(unsigned int maxValue, unsigned int rows, unsigned int columns, MatrixLayout layout) {
+    {
+        std::lock_guard lock(this->mutex);
+        auto bucket = this->buckets.find({rows, columns, layout});
+
+        if (bucket != this->buckets.end() && !bucket->second.empty()) {
+            auto channel = bucket->second.back();
+            bucket->second.pop_back();
+            this->reusedChannels++;
+
+            channel->recycle(maxValue);
+            return channel;
+        }
+
+        this->allocatedChannels++;
+    }
+
+    auto elements = std::vector<IEEE754_t>(rows * columns, 0);
+    return new Channel<IEEE754_t>(maxValue, elements.data(), rows, columns, layout);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void ChannelPool<IEEE754_t>::release(Channel<IEEE754_t> *channel) {
+    assert(channel != nullptr);
+
+    {
+        std::lock_guard lock(this->mutex);
+        auto& bucket = this->buckets[{channel->getRows(), channel->getColumns(), channel->getMatrixLayout()}];
+
+        if (bucket.size() < this->maxPooledChannelsPerSize) {
+            bucket.push_back(channel);
+            return;
+        }
+    }
+
+    delete channel;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned long long ChannelPool<IEEE754_t>::getAllocatedChannelsCount() const {
+    std::lock_guard lock(this->mutex);
+    return this->allocatedChannels;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned long long ChannelPool<IEEE754_t>::getReusedChannelsCount() const {
+    std::lock_guard lock(this->mutex);
+    return this->reusedChannels;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int ChannelPool<IEEE754_t>::getPooledChannelsCount() const {
+    std::lock_guard lock(this->mutex);
+
+    unsigned int pooledChannels = 0;
+    for (const auto& [_, channels] : this->buckets) {
+        pooledChannels += channels.size();
+    }
+
+    return pooledChannels;
+}
+
+template class ChannelPool<float>;
+template class ChannelPool<double>;
+template class ChannelPool<long double>;
@@ -0,0 +1,51 @@
+#ifndef IMAGECONVOLUTIONKERNEL_CHANNELPOOL_H
+#define IMAGECONVOLUTIONKERNEL_CHANNELPOOL_H
+
+#include <compare>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "../Channel/Channel.h"
+
+/*
+ * Recycles channels, bucketed by size and layout, for long lived services that filter images of a few recurring sizes.
+ *
+ * `acquire` returns a released channel of the requested size when there's one, and only allocates otherwise; `release` gives a channel back
+ * instead of deleting it, up to `maxPooledChannelsPerSize` channels per bucket. Acquired channels hold stale values, they're meant to be
+ * overwritten (e.g. by `Channel::filteredInto` or `Channel::clampedInto`). Channels still in the pool are deleted along with it. All the methods are thread safe.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class ChannelPool {
+public:
+    struct Key {
+        unsigned int rows;
+        unsigned int columns;
+        MatrixLayout layout;
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+private:
+    mutable std::mutex mutex;
+    std::map<Key, std::vector<Channel<IEEE754_t>*>> buckets;
+    unsigned int maxPooledChannelsPerSize;
+    unsigned long long allocatedChannels = 0;
+    unsigned long long reusedChannels = 0;
+
+public:
+    explicit ChannelPool(unsigned int maxPooledChannelsPerSize = 64);
+    ChannelPool(const ChannelPool&) = delete;
+    ChannelPool& operator=(const ChannelPool&) = delete;
+    ~ChannelPool();
+
+    Channel<IEEE754_t>* acquire(unsigned int maxValue, unsigned int rows, unsigned int columns, MatrixLayout layout = ROW_MAJOR);
+    void release(Channel<IEEE754_t>* channel);
+
+    [[nodiscard]] unsigned long long getAllocatedChannelsCount() const;
+    [[nodiscard]] unsigned long long getReusedChannelsCount() const;
+    [[nodiscard]] unsigned int getPooledChannelsCount() const;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#include "ImagePool.h"
+
+#include <cassert>
+
+#include "../Image/ImageFormats/PPM/PPMImage.h"
+#include "../Image/ImageFormats/PGM/PGMImage.h"
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+ImagePool<IEEE754_t, Derived>::ImagePool(unsigned int maxPooledImagesPerSize) : maxPooledImagesPerSize(maxPooledImagesPerSize) {
+
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+ImagePool<IEEE754_t, Derived>::~ImagePool() {
+    for (auto& [_, images] : this->buckets) {
+        for (auto image : images) {
+            delete image;
+        }
+    }
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+typename ImagePool<IEEE754_t, Derived>::Key ImagePool<IEEE754_t, Derived>::keyOf(const NetpbmImage<IEEE754_t, Derived> *image) {
+    assert(image != nullptr && image->getChannelsCount() > 0);
+    return {image->getWidth(), image->getHeight(), image->getChannelsCount(), image->getChannel(0)->getMatrixLayout()};
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+NetpbmImage<IEEE754_t, Derived> *ImagePool<IEEE754_t, Derived>::acquire(const NetpbmImage<IEEE754_t, Derived> *shapedLike) {
+    auto key = keyOf(shapedLike);
+
+    {
+        std::lock_guard lock(this->mutex);
+        auto bucket = this->buckets.find(key);
+
+        if (bucket != this->buckets.end() && !bucket->second.empty()) {
+            auto image = bucket->second.back();
+            bucket->second.pop_back();
+            this->reusedImages++;
+
+            return image;
+        }
+
+        this->allocatedImages++;
+    }
+
+    auto elements = std::vector<IEEE754_t>(key.width * key.height, 0);
+    auto channels = std::vector<Channel<IEEE754_t>*>();
+
+    for (unsigned int i = 0; i < key.channelsCount; i++) {
+        auto maxValue = shapedLike->getChannel(i)->getMaxTheoreticalValue();
+        channels.push_back(new Channel<IEEE754_t>(maxValue, elements.data(), key.height, key.width, key.layout));
+    }
+
+    return NetpbmImage<IEEE754_t, Derived>::withChannels(key.width, key.height, channels);
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+void ImagePool<IEEE754_t, Derived>::release(NetpbmImage<IEEE754_t, Derived> *image) {
+    auto key = keyOf(image);
+
+    {
+        std::lock_guard lock(this->mutex);
+        auto& bucket = this->buckets[key];
+
+        if (bucket.size() < this->maxPooledImagesPerSize) {
+            bucket.push_back(image);
+            return;
+        }
+    }
+
+    delete image;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+unsigned long long ImagePool<IEEE754_t, Derived>::getAllocatedImagesCount() const {
+    std::lock_guard lock(this->mutex);
+    return this->allocatedImages;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+unsigned long long ImagePool<IEEE754_t, Derived>::getReusedImagesCount() const {
+    std::lock_guard lock(this->mutex);
+    return this->reusedImages;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+unsigned int ImagePool<IEEE754_t, Derived>::getPooledImagesCount() const {
+    std::lock_guard lock(this->mutex);
+
+    unsigned int pooledImages = 0;
+    for (const auto& [_, images] : this->buckets) {
+        pooledImages += images.size();
+    }
+
+    return pooledImages;
+}
+
+template class ImagePool<float, PPMImage<float>>;
+template class ImagePool<double, PPMImage<double>>;
+template class ImagePool<long double, PPMImage<long double>>;
+
+template class ImagePool<float, PGMImage<float>>;
+template class ImagePool<double, PGMImage<double>>;
+template class ImagePool<long double, PGMImage<long double>>;
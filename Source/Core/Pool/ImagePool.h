@@ -0,0 +1,52 @@
+#ifndef IMAGECONVOLUTIONKERNEL_IMAGEPOOL_H
+#define IMAGECONVOLUTIONKERNEL_IMAGEPOOL_H
+
+#include <compare>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "../Image/ImageFormats/NetpbmImage.h"
+
+/*
+ * Same as `ChannelPool`, for whole images: `acquire` returns an image with the size, number of channels and layout of `shapedLike`, to be
+ * filtered into (see `NetpbmImage::filteredInto`). Together with the scratch buffers that filtering keeps per thread, a service that serves
+ * images of a few recurring sizes stops allocating once every size has been seen.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+class ImagePool {
+public:
+    struct Key {
+        unsigned int width;
+        unsigned int height;
+        unsigned int channelsCount;
+        MatrixLayout layout;
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+private:
+    mutable std::mutex mutex;
+    std::map<Key, std::vector<NetpbmImage<IEEE754_t, Derived>*>> buckets;
+    unsigned int maxPooledImagesPerSize;
+    unsigned long long allocatedImages = 0;
+    unsigned long long reusedImages = 0;
+
+    static Key keyOf(const NetpbmImage<IEEE754_t, Derived>* image);
+
+public:
+    explicit ImagePool(unsigned int maxPooledImagesPerSize = 16);
+    ImagePool(const ImagePool&) = delete;
+    ImagePool& operator=(const ImagePool&) = delete;
+    ~ImagePool();
+
+    NetpbmImage<IEEE754_t, Derived>* acquire(const NetpbmImage<IEEE754_t, Derived>* shapedLike);
+    void release(NetpbmImage<IEEE754_t, Derived>* image);
+
+    [[nodiscard]] unsigned long long getAllocatedImagesCount() const;
+    [[nodiscard]] unsigned long long getReusedImagesCount() const;
+    [[nodiscard]] unsigned int getPooledImagesCount() const;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "GaussianPyramid.h"
+
+#include <cassert>
+
+#include "../ConvolutionKernel/KernelCache/KernelCache.h"
+#include "../Instrumentation/Instrumentation.h"
+#include "../Image/ImageFormats/PPM/PPMImage.h"
+#include "../Image/ImageFormats/PGM/PGMImage.h"
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+GaussianPyramid<IEEE754_t, Derived>::GaussianPyramid(const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy, unsigned int kernelSize, IEEE754_t sigma)
+    : kernel(KernelCache<IEEE754_t>::gaussianKernel(kernelSize, sigma)), paddingStrategy(withPaddingStrategy) {
+    assert(withPaddingStrategy != nullptr);
+}
+
+/*
+ * Returns `levelsCount` new images, the first one being half the size of `image`, the second a quarter and so on.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+std::vector<NetpbmImage<IEEE754_t, Derived> *> GaussianPyramid<IEEE754_t, Derived>::levels(const NetpbmImage<IEEE754_t, Derived> *image, unsigned int levelsCount) const {
+    assert(image != nullptr);
+    INSTRUMENTATION_SCOPE("GaussianPyramid::levels");
+
+    auto width = image->getWidth();
+    auto height = image->getHeight();
+
+    auto levelElements = new IEEE754_t[Channel<IEEE754_t>::stridedSize(width, 2) * Channel<IEEE754_t>::stridedSize(height, 2)];
+    auto scratch = std::vector<IEEE754_t>();
+
+    auto pyramidLevels = std::vector<NetpbmImage<IEEE754_t, Derived> *>();
+    auto previousLevel = image;
+
+    for (unsigned int level = 0; level < levelsCount; level++) {
+        width = Channel<IEEE754_t>::stridedSize(width, 2);
+        height = Channel<IEEE754_t>::stridedSize(height, 2);
+
+        auto channels = std::vector<Channel<IEEE754_t> *>();
+        for (unsigned int k = 0; k < previousLevel->getChannelsCount(); k++) {
+            auto channel = previousLevel->getChannel(k);
+            channel->filterStridedInto(levelElements, scratch, this->kernel, this->paddingStrategy, 2);
+
+            channels.push_back(new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), levelElements, height, width, channel->getMatrixLayout()));
+        }
+
+        pyramidLevels.push_back(NetpbmImage<IEEE754_t, Derived>::withChannels(width, height, channels));
+        previousLevel = pyramidLevels.back();
+    }
+
+    delete[] levelElements;
+    return pyramidLevels;
+}
+
+template class GaussianPyramid<float, PPMImage<float>>;
+template class GaussianPyramid<double, PPMImage<double>>;
+template class GaussianPyramid<long double, PPMImage<long double>>;
+
+template class GaussianPyramid<float, PGMImage<float>>;
+template class GaussianPyramid<double, PGMImage<double>>;
+template class GaussianPyramid<long double, PGMImage<long double>>;
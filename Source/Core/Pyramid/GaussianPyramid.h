@@ -0,0 +1,29 @@
+#ifndef IMAGECONVOLUTIONKERNEL_GAUSSIANPYRAMID_H
+#define IMAGECONVOLUTIONKERNEL_GAUSSIANPYRAMID_H
+
+#include <type_traits>
+#include <vector>
+
+#include "../Image/ImageFormats/NetpbmImage.h"
+
+/*
+ * Builds the levels of a gaussian pyramid: each level is the previous one blurred with a `kernelSize` x `kernelSize` gaussian kernel of
+ * standard deviation `sigma`, and halved along both axes (rounding up).
+ *
+ * Blurring and halving happen in the same pass (`Channel::filterStridedInto`), so only a quarter of the pixels of each level are filtered,
+ * and the gaussian being separable, each of them costs O(kernelSize) operations. The buffers used by the passes are allocated once for the
+ * largest level, and reused by every channel of every level.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+class GaussianPyramid {
+private:
+    const ConvolutionKernel<IEEE754_t>* kernel;
+    const MatrixPaddingStrategy<IEEE754_t>* paddingStrategy;
+
+public:
+    explicit GaussianPyramid(const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy, unsigned int kernelSize = 5, IEEE754_t sigma = 1);
+
+    [[nodiscard]] std::vector<NetpbmImage<IEEE754_t, Derived>*> levels(const NetpbmImage<IEEE754_t, Derived>* image, unsigned int levelsCount) const;
+};
+
+#endif
@@ -0,0 +1,191 @@
+#include "RankFilter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../Instrumentation/Instrumentation.h"
+
+namespace {
+    // Column histograms of a stripe take at most this many counters, 8 MiB.
+    constexpr size_t maxStripeCounters = 1 << 22;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+RankFilter<IEEE754_t>::RankFilter(unsigned int radius, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) : radius(radius), paddingStrategy(withPaddingStrategy) {
+    assert(withPaddingStrategy != nullptr);
+    assert(radius < 128);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int RankFilter<IEEE754_t>::getRadius() const {
+    return this->radius;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int RankFilter<IEEE754_t>::getWindowSize() const {
+    return (2 * this->radius + 1) * (2 * this->radius + 1);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *RankFilter<IEEE754_t>::filtered(const Channel<IEEE754_t> *channel, unsigned int rank) const {
+    assert(channel != nullptr);
+    assert(rank < this->getWindowSize());
+    assert(channel->getMaxTheoreticalValue() < 65536);
+    INSTRUMENTATION_SCOPE("RankFilter::filtered");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, channel->getRows() * channel->getColumns());
+
+    auto rows = channel->getRows();
+    auto columns = channel->getColumns();
+    auto layout = channel->getMatrixLayout();
+    auto maxValue = channel->getMaxTheoreticalValue();
+
+    auto radius = static_cast<int>(this->radius);
+    auto span = 2 * radius + 1;
+
+    // 16 buckets of 16 values for 8 bit channels, 256 of 256 values for 16 bit ones.
+    auto fineBits = maxValue < 256 ? 4u : 8u;
+    auto fineSize = 1u << fineBits;
+    auto coarseSize = (maxValue >> fineBits) + 1;
+    auto binsCount = coarseSize * fineSize;
+
+    auto filteredChannel = new Channel<IEEE754_t>(maxValue, rows, columns, layout);
+    auto destination = filteredChannel->getMutableElements();
+
+    auto stripeWidth = static_cast<unsigned int>(std::clamp<size_t>(maxStripeCounters / binsCount, 1, columns));
+
+    auto rowBins = std::vector<uint16_t>();
+    auto columnCoarse = std::vector<uint16_t>();
+    auto columnFine = std::vector<uint16_t>();
+    auto windowCoarse = std::vector<uint32_t>(coarseSize);
+    auto windowFine = std::vector<uint32_t>(binsCount);
+    auto lastUpdatedColumn = std::vector<int>(coarseSize);
+
+    for (unsigned int stripeColumn = 0; stripeColumn < columns; stripeColumn += stripeWidth) {
+        auto stripeColumns = std::min(stripeWidth, columns - stripeColumn);
+        auto paddedColumns = static_cast<int>(stripeColumns) + 2 * radius;
+
+        rowBins.resize(paddedColumns);
+        columnCoarse.assign(paddedColumns * coarseSize, 0);
+        columnFine.assign(paddedColumns * binsCount, 0);
+
+        // Adds (or removes, with `step` = -1) the values of a row of the image to the column histograms of the stripe.
+        auto updateColumns = [&](int row, int step) {
+            for (int paddedColumn = 0; paddedColumn < paddedColumns; paddedColumn++) {
+                auto column = static_cast<int>(stripeColumn) + paddedColumn - radius;
+                auto isInside = row >= 0 && row < static_cast<int>(rows) && column >= 0 && column < static_cast<int>(columns);
+                auto value = isInside ? channel->at(row, column) : this->paddingStrategy->pad(*channel, row, column);
+
+                rowBins[paddedColumn] = static_cast<uint16_t>(std::clamp(std::round(value), static_cast<IEEE754_t>(0), static_cast<IEEE754_t>(maxValue)));
+            }
+
+            for (int paddedColumn = 0; paddedColumn < paddedColumns; paddedColumn++) {
+                auto bin = rowBins[paddedColumn];
+
+                columnCoarse[paddedColumn * coarseSize + (bin >> fineBits)] += step;
+                columnFine[paddedColumn * binsCount + bin] += step;
+            }
+        };
+
+        for (int row = -radius; row < radius; row++) {
+            updateColumns(row, 1);
+        }
+
+        for (int row = 0; row < static_cast<int>(rows); row++) {
+            updateColumns(row + radius, 1);
+            if (row > 0) {
+                updateColumns(row - radius - 1, -1);
+            }
+
+            std::fill(windowCoarse.begin(), windowCoarse.end(), 0);
+            for (int paddedColumn = 0; paddedColumn < span; paddedColumn++) {
+                for (unsigned int bucket = 0; bucket < coarseSize; bucket++) {
+                    windowCoarse[bucket] += columnCoarse[paddedColumn * coarseSize + bucket];
+                }
+            }
+
+            // Fine buckets are out of date until the rank lands in them.
+            std::fill(lastUpdatedColumn.begin(), lastUpdatedColumn.end(), -span);
+
+            for (int column = 0; column < static_cast<int>(stripeColumns); column++) {
+                if (column > 0) {
+                    auto enteringCoarse = columnCoarse.data() + (column + span - 1) * coarseSize;
+                    auto leavingCoarse = columnCoarse.data() + (column - 1) * coarseSize;
+
+                    for (unsigned int bucket = 0; bucket < coarseSize; bucket++) {
+                        windowCoarse[bucket] += enteringCoarse[bucket] - leavingCoarse[bucket];
+                    }
+                }
+
+                unsigned int bucket = 0;
+                unsigned int valuesBelow = 0;
+                while (valuesBelow + windowCoarse[bucket] <= rank) {
+                    valuesBelow += windowCoarse[bucket];
+                    bucket++;
+                }
+
+                auto fine = windowFine.data() + bucket * fineSize;
+                auto stepsBehind = column - lastUpdatedColumn[bucket];
+
+                if (2 * stepsBehind >= span) {
+                    std::fill(fine, fine + fineSize, 0);
+
+                    for (int paddedColumn = column; paddedColumn < column + span; paddedColumn++) {
+                        auto columnBucket = columnFine.data() + paddedColumn * binsCount + bucket * fineSize;
+                        for (unsigned int bin = 0; bin < fineSize; bin++) {
+                            fine[bin] += columnBucket[bin];
+                        }
+                    }
+                } else {
+                    for (int step = lastUpdatedColumn[bucket] + 1; step <= column; step++) {
+                        auto enteringBucket = columnFine.data() + (step + span - 1) * binsCount + bucket * fineSize;
+                        auto leavingBucket = columnFine.data() + (step - 1) * binsCount + bucket * fineSize;
+
+                        for (unsigned int bin = 0; bin < fineSize; bin++) {
+                            fine[bin] += enteringBucket[bin] - leavingBucket[bin];
+                        }
+                    }
+                }
+
+                lastUpdatedColumn[bucket] = column;
+
+                unsigned int bin = 0;
+                while (valuesBelow + fine[bin] <= rank) {
+                    valuesBelow += fine[bin];
+                    bin++;
+                }
+
+                destination[flatIndexOf(row, stripeColumn + column, rows, columns, layout)] = static_cast<IEEE754_t>(bucket * fineSize + bin);
+            }
+        }
+    }
+
+    return filteredChannel;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *RankFilter<IEEE754_t>::median(const Channel<IEEE754_t> *channel) const {
+    return this->filtered(channel, this->getWindowSize() / 2);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *RankFilter<IEEE754_t>::minimum(const Channel<IEEE754_t> *channel) const {
+    return this->filtered(channel, 0);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *RankFilter<IEEE754_t>::maximum(const Channel<IEEE754_t> *channel) const {
+    return this->filtered(channel, this->getWindowSize() - 1);
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *RankFilter<IEEE754_t>::percentile(const Channel<IEEE754_t> *channel, IEEE754_t percentile) const {
+    assert(percentile >= 0 && percentile <= 100);
+    return this->filtered(channel, static_cast<unsigned int>(std::lround(percentile / 100 * (this->getWindowSize() - 1))));
+}
+
+template class RankFilter<float>;
+template class RankFilter<double>;
+template class RankFilter<long double>;
@@ -0,0 +1,48 @@
+#ifndef IMAGECONVOLUTIONKERNEL_RANKFILTER_H
+#define IMAGECONVOLUTIONKERNEL_RANKFILTER_H
+
+#include <type_traits>
+
+#include "../Channel/Channel.h"
+
+/*
+ * Rank-order filters over the (2 · radius + 1)² window around each pixel: the output is the value of a given rank among the window values,
+ * e.g. the median, which removes salt-and-pepper noise while keeping edges sharp. Values out of the channel come from the padding strategy,
+ * as for `Channel::filtered`.
+ *
+ * Values are counted in histograms, after being rounded and saturated like filtered values are, so the channels are expected to hold
+ * integers of up to 16 bits (a maximum value below 65536). Following Perreault and Hébert (Median Filtering in Constant Time, 2007), each
+ * column keeps the histogram of its 2 · radius + 1 values around the current row, and the window histogram slides along the row by adding
+ * the column entering it and subtracting the one leaving it. Histograms are two-level: the coarse one is kept up to date on every step,
+ * while each bucket of the fine one is only brought up to date when the rank lands in it. The cost per pixel doesn't depend on the radius.
+ *
+ * Column histograms take (maxValue + 1) counters each, so wide 16 bit channels are processed in vertical stripes to bound the memory.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class RankFilter {
+private:
+    unsigned int radius;
+    const MatrixPaddingStrategy<IEEE754_t>* paddingStrategy;
+
+public:
+    RankFilter(unsigned int radius, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy);
+
+    [[nodiscard]] unsigned int getRadius() const;
+    [[nodiscard]] unsigned int getWindowSize() const;
+
+    /*
+     * The value of rank `rank` (0 is the minimum, `getWindowSize() - 1` the maximum) in the window of each pixel.
+     */
+    Channel<IEEE754_t>* filtered(const Channel<IEEE754_t>* channel, unsigned int rank) const;
+
+    Channel<IEEE754_t>* median(const Channel<IEEE754_t>* channel) const;
+    Channel<IEEE754_t>* minimum(const Channel<IEEE754_t>* channel) const;
+    Channel<IEEE754_t>* maximum(const Channel<IEEE754_t>* channel) const;
+
+    /*
+     * `percentile` in [0, 100]: the rank is the nearest one to percentile / 100 · (getWindowSize() - 1).
+     */
+    Channel<IEEE754_t>* percentile(const Channel<IEEE754_t>* channel, IEEE754_t percentile) const;
+};
+
+#endif
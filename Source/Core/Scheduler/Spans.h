@@ -0,0 +1,46 @@
+#ifndef IMAGECONVOLUTIONKERNEL_SPANS_H
+#define IMAGECONVOLUTIONKERNEL_SPANS_H
+
+#include <algorithm>
+#include <cstddef>
+
+#include "WorkStealingScheduler.h"
+
+// Below this many values per task, spreading a pass over the values of a channel across workers costs more than it saves.
+constexpr size_t MIN_VALUES_PER_TASK = 1 << 15;
+
+/*
+ * How many spans to split `itemsCount` independent items into: one without a scheduler, otherwise enough to keep its workers busy
+ * (a few per worker, for stealing to even out the load), but never fewer than `minimumItemsPerSpan` items each.
+ */
+inline size_t spansCountFor(size_t itemsCount, size_t minimumItemsPerSpan, const WorkStealingScheduler* scheduler) {
+    if (scheduler == nullptr) {
+        return 1;
+    }
+
+    return std::clamp<size_t>(itemsCount / minimumItemsPerSpan, 1, scheduler->getWorkersCount() * 4);
+}
+
+/*
+ * Splits [0, itemsCount[ in `spansCount` contiguous spans and calls `visit(spanIndex, begin, end)` for each of them, on the workers
+ * of `scheduler` when there's more than one span.
+ */
+template<typename Visit>
+void forEachSpan(size_t itemsCount, size_t spansCount, WorkStealingScheduler* scheduler, Visit visit) {
+    if (spansCount <= 1) {
+        visit(0, 0, itemsCount);
+        return;
+    }
+
+    auto spanSize = (itemsCount + spansCount - 1) / spansCount;
+    for (size_t span = 0; span < spansCount; span++) {
+        auto begin = std::min(itemsCount, span * spanSize);
+        auto end = std::min(itemsCount, begin + spanSize);
+
+        scheduler->submit([&visit, span, begin, end] { visit(span, begin, end); });
+    }
+
+    scheduler->wait();
+}
+
+#endif
@@ -0,0 +1,188 @@
+#include "WorkStealingScheduler.h"
+
+#include <cassert>
+#include <chrono>
+
+namespace {
+    // Allows `submit` to tell whether it's being called from a task, and in that case which worker is running it.
+    thread_local const WorkStealingScheduler* currentScheduler = nullptr;
+    thread_local unsigned int currentWorkerIndex = 0;
+}
+
+WorkStealingScheduler::WorkStealingScheduler(unsigned int workersCount) {
+    if (workersCount == 0) {
+        workersCount = 1;
+    }
+
+    for (unsigned int i = 0; i < workersCount; i++) {
+        this->workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (unsigned int i = 0; i < workersCount; i++) {
+        this->threads.emplace_back([this, i] { this->runWorker(i); });
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    {
+        std::lock_guard lock(this->sleepMutex);
+        this->isStopping = true;
+    }
+    this->wakeUp.notify_all();
+
+    for (auto& thread : this->threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingScheduler::submit(Task task) {
+    auto workerIndex = currentScheduler == this ?
+        currentWorkerIndex
+            :
+        static_cast<unsigned int>(this->nextWorker++ % this->workers.size());
+
+    // Counted before the task is visible, so that a worker taking it right away can't decrement the counter below zero. In the meantime, a
+    // worker may see a queued task it can't find yet: it just tries again instead of going to sleep.
+    this->pendingTasks++;
+    this->queuedTasks++;
+    {
+        std::lock_guard lock(this->workers[workerIndex]->mutex);
+        this->workers[workerIndex]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard lock(this->sleepMutex);
+    }
+    this->wakeUp.notify_one();
+}
+
+/*
+ * Blocks until every submitted task, including the ones submitted by other tasks in the meantime, has completed.
+ * If any task threw, the first exception is rethrown here.
+ */
+void WorkStealingScheduler::wait() {
+    assert(currentScheduler != this && "Waiting from within a task would deadlock the worker");
+
+    std::unique_lock lock(this->completionMutex);
+    this->allTasksCompleted.wait(lock, [this] { return this->pendingTasks == 0; });
+
+    if (this->firstFailure) {
+        auto failure = this->firstFailure;
+        this->firstFailure = nullptr;
+        std::rethrow_exception(failure);
+    }
+}
+
+void WorkStealingScheduler::runWorker(unsigned int workerIndex) {
+    currentScheduler = this;
+    currentWorkerIndex = workerIndex;
+
+    auto& worker = *this->workers[workerIndex];
+
+    while (true) {
+        Task task;
+        if (this->popOwnTask(workerIndex, task) || this->stealTask(workerIndex, task)) {
+            this->queuedTasks--;
+            this->execute(workerIndex, task);
+            continue;
+        }
+
+        std::unique_lock lock(this->sleepMutex);
+        if (this->isStopping) {
+            break;
+        }
+
+        if (this->queuedTasks == 0) {
+            auto idleStart = std::chrono::steady_clock::now();
+            worker.idleWaits++;
+
+            this->wakeUp.wait(lock, [this] { return this->isStopping || this->queuedTasks > 0; });
+
+            worker.idleNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - idleStart).count();
+        }
+    }
+}
+
+bool WorkStealingScheduler::popOwnTask(unsigned int workerIndex, Task &task) {
+    auto& worker = *this->workers[workerIndex];
+    std::lock_guard lock(worker.mutex);
+
+    if (worker.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+/*
+ * Victims are visited starting from the worker next to the thief, so that thieves don't all contend for the same deque.
+ */
+bool WorkStealingScheduler::stealTask(unsigned int thiefIndex, Task &task) {
+    auto& thief = *this->workers[thiefIndex];
+
+    for (unsigned int offset = 1; offset < this->workers.size(); offset++) {
+        auto& victim = *this->workers[(thiefIndex + offset) % this->workers.size()];
+        std::lock_guard lock(victim.mutex);
+
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            thief.stolenTasks++;
+            return true;
+        }
+    }
+
+    if (this->workers.size() > 1) {
+        thief.failedSteals++;
+    }
+
+    return false;
+}
+
+void WorkStealingScheduler::execute(unsigned int workerIndex, Task &task) {
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard lock(this->completionMutex);
+        if (!this->firstFailure) {
+            this->firstFailure = std::current_exception();
+        }
+    }
+
+    this->workers[workerIndex]->executedTasks++;
+
+    if (--this->pendingTasks == 0) {
+        std::lock_guard lock(this->completionMutex);
+        this->allTasksCompleted.notify_all();
+    }
+}
+
+unsigned int WorkStealingScheduler::getWorkersCount() const {
+    return this->workers.size();
+}
+
+WorkStealingSchedulerStatistics WorkStealingScheduler::getStatistics() const {
+    WorkStealingSchedulerStatistics statistics;
+
+    for (const auto& worker : this->workers) {
+        statistics.executedTasks += worker->executedTasks;
+        statistics.stolenTasks += worker->stolenTasks;
+        statistics.failedSteals += worker->failedSteals;
+        statistics.idleWaits += worker->idleWaits;
+        statistics.idleNanoseconds += worker->idleNanoseconds;
+    }
+
+    return statistics;
+}
+
+void WorkStealingScheduler::resetStatistics() {
+    for (const auto& worker : this->workers) {
+        worker->executedTasks = 0;
+        worker->stolenTasks = 0;
+        worker->failedSteals = 0;
+        worker->idleWaits = 0;
+        worker->idleNanoseconds = 0;
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef IMAGECONVOLUTIONKERNEL_WORKSTEALINGSCHEDULER_H
+#define IMAGECONVOLUTIONKERNEL_WORKSTEALINGSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct WorkStealingSchedulerStatistics {
+    unsigned long long executedTasks = 0;
+    unsigned long long stolenTasks = 0;
+    unsigned long long failedSteals = 0;
+    unsigned long long idleWaits = 0;
+    unsigned long long idleNanoseconds = 0;
+};
+
+/*
+ * A fixed pool of worker threads, each owning a deque of tasks.
+ *
+ * A worker pops tasks from the back of its own deque (most recently pushed first, which keeps data hot in its cache),
+ * and when that is empty it steals from the front of the other workers' deques. Tasks submitted from within a task go to the
+ * deque of the worker running it, tasks submitted from any other thread are spread round-robin across the workers.
+ *
+ * Statistics are kept per worker and summed on request; a high number of steals or idle waits usually means the submitted
+ * tasks are too coarse (or too few) for the number of workers.
+ */
+class WorkStealingScheduler {
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct Worker {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+
+        std::atomic<unsigned long long> executedTasks = 0;
+        std::atomic<unsigned long long> stolenTasks = 0;
+        std::atomic<unsigned long long> failedSteals = 0;
+        std::atomic<unsigned long long> idleWaits = 0;
+        std::atomic<unsigned long long> idleNanoseconds = 0;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::atomic<unsigned long long> nextWorker = 0;
+    std::atomic<unsigned long long> queuedTasks = 0;
+    std::atomic<unsigned long long> pendingTasks = 0;
+    bool isStopping = false;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+
+    std::mutex completionMutex;
+    std::condition_variable allTasksCompleted;
+    std::exception_ptr firstFailure;
+
+    void runWorker(unsigned int workerIndex);
+    bool popOwnTask(unsigned int workerIndex, Task& task);
+    bool stealTask(unsigned int thiefIndex, Task& task);
+    void execute(unsigned int workerIndex, Task& task);
+
+public:
+    explicit WorkStealingScheduler(unsigned int workersCount = std::thread::hardware_concurrency());
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+    ~WorkStealingScheduler();
+
+    void submit(Task task);
+    void wait();
+
+    [[nodiscard]] unsigned int getWorkersCount() const;
+    [[nodiscard]] WorkStealingSchedulerStatistics getStatistics() const;
+    void resetStatistics();
+};
+
+#endif
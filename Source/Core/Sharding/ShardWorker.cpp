@@ -0,0 +1,137 @@
+#include "ShardWorker.h"
+
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../Channel/Channel.h"
+#include "../MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../Instrumentation/Instrumentation.h"
+
+bool ShardTransport::readFully(int descriptor, void *buffer, size_t size) {
+    auto bytes = static_cast<char*>(buffer);
+
+    while (size > 0) {
+        auto received = read(descriptor, bytes, size);
+
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (received <= 0) {
+            return false;
+        }
+
+        bytes += received;
+        size -= received;
+    }
+
+    return true;
+}
+
+/*
+ * Sockets are written with MSG_NOSIGNAL, so that a peer that went away is a failed write rather than a SIGPIPE killing the process; other
+ * descriptors (e.g. pipes) fall back to plain writes.
+ */
+bool ShardTransport::writeFully(int descriptor, const void *buffer, size_t size) {
+    auto bytes = static_cast<const char*>(buffer);
+    auto isSocket = true;
+
+    while (size > 0) {
+        auto written = isSocket ? send(descriptor, bytes, size, MSG_NOSIGNAL) : write(descriptor, bytes, size);
+
+        if (written < 0 && isSocket && errno == ENOTSOCK) {
+            isSocket = false;
+            continue;
+        }
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (written <= 0) {
+            return false;
+        }
+
+        bytes += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int ShardWorker<IEEE754_t>::serve(int input, int output) {
+    // Blocks come with their halo, the padding strategy is never asked for a value.
+    auto paddingStrategy = ZeroPaddingMatrixPaddingStrategy<IEEE754_t>();
+    auto servedRequests = 0u;
+
+    auto kernelValues = std::vector<IEEE754_t>();
+    auto maxValues = std::vector<uint32_t>();
+    auto block = std::vector<IEEE754_t>();
+    auto reply = std::vector<IEEE754_t>();
+
+    ShardRequestHeader header{};
+    while (ShardTransport::readFully(input, &header, sizeof(header))) {
+        auto isValid = header.magic == SHARD_REQUEST_MAGIC
+            && header.sampleSize == sizeof(IEEE754_t)
+            && header.channelsCount > 0 && header.kernelRows > 0 && header.kernelColumns > 0
+            && header.interiorRows > 0 && header.interiorColumns > 0
+            && header.haloTop + header.interiorRows <= header.blockRows
+            && header.haloLeft + header.interiorColumns <= header.blockColumns;
+
+        if (!isValid) {
+            break;
+        }
+
+        INSTRUMENTATION_SCOPE("ShardWorker::serve");
+
+        auto blockSize = static_cast<size_t>(header.blockRows) * header.blockColumns;
+        auto interiorSize = static_cast<size_t>(header.interiorRows) * header.interiorColumns;
+
+        kernelValues.resize(static_cast<size_t>(header.kernelRows) * header.kernelColumns);
+        maxValues.resize(header.channelsCount);
+        block.resize(blockSize);
+        reply.resize(interiorSize * header.channelsCount);
+
+        if (!ShardTransport::readFully(input, kernelValues.data(), kernelValues.size() * sizeof(IEEE754_t))
+            || !ShardTransport::readFully(input, maxValues.data(), maxValues.size() * sizeof(uint32_t))) {
+            break;
+        }
+
+        auto kernel = ConvolutionKernel<IEEE754_t>(kernelValues.data(), header.kernelRows, header.kernelColumns);
+        auto interior = MatrixRegion{header.haloTop, header.haloLeft, header.interiorRows, header.interiorColumns};
+        auto isComplete = true;
+
+        for (uint32_t i = 0; i < header.channelsCount && isComplete; i++) {
+            isComplete = ShardTransport::readFully(input, block.data(), blockSize * sizeof(IEEE754_t));
+
+            if (isComplete) {
+                auto channel = Channel<IEEE754_t>::borrowing(maxValues[i], block.data(), header.blockRows, header.blockColumns);
+                auto filteredChannel = channel->filteredRegion(interior, &kernel, &paddingStrategy);
+
+                for (uint32_t row = 0; row < header.interiorRows; row++) {
+                    for (uint32_t column = 0; column < header.interiorColumns; column++) {
+                        reply[i * interiorSize + row * header.interiorColumns + column] = filteredChannel->at(row, column);
+                    }
+                }
+
+                delete filteredChannel;
+                delete channel;
+            }
+        }
+
+        if (!isComplete || !ShardTransport::writeFully(output, reply.data(), reply.size() * sizeof(IEEE754_t))) {
+            break;
+        }
+
+        servedRequests++;
+    }
+
+    return servedRequests;
+}
+
+template class ShardWorker<float>;
+template class ShardWorker<double>;
+template class ShardWorker<long double>;
@@ -0,0 +1,56 @@
+#ifndef IMAGECONVOLUTIONKERNEL_SHARDWORKER_H
+#define IMAGECONVOLUTIONKERNEL_SHARDWORKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * What a shard request starts with. It's followed by the kernel values (`kernelRows` x `kernelColumns`, row-major), the maximum value of
+ * each channel (as `uint32_t`), and the `channelsCount` blocks of `blockRows` x `blockColumns` samples (row-major) to filter.
+ *
+ * A block is a strip of the image grown by the halo the kernel reaches out of it on every side, already padded, so a worker needs neither
+ * the rest of the image nor the padding strategy. The reply is the `interiorRows` x `interiorColumns` filtered samples of each
+ * channel, row-major, without the halo.
+ */
+struct ShardRequestHeader {
+    uint32_t magic;
+    uint32_t sampleSize;
+    uint32_t channelsCount;
+    uint32_t blockRows;
+    uint32_t blockColumns;
+    uint32_t haloTop;
+    uint32_t haloLeft;
+    uint32_t interiorRows;
+    uint32_t interiorColumns;
+    uint32_t kernelRows;
+    uint32_t kernelColumns;
+};
+
+constexpr uint32_t SHARD_REQUEST_MAGIC = 0x44524853;
+
+namespace ShardTransport {
+    /*
+     * Reads or writes exactly `size` bytes, retrying short transfers. False if the descriptor was closed or failed before that.
+     */
+    bool readFully(int descriptor, void* buffer, size_t size);
+    bool writeFully(int descriptor, const void* buffer, size_t size);
+}
+
+/*
+ * The worker side of `ShardedConvolution`: reads shard requests from a file descriptor, filters each block with `Channel::filteredRegion`
+ * (the regular engine, so results match filtering the whole image) and writes the replies to another one.
+ *
+ * Only plain reads and writes are involved, so the descriptors can be pipes to a forked process, as `ShardedConvolution` does, or sockets
+ * to a worker running on another host.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class ShardWorker {
+public:
+    /*
+     * Serves requests until `input` is closed or a malformed request is read. Returns the number of requests served.
+     */
+    static unsigned int serve(int input, int output);
+};
+
+#endif
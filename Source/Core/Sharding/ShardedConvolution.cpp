@@ -0,0 +1,244 @@
+#include "ShardedConvolution.h"
+
+#include <cassert>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../Image/ImageFormats/PPM/PPMImage.h"
+#include "../Image/ImageFormats/PGM/PGMImage.h"
+#include "../Instrumentation/Instrumentation.h"
+
+/*
+ * Each worker only keeps its own end of its own connection: were it to inherit the ends of the workers forked before it, closing them
+ * here wouldn't be seen as the end of the requests by those workers.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+ShardedConvolution<IEEE754_t>::ShardedConvolution(unsigned int workersCount) {
+    assert(workersCount > 0);
+
+    for (unsigned int i = 0; i < workersCount; i++) {
+        int connections[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, connections) != 0) {
+            break;
+        }
+
+        auto pid = fork();
+
+        if (pid == 0) {
+            close(connections[0]);
+            for (const auto& worker : this->workers) {
+                close(worker.connection);
+            }
+
+            ShardWorker<IEEE754_t>::serve(connections[1], connections[1]);
+            _exit(0);
+        }
+
+        close(connections[1]);
+
+        if (pid < 0) {
+            close(connections[0]);
+            break;
+        }
+
+        this->workers.push_back({pid, connections[0]});
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+ShardedConvolution<IEEE754_t>::~ShardedConvolution() {
+    this->releaseWorkers();
+}
+
+/*
+ * Closing the connections ends the requests of the workers, which then exit.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void ShardedConvolution<IEEE754_t>::releaseWorkers() {
+    for (const auto& worker : this->workers) {
+        close(worker.connection);
+    }
+
+    for (const auto& worker : this->workers) {
+        waitpid(worker.pid, nullptr, 0);
+    }
+
+    this->workers.clear();
+}
+
+/*
+ * Can be lower than requested, if the system couldn't create as many processes, and is 0 once a worker couldn't be reached.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+unsigned int ShardedConvolution<IEEE754_t>::getWorkersCount() const {
+    return this->workers.size();
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+std::vector<Channel<IEEE754_t>*> ShardedConvolution<IEEE754_t>::filtered(std::span<const Channel<IEEE754_t>* const> channels, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) {
+    assert(!channels.empty());
+    assert(usingKernel != nullptr);
+    assert(withPaddingStrategy != nullptr);
+    INSTRUMENTATION_SCOPE("ShardedConvolution::filtered");
+
+    if (this->workers.empty()) {
+        return {};
+    }
+
+    auto rows = static_cast<int>(channels[0]->getRows());
+    auto columns = static_cast<int>(channels[0]->getColumns());
+    auto layout = channels[0]->getMatrixLayout();
+    auto channelsCount = static_cast<unsigned int>(channels.size());
+
+    for (auto channel : channels) {
+        assert(channel->getRows() == channels[0]->getRows() && channel->getColumns() == channels[0]->getColumns() && channel->getMatrixLayout() == layout);
+    }
+
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, static_cast<unsigned long long>(rows) * columns * channelsCount);
+
+    auto lowerRowOffset = usingKernel->getLowerBoundRowIndex();
+    auto upperRowOffset = usingKernel->getUpperBoundRowIndex();
+    auto lowerColumnOffset = usingKernel->getLowerBoundColumnIndex();
+    auto upperColumnOffset = usingKernel->getUpperBoundColumnIndex();
+
+    auto kernelValues = std::vector<IEEE754_t>();
+    for (int i = lowerRowOffset; i <= upperRowOffset; i++) {
+        for (int j = lowerColumnOffset; j <= upperColumnOffset; j++) {
+            kernelValues.push_back(usingKernel->getValue(i, j));
+        }
+    }
+
+    auto maxValues = std::vector<uint32_t>();
+    for (auto channel : channels) {
+        maxValues.push_back(channel->getMaxTheoreticalValue());
+    }
+
+    auto stripsCount = std::min<unsigned int>(this->workers.size(), rows);
+    auto firstRowOf = [rows, stripsCount](unsigned int strip) {
+        return static_cast<int>(static_cast<long long>(strip) * rows / stripsCount);
+    };
+
+    auto blockColumns = columns + upperColumnOffset - lowerColumnOffset;
+    auto block = std::vector<IEEE754_t>();
+    auto isSent = true;
+
+    for (unsigned int strip = 0; strip < stripsCount && isSent; strip++) {
+        auto firstRow = firstRowOf(strip);
+        auto stripRows = firstRowOf(strip + 1) - firstRow;
+        auto blockRows = stripRows + upperRowOffset - lowerRowOffset;
+
+        auto header = ShardRequestHeader{
+            SHARD_REQUEST_MAGIC,
+            sizeof(IEEE754_t),
+            channelsCount,
+            static_cast<uint32_t>(blockRows),
+            static_cast<uint32_t>(blockColumns),
+            static_cast<uint32_t>(-lowerRowOffset),
+            static_cast<uint32_t>(-lowerColumnOffset),
+            static_cast<uint32_t>(stripRows),
+            static_cast<uint32_t>(columns),
+            usingKernel->getRows(),
+            usingKernel->getColumns()
+        };
+
+        auto connection = this->workers[strip].connection;
+        isSent = ShardTransport::writeFully(connection, &header, sizeof(header))
+            && ShardTransport::writeFully(connection, kernelValues.data(), kernelValues.size() * sizeof(IEEE754_t))
+            && ShardTransport::writeFully(connection, maxValues.data(), maxValues.size() * sizeof(uint32_t));
+
+        block.resize(static_cast<size_t>(blockRows) * blockColumns);
+
+        for (unsigned int k = 0; k < channelsCount && isSent; k++) {
+            auto channel = channels[k];
+            auto elements = channel->getElements();
+
+            for (int i = 0; i < blockRows; i++) {
+                auto inputRow = firstRow + lowerRowOffset + i;
+
+                for (int j = 0; j < blockColumns; j++) {
+                    auto inputColumn = lowerColumnOffset + j;
+                    auto isWithinChannel = inputRow >= 0 && inputRow < rows && inputColumn >= 0 && inputColumn < columns;
+
+                    block[static_cast<size_t>(i) * blockColumns + j] = isWithinChannel ?
+                        elements[flatIndexOf(inputRow, inputColumn, rows, columns, layout)] :
+                        withPaddingStrategy->pad(*channel, inputRow, inputColumn);
+                }
+            }
+
+            isSent = ShardTransport::writeFully(connection, block.data(), block.size() * sizeof(IEEE754_t));
+        }
+    }
+
+    auto filteredChannels = std::vector<Channel<IEEE754_t>*>();
+    for (auto channel : channels) {
+        filteredChannels.push_back(new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), rows, columns, layout));
+    }
+
+    auto reply = std::vector<IEEE754_t>();
+    auto isReceived = isSent;
+
+    for (unsigned int strip = 0; strip < stripsCount && isReceived; strip++) {
+        auto firstRow = firstRowOf(strip);
+        auto stripRows = firstRowOf(strip + 1) - firstRow;
+        auto stripSize = static_cast<size_t>(stripRows) * columns;
+
+        reply.resize(stripSize * channelsCount);
+        isReceived = ShardTransport::readFully(this->workers[strip].connection, reply.data(), reply.size() * sizeof(IEEE754_t));
+
+        for (unsigned int k = 0; k < channelsCount && isReceived; k++) {
+            auto elements = filteredChannels[k]->getMutableElements();
+
+            for (int row = 0; row < stripRows; row++) {
+                for (int column = 0; column < columns; column++) {
+                    elements[flatIndexOf(firstRow + row, column, rows, columns, layout)] = reply[k * stripSize + static_cast<size_t>(row) * columns + column];
+                }
+            }
+        }
+    }
+
+    // Past a failed send or receive, some workers may still have a reply pending, which the next call would read as its own.
+    if (!isReceived) {
+        for (auto channel : filteredChannels) {
+            delete channel;
+        }
+
+        this->releaseWorkers();
+        return {};
+    }
+
+    return filteredChannels;
+}
+
+/*
+ * nullptr if a worker couldn't be reached.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+template<typename Derived>
+NetpbmImage<IEEE754_t, Derived> *ShardedConvolution<IEEE754_t>::filtered(const NetpbmImage<IEEE754_t, Derived> *image, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) {
+    assert(image != nullptr);
+
+    auto channels = std::vector<const Channel<IEEE754_t>*>();
+    for (unsigned int i = 0; i < image->getChannelsCount(); i++) {
+        channels.push_back(image->getChannel(i));
+    }
+
+    auto filteredChannels = this->filtered(std::span<const Channel<IEEE754_t>* const>(channels), usingKernel, withPaddingStrategy);
+    if (filteredChannels.empty()) {
+        return nullptr;
+    }
+
+    return NetpbmImage<IEEE754_t, Derived>::withChannels(image->getWidth(), image->getHeight(), filteredChannels);
+}
+
+template class ShardedConvolution<float>;
+template class ShardedConvolution<double>;
+template class ShardedConvolution<long double>;
+
+template NetpbmImage<float, PPMImage<float>>* ShardedConvolution<float>::filtered(const NetpbmImage<float, PPMImage<float>>*, const ConvolutionKernel<float>*, const MatrixPaddingStrategy<float>*);
+template NetpbmImage<double, PPMImage<double>>* ShardedConvolution<double>::filtered(const NetpbmImage<double, PPMImage<double>>*, const ConvolutionKernel<double>*, const MatrixPaddingStrategy<double>*);
+template NetpbmImage<long double, PPMImage<long double>>* ShardedConvolution<long double>::filtered(const NetpbmImage<long double, PPMImage<long double>>*, const ConvolutionKernel<long double>*, const MatrixPaddingStrategy<long double>*);
+
+template NetpbmImage<float, PGMImage<float>>* ShardedConvolution<float>::filtered(const NetpbmImage<float, PGMImage<float>>*, const ConvolutionKernel<float>*, const MatrixPaddingStrategy<float>*);
+template NetpbmImage<double, PGMImage<double>>* ShardedConvolution<double>::filtered(const NetpbmImage<double, PGMImage<double>>*, const ConvolutionKernel<double>*, const MatrixPaddingStrategy<double>*);
+template NetpbmImage<long double, PGMImage<long double>>* ShardedConvolution<long double>::filtered(const NetpbmImage<long double, PGMImage<long double>>*, const ConvolutionKernel<long double>*, const MatrixPaddingStrategy<long double>*);
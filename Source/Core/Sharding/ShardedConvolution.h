@@ -0,0 +1,65 @@
+#ifndef IMAGECONVOLUTIONKERNEL_SHARDEDCONVOLUTION_H
+#define IMAGECONVOLUTIONKERNEL_SHARDEDCONVOLUTION_H
+
+#include <span>
+#include <sys/types.h>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest_prod.h>
+
+#include "ShardWorker.h"
+#include "../Image/ImageFormats/NetpbmImage.h"
+
+/*
+ * Filters images too large for one process by splitting them into horizontal strips, one per worker process.
+ *
+ * Each worker is forked once, when this object is built, and is sent only its strip grown by the kernel halo (see `ShardRequestHeader`),
+ * then filters it with the regular engine and sends back the filtered strip, which is stitched into the output. The halo is padded here,
+ * with the padding strategy of the call, so the output matches `Channel::filtered` on the whole image exactly, whatever the strategy.
+ *
+ * Workers talk to this process over plain stream sockets (see `ShardWorker`), so moving them to other hosts only changes how the
+ * connections are made. The strips of a call are all sent before any reply is read, so the workers run concurrently. Not thread safe:
+ * concurrent calls must use separate instances.
+ *
+ * If any worker can't be reached during a call, all of them are stopped: the call and every later one return nothing, and
+ * `getWorkersCount` drops to 0.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class ShardedConvolution {
+private:
+    struct Worker {
+        pid_t pid;
+        int connection;
+    };
+
+    std::vector<Worker> workers;
+
+    void releaseWorkers();
+
+    FRIEND_TEST(ShardedConvolutionTests, LosingAWorkerStopsThemAll);
+public:
+    explicit ShardedConvolution(unsigned int workersCount);
+    ShardedConvolution(const ShardedConvolution&) = delete;
+    ShardedConvolution& operator=(const ShardedConvolution&) = delete;
+    ~ShardedConvolution();
+
+    [[nodiscard]] unsigned int getWorkersCount() const;
+
+    /*
+     * The filtered `channels`, which must all have the same size and layout. Empty if a worker couldn't be reached, or had been before.
+     */
+    std::vector<Channel<IEEE754_t>*> filtered(
+        std::span<const Channel<IEEE754_t>* const> channels,
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy
+    );
+
+    template<typename Derived>
+    NetpbmImage<IEEE754_t, Derived>* filtered(
+        const NetpbmImage<IEEE754_t, Derived>* image,
+        const ConvolutionKernel<IEEE754_t>* usingKernel,
+        const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy
+    );
+};
+
+#endif
@@ -0,0 +1,320 @@
+#include "SharedImage.h"
+
+#include <cassert>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../Image/ImageFormats/PPM/PPMImage.h"
+#include "../Image/ImageFormats/PGM/PGMImage.h"
+#include "../Instrumentation/Instrumentation.h"
+
+namespace {
+    constexpr uint32_t SHARED_IMAGE_MAGIC = 0x534B4349;
+    constexpr uint32_t SHARED_IMAGE_VERSION = 1;
+
+    // Room for the header, rounded up so that the samples are aligned for any sample type and cache line aligned.
+    constexpr uint64_t SHARED_IMAGE_SAMPLES_OFFSET = 64;
+    static_assert(sizeof(SharedImageHeader) <= SHARED_IMAGE_SAMPLES_OFFSET);
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+SharedImage<IEEE754_t, Derived>::SharedImage(const std::string &name, void *mapping, size_t mappingSize, const SharedImageHeader &checkedHeader) :
+    name(name),
+    header(static_cast<SharedImageHeader*>(mapping)),
+    mappingSize(mappingSize),
+    width(checkedHeader.width),
+    height(checkedHeader.height),
+    channelsCount(checkedHeader.channelsCount),
+    layout(static_cast<MatrixLayout>(checkedHeader.layout)),
+    arrangement(checkedHeader.arrangement),
+    samples(reinterpret_cast<IEEE754_t*>(static_cast<char*>(mapping) + SHARED_IMAGE_SAMPLES_OFFSET)) {
+
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+SharedImage<IEEE754_t, Derived>::~SharedImage() {
+    munmap(this->header, this->mappingSize);
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+SampleType SharedImage<IEEE754_t, Derived>::sampleTypeOf() {
+    switch (std::numeric_limits<IEEE754_t>::digits) {
+        case std::numeric_limits<float>::digits:
+            return SampleType::FLOAT32;
+        case std::numeric_limits<double>::digits:
+            return SampleType::FLOAT64;
+        default:
+            return SampleType::EXTENDED;
+    }
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+size_t SharedImage<IEEE754_t, Derived>::mappingSizeOf(unsigned int width, unsigned int height, unsigned int channelsCount) {
+    return SHARED_IMAGE_SAMPLES_OFFSET + static_cast<size_t>(width) * height * channelsCount * sizeof(IEEE754_t);
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+size_t SharedImage<IEEE754_t, Derived>::sampleIndexOf(unsigned int channel, unsigned int row, unsigned int column) const {
+    if (this->arrangement == SampleArrangement::INTERLEAVED) {
+        return (static_cast<size_t>(row) * this->width + column) * this->channelsCount + channel;
+    }
+
+    return static_cast<size_t>(channel) * this->width * this->height + flatIndexOf(row, column, this->height, this->width, this->layout);
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+SharedImage<IEEE754_t, Derived> *SharedImage<IEEE754_t, Derived>::create(const std::string &name, unsigned int width, unsigned int height, unsigned int channelsCount, unsigned int maxValue, MatrixLayout layout, SampleArrangement arrangement) {
+    assert(width > 0 && height > 0 && channelsCount > 0);
+    assert(arrangement == SampleArrangement::PLANAR || layout == ROW_MAJOR);
+
+    auto descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (descriptor < 0) {
+        return nullptr;
+    }
+
+    auto mappingSize = mappingSizeOf(width, height, channelsCount);
+    auto mapping = ftruncate(descriptor, static_cast<off_t>(mappingSize)) == 0 ?
+        mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0)
+            :
+        MAP_FAILED;
+    close(descriptor);
+
+    if (mapping == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    auto header = SharedImageHeader{
+        SHARED_IMAGE_MAGIC,
+        SHARED_IMAGE_VERSION,
+        width,
+        height,
+        channelsCount,
+        maxValue,
+        static_cast<uint32_t>(layout),
+        arrangement,
+        sampleTypeOf(),
+        sizeof(IEEE754_t),
+        SHARED_IMAGE_SAMPLES_OFFSET
+    };
+    *static_cast<SharedImageHeader*>(mapping) = header;
+
+    return new SharedImage(name, mapping, mappingSize, header);
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+SharedImage<IEEE754_t, Derived> *SharedImage<IEEE754_t, Derived>::publish(const std::string &name, const NetpbmImage<IEEE754_t, Derived> *image, SampleArrangement arrangement) {
+    assert(image != nullptr && image->getChannelsCount() > 0);
+
+    auto layout = arrangement == SampleArrangement::PLANAR ? image->getChannel(0)->getMatrixLayout() : ROW_MAJOR;
+    auto sharedImage = create(name, image->getWidth(), image->getHeight(), image->getChannelsCount(), image->getChannel(0)->getMaxTheoreticalValue(), layout, arrangement);
+
+    if (sharedImage != nullptr) {
+        sharedImage->store(image);
+    }
+
+    return sharedImage;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+SharedImage<IEEE754_t, Derived> *SharedImage<IEEE754_t, Derived>::open(const std::string &name) {
+    auto descriptor = shm_open(name.c_str(), O_RDWR, 0);
+    if (descriptor < 0) {
+        return nullptr;
+    }
+
+    struct stat status{};
+    auto segmentSize = fstat(descriptor, &status) == 0 ? static_cast<size_t>(status.st_size) : 0;
+
+    if (segmentSize < SHARED_IMAGE_SAMPLES_OFFSET) {
+        close(descriptor);
+        return nullptr;
+    }
+
+    auto mapping = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // The pixels count can't overflow, being the product of two 32 bit values; the checks are ordered so that mappingSizeOf can't either.
+    // They run on a copy of the header, the only one this image reads afterwards, so that another process can't change what was checked.
+    auto maxSamplesCount = (std::numeric_limits<size_t>::max() - SHARED_IMAGE_SAMPLES_OFFSET) / sizeof(IEEE754_t);
+    auto header = *static_cast<const SharedImageHeader*>(mapping);
+    auto isValid = header.magic == SHARED_IMAGE_MAGIC
+        && header.version == SHARED_IMAGE_VERSION
+        && header.sampleType == sampleTypeOf()
+        && header.sampleSize == sizeof(IEEE754_t)
+        && header.samplesOffset == SHARED_IMAGE_SAMPLES_OFFSET
+        && (header.arrangement == SampleArrangement::PLANAR || header.arrangement == SampleArrangement::INTERLEAVED)
+        && (header.layout == ROW_MAJOR || header.layout == COLUMN_MAJOR || header.layout == TILED)
+        && (header.arrangement == SampleArrangement::PLANAR || header.layout == ROW_MAJOR)
+        && header.width > 0 && header.height > 0 && header.channelsCount > 0
+        && static_cast<size_t>(header.width) * header.height <= maxSamplesCount / header.channelsCount
+        && segmentSize >= mappingSizeOf(header.width, header.height, header.channelsCount);
+
+    if (!isValid) {
+        munmap(mapping, segmentSize);
+        return nullptr;
+    }
+
+    return new SharedImage(name, mapping, segmentSize, header);
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+bool SharedImage<IEEE754_t, Derived>::remove(const std::string &name) {
+    return shm_unlink(name.c_str()) == 0;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+const std::string &SharedImage<IEEE754_t, Derived>::getName() const {
+    return this->name;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+unsigned int SharedImage<IEEE754_t, Derived>::getWidth() const {
+    return this->width;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+unsigned int SharedImage<IEEE754_t, Derived>::getHeight() const {
+    return this->height;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+unsigned int SharedImage<IEEE754_t, Derived>::getChannelsCount() const {
+    return this->channelsCount;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+unsigned int SharedImage<IEEE754_t, Derived>::getMaxValue() const {
+    return this->header->maxValue;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+MatrixLayout SharedImage<IEEE754_t, Derived>::getMatrixLayout() const {
+    return this->layout;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+SampleArrangement SharedImage<IEEE754_t, Derived>::getArrangement() const {
+    return this->arrangement;
+}
+
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+IEEE754_t *SharedImage<IEEE754_t, Derived>::getSamples() const {
+    return this->samples;
+}
+
+/*
+ * An image whose channels are the planes of this segment, which must be planar. It must be deleted before this `SharedImage`.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+NetpbmImage<IEEE754_t, Derived> *SharedImage<IEEE754_t, Derived>::wrapped() const {
+    assert(this->getArrangement() == SampleArrangement::PLANAR);
+
+    auto width = this->getWidth();
+    auto height = this->getHeight();
+    auto channels = std::vector<Channel<IEEE754_t>*>();
+
+    for (unsigned int i = 0; i < this->getChannelsCount(); i++) {
+        channels.push_back(Channel<IEEE754_t>::borrowing(this->getMaxValue(), this->getSamples() + static_cast<size_t>(i) * width * height, height, width, this->getMatrixLayout()));
+    }
+
+    return NetpbmImage<IEEE754_t, Derived>::withChannels(width, height, channels);
+}
+
+/*
+ * An image holding a copy of the samples of this segment, with its layout (row-major for interleaved segments).
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+NetpbmImage<IEEE754_t, Derived> *SharedImage<IEEE754_t, Derived>::copied() const {
+    INSTRUMENTATION_SCOPE("SharedImage::copied");
+
+    auto width = this->getWidth();
+    auto height = this->getHeight();
+    auto layout = this->getMatrixLayout();
+    auto samples = this->getSamples();
+
+    auto elements = std::vector<IEEE754_t>(static_cast<size_t>(width) * height);
+    auto channels = std::vector<Channel<IEEE754_t>*>();
+
+    for (unsigned int i = 0; i < this->getChannelsCount(); i++) {
+        for (unsigned int row = 0; row < height; row++) {
+            for (unsigned int column = 0; column < width; column++) {
+                elements[flatIndexOf(row, column, height, width, layout)] = samples[this->sampleIndexOf(i, row, column)];
+            }
+        }
+
+        channels.push_back(new Channel<IEEE754_t>(this->getMaxValue(), elements.data(), height, width, layout));
+    }
+
+    return NetpbmImage<IEEE754_t, Derived>::withChannels(width, height, channels);
+}
+
+/*
+ * Copies `image`, which must have the size and number of channels of this segment, into the segment.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+void SharedImage<IEEE754_t, Derived>::store(const NetpbmImage<IEEE754_t, Derived> *image) {
+    assert(image != nullptr);
+    assert(image->getWidth() == this->getWidth() && image->getHeight() == this->getHeight());
+    assert(image->getChannelsCount() == this->getChannelsCount());
+    INSTRUMENTATION_SCOPE("SharedImage::store");
+
+    auto samples = this->getSamples();
+
+    for (unsigned int i = 0; i < this->getChannelsCount(); i++) {
+        auto channel = image->getChannel(i);
+
+        for (unsigned int row = 0; row < this->getHeight(); row++) {
+            for (unsigned int column = 0; column < this->getWidth(); column++) {
+                samples[this->sampleIndexOf(i, row, column)] = channel->at(row, column);
+            }
+        }
+    }
+
+    this->header->maxValue = image->getChannel(0)->getMaxTheoreticalValue();
+}
+
+/*
+ * Filters this image into `destination`, a segment of the same size and number of channels. When both segments are planar with the same
+ * layout, the channels of this segment are filtered straight into the planes of `destination`; otherwise through a copy.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+void SharedImage<IEEE754_t, Derived>::filteredInto(SharedImage *destination, const ConvolutionKernel<IEEE754_t> *usingKernel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(destination != nullptr && destination != this);
+    assert(destination->getWidth() == this->getWidth() && destination->getHeight() == this->getHeight());
+    assert(destination->getChannelsCount() == this->getChannelsCount());
+    INSTRUMENTATION_SCOPE("SharedImage::filteredInto");
+
+    auto isPlanar = this->getArrangement() == SampleArrangement::PLANAR;
+    auto source = isPlanar ? this->wrapped() : this->copied();
+
+    if (isPlanar && destination->getArrangement() == SampleArrangement::PLANAR && destination->getMatrixLayout() == this->getMatrixLayout()) {
+        auto destinationImage = destination->wrapped();
+        source->filteredInto(destinationImage, usingKernel, withPaddingStrategy);
+        destination->header->maxValue = this->getMaxValue();
+
+        delete destinationImage;
+    } else {
+        auto filteredImage = source->filtered(usingKernel, withPaddingStrategy);
+        destination->store(filteredImage);
+
+        delete filteredImage;
+    }
+
+    delete source;
+}
+
+template class SharedImage<float, PPMImage<float>>;
+template class SharedImage<double, PPMImage<double>>;
+template class SharedImage<long double, PPMImage<long double>>;
+
+template class SharedImage<float, PGMImage<float>>;
+template class SharedImage<double, PGMImage<double>>;
+template class SharedImage<long double, PGMImage<long double>>;
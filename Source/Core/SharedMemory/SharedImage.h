@@ -0,0 +1,122 @@
+#ifndef IMAGECONVOLUTIONKERNEL_SHAREDIMAGE_H
+#define IMAGECONVOLUTIONKERNEL_SHAREDIMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "../Image/ImageFormats/NetpbmImage.h"
+
+enum class SampleArrangement : uint32_t {
+    // One plane per channel, each laid out according to the layout of the image.
+    PLANAR = 0,
+    // The channels of each pixel next to each other, pixels in row-major order.
+    INTERLEAVED = 1
+};
+
+enum class SampleType : uint32_t {
+    FLOAT32 = 0,
+    FLOAT64 = 1,
+    EXTENDED = 2
+};
+
+/*
+ * What a `SharedImage` segment starts with. Fixed size fields only, so that any process mapping the segment reads it the same way; the
+ * samples start at `samplesOffset`, aligned for any sample type.
+ */
+struct SharedImageHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channelsCount;
+    uint32_t maxValue;
+    uint32_t layout;
+    SampleArrangement arrangement;
+    SampleType sampleType;
+    uint32_t sampleSize;
+    uint64_t samplesOffset;
+};
+
+/*
+ * An image in a POSIX shared memory segment, to hand images over between processes (e.g. a decoder and filtering workers) without
+ * writing and parsing Netpbm files: a `SharedImageHeader` describing the image, followed by its samples, stored as `IEEE754_t`.
+ *
+ * Planar segments are wrapped in place: the channels of `wrapped` read and write the planes of the segment, so filtering a wrapped
+ * image into the wrapped image of a second segment copies nothing (see `filteredInto`). Interleaved samples can't back a `Channel`, so
+ * they're copied in and out instead (see `copied` and `store`).
+ *
+ * The segment outlives the `SharedImage` objects mapping it, until `remove` is called with its name. Synchronising the processes that
+ * write and read a segment is left to the caller, e.g. over the socket of a `FilterDaemon`.
+ */
+template<typename IEEE754_t, typename Derived> requires std::is_floating_point_v<IEEE754_t>
+class SharedImage {
+private:
+    std::string name;
+    SharedImageHeader* header;
+    size_t mappingSize;
+
+    // Copies of the header fields checked when mapping the segment: another process could rewrite the header afterwards.
+    const unsigned int width;
+    const unsigned int height;
+    const unsigned int channelsCount;
+    const MatrixLayout layout;
+    const SampleArrangement arrangement;
+    IEEE754_t* const samples;
+
+    SharedImage(const std::string& name, void* mapping, size_t mappingSize, const SharedImageHeader& checkedHeader);
+
+    static SampleType sampleTypeOf();
+    static size_t mappingSizeOf(unsigned int width, unsigned int height, unsigned int channelsCount);
+    [[nodiscard]] size_t sampleIndexOf(unsigned int channel, unsigned int row, unsigned int column) const;
+
+public:
+    SharedImage(const SharedImage&) = delete;
+    SharedImage& operator=(const SharedImage&) = delete;
+    ~SharedImage();
+
+    /*
+     * A new segment called `name`, with uninitialized samples. nullptr if a segment with that name already exists or can't be created.
+     */
+    static SharedImage* create(
+        const std::string& name,
+        unsigned int width,
+        unsigned int height,
+        unsigned int channelsCount,
+        unsigned int maxValue,
+        MatrixLayout layout = ROW_MAJOR,
+        SampleArrangement arrangement = SampleArrangement::PLANAR
+    );
+
+    /*
+     * A new segment called `name` holding a copy of `image`.
+     */
+    static SharedImage* publish(const std::string& name, const NetpbmImage<IEEE754_t, Derived>* image, SampleArrangement arrangement = SampleArrangement::PLANAR);
+
+    /*
+     * The existing segment called `name`. nullptr if there's none, if it wasn't created by a `SharedImage` of the same sample type,
+     * or if its header is inconsistent (an unknown layout or arrangement, or samples that don't fit in the segment). The header is
+     * read once: the returned image keeps the size, layout and arrangement it checked, whatever is written to the header afterwards.
+     */
+    static SharedImage* open(const std::string& name);
+
+    static bool remove(const std::string& name);
+
+    [[nodiscard]] const std::string& getName() const;
+    [[nodiscard]] unsigned int getWidth() const;
+    [[nodiscard]] unsigned int getHeight() const;
+    [[nodiscard]] unsigned int getChannelsCount() const;
+    [[nodiscard]] unsigned int getMaxValue() const;
+    [[nodiscard]] MatrixLayout getMatrixLayout() const;
+    [[nodiscard]] SampleArrangement getArrangement() const;
+    [[nodiscard]] IEEE754_t* getSamples() const;
+
+    NetpbmImage<IEEE754_t, Derived>* wrapped() const;
+    NetpbmImage<IEEE754_t, Derived>* copied() const;
+    void store(const NetpbmImage<IEEE754_t, Derived>* image);
+
+    void filteredInto(SharedImage* destination, const ConvolutionKernel<IEEE754_t>* usingKernel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const;
+};
+
+#endif
@@ -0,0 +1,152 @@
+#include "WinogradConvolution.h"
+
+#include <cassert>
+
+#include "../Instrumentation/Instrumentation.h"
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+WinogradConvolution<IEEE754_t>::WinogradConvolution(const ConvolutionKernel<IEEE754_t> *usingKernel) {
+    assert(usingKernel != nullptr);
+    assert(usingKernel->getRows() == 3 && usingKernel->getColumns() == 3);
+    assert(usingKernel->getLowerBoundRowIndex() == -1 && usingKernel->getLowerBoundColumnIndex() == -1);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            this->kernelValues[i][j] = usingKernel->getValue(i - 1, j - 1);
+        }
+    }
+
+    // G g, with G = [1 0 0; 1/2 1/2 1/2; 1/2 -1/2 1/2; 0 0 1].
+    IEEE754_t partiallyTransformed[4][3];
+    for (int j = 0; j < 3; j++) {
+        auto g0 = this->kernelValues[0][j];
+        auto g1 = this->kernelValues[1][j];
+        auto g2 = this->kernelValues[2][j];
+
+        partiallyTransformed[0][j] = g0;
+        partiallyTransformed[1][j] = (g0 + g1 + g2) / 2;
+        partiallyTransformed[2][j] = (g0 - g1 + g2) / 2;
+        partiallyTransformed[3][j] = g2;
+    }
+
+    // (G g) Gᵀ.
+    for (int i = 0; i < 4; i++) {
+        auto g0 = partiallyTransformed[i][0];
+        auto g1 = partiallyTransformed[i][1];
+        auto g2 = partiallyTransformed[i][2];
+
+        this->transformedKernel[i][0] = g0;
+        this->transformedKernel[i][1] = (g0 + g1 + g2) / 2;
+        this->transformedKernel[i][2] = (g0 - g1 + g2) / 2;
+        this->transformedKernel[i][3] = g2;
+    }
+}
+
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+Channel<IEEE754_t> *WinogradConvolution<IEEE754_t>::filtered(const Channel<IEEE754_t> *channel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(channel != nullptr);
+
+    auto filteredChannel = new Channel<IEEE754_t>(channel->getMaxTheoreticalValue(), channel->getRows(), channel->getColumns(), channel->getMatrixLayout());
+    this->filteredInto(channel, filteredChannel, withPaddingStrategy);
+
+    return filteredChannel;
+}
+
+/*
+ * Same as `filtered`, but stores the filtered pixels in `filteredChannel`, which must have the size and layout of `channel`.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+void WinogradConvolution<IEEE754_t>::filteredInto(const Channel<IEEE754_t> *channel, Channel<IEEE754_t> *filteredChannel, const MatrixPaddingStrategy<IEEE754_t> *withPaddingStrategy) const {
+    assert(channel != nullptr);
+    assert(filteredChannel != nullptr && filteredChannel != channel);
+    assert(withPaddingStrategy != nullptr);
+    assert(filteredChannel->getRows() == channel->getRows() && filteredChannel->getColumns() == channel->getColumns());
+    assert(filteredChannel->getMatrixLayout() == channel->getMatrixLayout());
+    INSTRUMENTATION_SCOPE("WinogradConvolution::filtered");
+    INSTRUMENTATION_COUNT(PIXELS_PROCESSED, channel->getRows() * channel->getColumns());
+
+    auto rows = channel->getRows();
+    auto columns = channel->getColumns();
+    auto layout = channel->getMatrixLayout();
+
+    filteredChannel->recycle(channel->getMaxTheoreticalValue());
+    auto destination = filteredChannel->getMutableElements();
+
+    auto store = [channel, destination, rows, columns, layout](unsigned int row, unsigned int column, IEEE754_t filteredValue) {
+        destination[flatIndexOf(row, column, rows, columns, layout)] = channel->saturated(filteredValue);
+    };
+
+    channel->forEachBlockWithHalo({0, 0, rows, columns}, -1, 1, -1, 1, withPaddingStrategy,
+        [this, &store](const MatrixRegion& block, const IEEE754_t* values, int stride) {
+            auto evenRows = block.rows & ~1u;
+            auto evenColumns = block.columns & ~1u;
+
+            for (unsigned int row = 0; row < evenRows; row += 2) {
+                for (unsigned int column = 0; column < evenColumns; column += 2) {
+                    auto tile = values + row * stride + column;
+
+                    // Bᵀ d, with Bᵀ = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1].
+                    IEEE754_t partiallyTransformed[4][4];
+                    for (int j = 0; j < 4; j++) {
+                        auto d0 = tile[j];
+                        auto d1 = tile[stride + j];
+                        auto d2 = tile[2 * stride + j];
+                        auto d3 = tile[3 * stride + j];
+
+                        partiallyTransformed[0][j] = d0 - d2;
+                        partiallyTransformed[1][j] = d1 + d2;
+                        partiallyTransformed[2][j] = d2 - d1;
+                        partiallyTransformed[3][j] = d1 - d3;
+                    }
+
+                    // (Bᵀ d B) ⊙ (G g Gᵀ), then Aᵀ on the left, with Aᵀ = [1 1 1 0; 0 1 -1 -1].
+                    IEEE754_t products[4][4];
+                    for (int i = 0; i < 4; i++) {
+                        auto v0 = partiallyTransformed[i][0];
+                        auto v1 = partiallyTransformed[i][1];
+                        auto v2 = partiallyTransformed[i][2];
+                        auto v3 = partiallyTransformed[i][3];
+
+                        products[i][0] = (v0 - v2) * this->transformedKernel[i][0];
+                        products[i][1] = (v1 + v2) * this->transformedKernel[i][1];
+                        products[i][2] = (v2 - v1) * this->transformedKernel[i][2];
+                        products[i][3] = (v1 - v3) * this->transformedKernel[i][3];
+                    }
+
+                    IEEE754_t rowsCombined[2][4];
+                    for (int j = 0; j < 4; j++) {
+                        rowsCombined[0][j] = products[0][j] + products[1][j] + products[2][j];
+                        rowsCombined[1][j] = products[1][j] - products[2][j] - products[3][j];
+                    }
+
+                    // ... and A on the right.
+                    for (int i = 0; i < 2; i++) {
+                        store(block.row + row + i, block.column + column, rowsCombined[i][0] + rowsCombined[i][1] + rowsCombined[i][2]);
+                        store(block.row + row + i, block.column + column + 1, rowsCombined[i][1] - rowsCombined[i][2] - rowsCombined[i][3]);
+                    }
+                }
+            }
+
+            auto filterDirectly = [this, values, stride, &block, &store](unsigned int row, unsigned int column) {
+                IEEE754_t filteredValue = 0;
+                for (int i = 0; i < 3; i++) {
+                    for (int j = 0; j < 3; j++) {
+                        filteredValue += values[(row + i) * stride + column + j] * this->kernelValues[i][j];
+                    }
+                }
+
+                store(block.row + row, block.column + column, filteredValue);
+            };
+
+            for (unsigned int row = 0; row < block.rows; row++) {
+                for (unsigned int column = row < evenRows ? evenColumns : 0; column < block.columns; column++) {
+                    filterDirectly(row, column);
+                }
+            }
+        }
+    );
+}
+
+template class WinogradConvolution<float>;
+template class WinogradConvolution<double>;
+template class WinogradConvolution<long double>;
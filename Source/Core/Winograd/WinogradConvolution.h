@@ -0,0 +1,33 @@
+#ifndef IMAGECONVOLUTIONKERNEL_WINOGRADCONVOLUTION_H
+#define IMAGECONVOLUTIONKERNEL_WINOGRADCONVOLUTION_H
+
+#include <type_traits>
+
+#include "../Channel/Channel.h"
+
+/*
+ * Filters a channel with a 3x3 kernel through Winograd's minimal filtering algorithm F(2x2, 3x3).
+ *
+ * Each 2x2 block of output pixels is computed from the 4x4 input tile around it as Aᵀ[(G g Gᵀ) ⊙ (Bᵀ d B)]A, where g is the kernel and
+ * d the tile. The kernel transform G g Gᵀ is done once, the input and output transforms only take additions, so a block costs 16
+ * multiplications instead of the 36 of the direct computation. Tiles are read from the blocks gathered by `Channel::forEachBlockWithHalo`;
+ * an odd last row or column of a block is computed directly.
+ *
+ * The transforms reorder the additions, so the filtered values differ from `Channel::filtered` by a few units of roundoff of the input
+ * magnitude: after rounding, a pixel can differ by one when its exact value is within that error of a .5 tie. The larger F(4x4, 3x3)
+ * saves more multiplications, but its transforms amplify the error by about an order of magnitude, too much for `float` channels.
+ */
+template<typename IEEE754_t> requires std::is_floating_point_v<IEEE754_t>
+class WinogradConvolution {
+private:
+    IEEE754_t transformedKernel[4][4];
+    IEEE754_t kernelValues[3][3];
+
+public:
+    explicit WinogradConvolution(const ConvolutionKernel<IEEE754_t>* usingKernel);
+
+    Channel<IEEE754_t>* filtered(const Channel<IEEE754_t>* channel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const;
+    void filteredInto(const Channel<IEEE754_t>* channel, Channel<IEEE754_t>* filteredChannel, const MatrixPaddingStrategy<IEEE754_t>* withPaddingStrategy) const;
+};
+
+#endif
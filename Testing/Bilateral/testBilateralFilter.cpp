@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+#include "../../Source/Core/Bilateral/BilateralFilter.h"
+#include "../../Source/Core/Image/ImageFormats/PGM/PGMImage.h"
+
+TEST(BilateralFilterTests, SmoothsWithoutBlurringEdges) {
+    // A vertical step from 50 to 200, with noise of ±8 levels.
+    auto randomEngine = std::mt19937(11);
+    auto noise = std::uniform_real_distribution<double>(-8, 8);
+
+    auto elements = std::vector<double>(64 * 64);
+    for (int i = 0; i < 64; i++) {
+        for (int j = 0; j < 64; j++) {
+            elements[i * 64 + j] = (j < 32 ? 50 : 200) + noise(randomEngine);
+        }
+    }
+
+    for (auto layout : {ROW_MAJOR, TILED}) {
+        auto matrix = Matrix<double>(elements.data(), 64, 64);
+        auto channel = (new Channel<double>(255, &matrix))->withLayout(layout);
+        auto filteredChannel = BilateralFilter<double>(4, 20).filtered(channel);
+
+        EXPECT_EQ(filteredChannel->getMatrixLayout(), layout);
+
+        auto squaredError = 0.0;
+        auto filteredSquaredError = 0.0;
+
+        for (int i = 0; i < 64; i++) {
+            for (int j = 0; j < 64; j++) {
+                auto expectedValue = j < 32 ? 50.0 : 200.0;
+
+                // Right next to the step, pixels still belong to their side.
+                EXPECT_NEAR(filteredChannel->at(i, j), expectedValue, 8);
+
+                squaredError += std::pow(channel->at(i, j) - expectedValue, 2);
+                filteredSquaredError += std::pow(filteredChannel->at(i, j) - expectedValue, 2);
+            }
+        }
+
+        EXPECT_LT(filteredSquaredError, squaredError / 4);
+    }
+}
+
+TEST(BilateralFilterTests, MatchesTheBruteForceFilter) {
+    auto matrix = Matrix<double>::random(40, 40);
+    auto channel = new Channel<double>(100, &matrix);
+
+    double spatialSigma = 3;
+    double rangeSigma = 15;
+    auto filteredChannel = BilateralFilter<double>(spatialSigma, rangeSigma).filtered(channel);
+
+    // The grid approximates the filter, the average error is what matters.
+    auto totalError = 0.0;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            auto sum = 0.0;
+            auto weights = 0.0;
+
+            for (int k = std::max(0, i - 9); k <= std::min(39, i + 9); k++) {
+                for (int l = std::max(0, j - 9); l <= std::min(39, j + 9); l++) {
+                    auto distance = (k - i) * (k - i) + (l - j) * (l - j);
+                    auto difference = channel->at(k, l) - channel->at(i, j);
+                    auto weight = std::exp(-distance / (2 * spatialSigma * spatialSigma) - difference * difference / (2 * rangeSigma * rangeSigma));
+
+                    sum += weight * channel->at(k, l);
+                    weights += weight;
+                }
+            }
+
+            totalError += std::abs(filteredChannel->at(i, j) - sum / weights);
+        }
+    }
+
+    EXPECT_LT(totalError / (40 * 40), 2);
+}
+
+TEST(BilateralFilterTests, ConstantImagesAreUnchanged) {
+    auto elements = std::vector<float>(20 * 30, 77);
+    auto image = PGMImage<float>::withChannels(30, 20, {new Channel<float>(255, elements.data(), 20, 30)});
+    auto filteredImage = image->bilateralFiltered(2, 10);
+
+    for (int i = 0; i < 20; i++) {
+        for (int j = 0; j < 30; j++) {
+            EXPECT_EQ(filteredImage->getChannel(0)->at(i, j), 77);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "../../Source/Core/Color/LumaChromaFilter.h"
+#include "../../Source/Core/Image/ImageFormats/PPM/PPMImage.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/ConvolutionKernel/Kernels/Identity.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(LumaChromaFilterTests, IdentityKernelKeepsTheImage) {
+    auto kernel = Kernels::identity<double>(3);
+    auto paddingStrategy = ZeroPaddingMatrixPaddingStrategy<double>();
+
+    auto channels = std::vector<Channel<double>*>();
+    for (int i = 0; i < 3; i++) {
+        auto matrix = Matrix<double>::random(31, 44, TILED);
+        channels.push_back(new Channel<double>(255, &matrix));
+    }
+
+    auto image = PPMImage<double>(44, 31, channels[0], channels[1], channels[2]);
+    auto filtered = image.lumaFiltered(kernel, &paddingStrategy);
+
+    for (int k = 0; k < 3; k++) {
+        EXPECT_EQ(filtered->getChannel(k)->getMatrixLayout(), TILED);
+
+        for (unsigned int row = 0; row < 31; row++) {
+            for (unsigned int column = 0; column < 44; column++) {
+                EXPECT_EQ(filtered->getChannel(k)->at(row, column), std::round(image.getChannel(k)->at(row, column)));
+            }
+        }
+    }
+
+    delete filtered;
+    delete kernel;
+}
+
+TEST(LumaChromaFilterTests, MatchesFilteringTheChannelsWhenOnlyTheLumaVaries) {
+    auto kernel = Kernels::gaussianKernel<float>(5, 1.5);
+    auto paddingStrategy = PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    for (auto layout : {ROW_MAJOR, COLUMN_MAJOR, TILED}) {
+        // Constant offsets between the channels make a constant chroma, so filtering the luma alone is filtering everything.
+        auto luma = Matrix<float>::random(37, 50, layout);
+        float offsets[3] = {40, 0, 20};
+
+        auto channels = std::vector<Channel<float>*>();
+        for (auto offset : offsets) {
+            auto values = std::vector<float>();
+            for (unsigned int row = 0; row < 37; row++) {
+                for (unsigned int column = 0; column < 50; column++) {
+                    values.push_back(std::round(luma.at(row, column) * 0.75f) + offset);
+                }
+            }
+
+            auto channel = new Channel<float>(255, values.data(), 37, 50);
+            channels.push_back(channel->withLayout(layout));
+            delete channel;
+        }
+
+        auto image = PPMImage<float>(50, 37, channels[0], channels[1], channels[2]);
+        auto expected = image.filtered(kernel, &paddingStrategy);
+
+        for (auto chromaFiltering : {ChromaFiltering::UNFILTERED, ChromaFiltering::HALF_RESOLUTION}) {
+            auto filtered = image.lumaFiltered(kernel, &paddingStrategy, chromaFiltering);
+
+            for (int k = 0; k < 3; k++) {
+                for (unsigned int row = 0; row < 37; row++) {
+                    for (unsigned int column = 0; column < 50; column++) {
+                        EXPECT_LE(std::abs(filtered->getChannel(k)->at(row, column) - expected->getChannel(k)->at(row, column)), 1);
+                    }
+                }
+            }
+
+            delete filtered;
+        }
+
+        delete expected;
+    }
+
+    delete kernel;
+}
+
+TEST(LumaChromaFilterTests, HalfResolutionChromaBlendsColoursAcrossEdges) {
+    auto kernel = Kernels::gaussianKernel<double>(3, 1.0);
+    auto paddingStrategy = PeriodicExtensionMatrixPaddingStrategy<double>();
+
+    // Red on the left half, blue on the right half.
+    auto values = std::vector<double>(8 * 16);
+    auto red = new Channel<double>(255, values.data(), 8, 16);
+    auto green = new Channel<double>(255, values.data(), 8, 16);
+    auto blue = new Channel<double>(255, values.data(), 8, 16);
+    for (unsigned int row = 0; row < 8; row++) {
+        for (unsigned int column = 0; column < 16; column++) {
+            red->setValue(row, column, column < 8 ? 200 : 0);
+            blue->setValue(row, column, column < 8 ? 0 : 200);
+        }
+    }
+
+    auto lumaOnly = LumaChromaFilter<double>(kernel, &paddingStrategy).filtered(red, green, blue);
+    auto withChroma = LumaChromaFilter<double>(kernel, &paddingStrategy, ChromaFiltering::HALF_RESOLUTION).filtered(red, green, blue);
+
+    // Away from the edges the image is flat, and both keep it.
+    EXPECT_EQ(lumaOnly[0]->at(4, 5), 200);
+    EXPECT_EQ(withChroma[0]->at(4, 5), 200);
+    EXPECT_EQ(withChroma[2]->at(4, 5), 0);
+
+    // Next to the edge, the luma alone only darkens the red side, the filtered chroma brings blue into it.
+    EXPECT_EQ(lumaOnly[2]->at(4, 7), 0);
+    EXPECT_GT(withChroma[2]->at(4, 7), 0);
+
+    for (auto channel : {red, green, blue, lumaOnly[0], lumaOnly[1], lumaOnly[2], withChroma[0], withChroma[1], withChroma[2]}) {
+        delete channel;
+    }
+
+    delete kernel;
+}
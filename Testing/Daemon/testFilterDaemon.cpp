@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "../../Source/Core/Daemon/FilterDaemon.h"
+#include "../../Source/Core/Daemon/FilterClient.h"
+#include "../../Source/Core/Daemon/UnixSocket.h"
+
+static void writeMockPPM(const std::filesystem::path& filepath, unsigned int width, unsigned int height, unsigned int seed) {
+    std::ofstream fileHandle(filepath);
+    fileHandle << "P3" << std::endl << width << " " << height << std::endl << 255 << std::endl;
+
+    for (unsigned int i = 0; i < width * height * 3; i++) {
+        fileHandle << (i * 7 + seed * 13) % 256 << " ";
+    }
+}
+
+TEST(FilterDaemonTests, RequestsRoundTripThroughTheirLine) {
+    auto request = FilterRequest();
+    request.input = "/tmp/some dir/in \"quoted\".ppm";
+    request.output = "/tmp/out\\put";
+    request.kernelType = KernelType::AVERAGE;
+    request.kernelSize = 5;
+    request.sigma = 0.7;
+    request.padding = PaddingMode::ZERO;
+    request.encoding = ImageChannelsEncoding::PLAIN;
+
+    auto error = std::string();
+    auto parsed = FilterRequest::parse(request.toLine(), error);
+
+    ASSERT_TRUE(parsed.has_value()) << error;
+    EXPECT_EQ(parsed->input, request.input);
+    EXPECT_EQ(parsed->output, request.output);
+    EXPECT_EQ(parsed->kernelType, KernelType::AVERAGE);
+    EXPECT_EQ(parsed->kernelSize, 5);
+    EXPECT_EQ(parsed->sigma, 0.7);
+    EXPECT_EQ(parsed->padding, PaddingMode::ZERO);
+    EXPECT_EQ(parsed->encoding, ImageChannelsEncoding::PLAIN);
+
+    // Defaults for the omitted fields.
+    parsed = FilterRequest::parse("filter input=a.ppm   output=b", error);
+    ASSERT_TRUE(parsed.has_value()) << error;
+    EXPECT_EQ(parsed->kernelType, KernelType::GAUSSIAN);
+    EXPECT_EQ(parsed->kernelSize, 3);
+    EXPECT_EQ(parsed->padding, PaddingMode::PERIODIC);
+
+    for (auto malformed : {
+        "filter input=a.ppm",
+        "filter input=a.ppm output=b size=4",
+        "filter input=a.ppm output=b size=4294967295",
+        "filter input=a.ppm output=b sigma=-1",
+        "filter input=a.ppm output=b kernel=laplacian",
+        "filter input=a.ppm output=b colour=red",
+        "filter input=\"a.ppm output=b",
+        "stats"
+    }) {
+        error.clear();
+        EXPECT_FALSE(FilterRequest::parse(malformed, error).has_value()) << malformed;
+        EXPECT_FALSE(error.empty());
+    }
+}
+
+TEST(FilterDaemonTests, LatencyPercentilesAreNearestRank) {
+    auto recorder = LatencyRecorder(100);
+    EXPECT_EQ(recorder.report().count, 0);
+
+    for (long long i = 100; i >= 1; i--) {
+        recorder.record(i);
+    }
+
+    auto report = recorder.report();
+    EXPECT_EQ(report.count, 100);
+    EXPECT_EQ(report.meanNanoseconds, 50);
+    EXPECT_EQ(report.p50Nanoseconds, 50);
+    EXPECT_EQ(report.p90Nanoseconds, 90);
+    EXPECT_EQ(report.p99Nanoseconds, 99);
+    EXPECT_EQ(report.maxNanoseconds, 100);
+
+    // Past the capacity, the oldest samples are replaced.
+    for (int i = 0; i < 100; i++) {
+        recorder.record(1000);
+    }
+
+    report = recorder.report();
+    EXPECT_EQ(report.count, 200);
+    EXPECT_EQ(report.p50Nanoseconds, 1000);
+    EXPECT_EQ(report.meanNanoseconds, 1000);
+}
+
+TEST(FilterDaemonTests, ServesRequestsOverTheSocket) {
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "testFilterDaemon";
+    std::filesystem::create_directories(tempDir);
+
+    auto input = tempDir / "input.ppm";
+    writeMockPPM(input, 23, 17, 3);
+
+    auto daemon = FilterDaemon<float>(tempDir / "daemon.sock", 2);
+    ASSERT_TRUE(daemon.isListening());
+    auto server = std::jthread([&daemon] { daemon.serve(); });
+
+    auto client = FilterClient::connectTo(tempDir / "daemon.sock");
+    ASSERT_NE(client, nullptr);
+
+    auto request = FilterRequest();
+    request.input = input;
+    request.kernelSize = 5;
+    request.sigma = 1.2;
+
+    // Gaussian kernels are generated per request, rather than kept forever by the cache.
+    auto kernelsCount = KernelCache<float>::getCachedKernelsCount();
+
+    for (int i = 0; i < 3; i++) {
+        request.output = tempDir / ("output" + std::to_string(i));
+
+        auto reply = client->request(request.toLine());
+        ASSERT_TRUE(reply.has_value());
+        EXPECT_TRUE(reply->starts_with("ok ")) << reply.value();
+    }
+
+    EXPECT_EQ(KernelCache<float>::getCachedKernelsCount(), kernelsCount);
+
+    auto original = NetpbmImage<float, PPMImage<float>>::loadImage(input);
+    auto expected = original->filtered(KernelCache<float>::gaussianKernel(5, 1.2), new PeriodicExtensionMatrixPaddingStrategy<float>());
+
+    for (int i = 0; i < 3; i++) {
+        auto written = NetpbmImage<float, PPMImage<float>>::loadImage(tempDir / ("output" + std::to_string(i) + ".ppm"));
+        ASSERT_NE(written, nullptr);
+
+        for (int k = 0; k < expected->getChannelsCount(); k++) {
+            for (int row = 0; row < expected->getHeight(); row++) {
+                for (int column = 0; column < expected->getWidth(); column++) {
+                    EXPECT_FLOAT_EQ(written->getChannel(k)->at(row, column), expected->getChannel(k)->at(row, column));
+                }
+            }
+        }
+
+        delete written;
+    }
+
+    // A second connection is served alongside the first one.
+    auto otherClient = FilterClient::connectTo(tempDir / "daemon.sock");
+    ASSERT_NE(otherClient, nullptr);
+    EXPECT_TRUE(otherClient->request("filter input=" + (tempDir / "missing.ppm").string() + " output=x")->starts_with("error"));
+    EXPECT_TRUE(otherClient->request("filter input=a.ppm output=b size=2")->starts_with("error"));
+    EXPECT_TRUE(otherClient->request("rotate")->starts_with("error"));
+
+    // A request throwing while loading its input gets an error, and the connection is still served.
+    {
+        auto fileHandle = std::ofstream(tempDir / "malformed.ppm");
+        fileHandle << "P3\n2 2\n255\nred green blue\n";
+    }
+    EXPECT_TRUE(otherClient->request("filter input=" + (tempDir / "malformed.ppm").string() + " output=x")->starts_with("error"));
+    EXPECT_TRUE(otherClient->request("stats")->starts_with("ok"));
+
+    // The output image is allocated once and reused by the following requests of the same size.
+    auto stats = client->request("stats");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_NE(stats->find("\"count\":3"), std::string::npos) << stats.value();
+    EXPECT_NE(stats->find("\"allocatedImages\":1,\"reusedImages\":2"), std::string::npos) << stats.value();
+    EXPECT_EQ(daemon.getLatencyReport().count, 3);
+
+    EXPECT_EQ(client->request("shutdown"), "ok");
+    server.join();
+
+    // Both connections are closed by the daemon once stopped.
+    EXPECT_FALSE(otherClient->request("stats").has_value());
+
+    delete client;
+    delete otherClient;
+    delete original;
+    delete expected;
+    std::filesystem::remove_all(tempDir);
+}
+
+TEST(FilterDaemonTests, OverlongLinesCloseTheirConnection) {
+    auto socketPath = std::filesystem::temp_directory_path() / ("testFilterDaemonOverlong" + std::to_string(getpid()) + ".sock");
+    auto daemon = FilterDaemon<float>(socketPath, 1);
+    ASSERT_TRUE(daemon.isListening());
+    auto server = std::jthread([&daemon] { daemon.serve(); });
+
+    auto floodingClient = FilterClient::connectTo(socketPath);
+    ASSERT_NE(floodingClient, nullptr);
+    EXPECT_FALSE(floodingClient->request(std::string(4 * MAX_LINE_LENGTH, 'x')).has_value());
+    delete floodingClient;
+
+    // The daemon still serves the next connections.
+    auto client = FilterClient::connectTo(socketPath);
+    ASSERT_NE(client, nullptr);
+    EXPECT_TRUE(client->request("stats")->starts_with("ok"));
+    EXPECT_EQ(client->request("shutdown"), "ok");
+    server.join();
+
+    delete client;
+}
+
+TEST(FilterDaemonTests, IdleConnectionsHoldNoWorker) {
+    auto socketPath = std::filesystem::temp_directory_path() / ("testFilterDaemonIdle" + std::to_string(getpid()) + ".sock");
+    auto daemon = FilterDaemon<float>(socketPath, 1);
+    ASSERT_TRUE(daemon.isListening());
+    auto server = std::jthread([&daemon] { daemon.serve(); });
+
+    // More idle clients than workers, one of them in the middle of a line.
+    auto idleClients = std::vector<FilterClient*>();
+    for (int i = 0; i < 3; i++) {
+        idleClients.push_back(FilterClient::connectTo(socketPath));
+        ASSERT_NE(idleClients.back(), nullptr);
+    }
+
+    auto partialLineSocket = UnixSocket::connectTo(socketPath);
+    ASSERT_GE(partialLineSocket, 0);
+    ASSERT_EQ(send(partialLineSocket, "sta", 3, 0), 3);
+
+    auto client = FilterClient::connectTo(socketPath);
+    ASSERT_NE(client, nullptr);
+    EXPECT_TRUE(client->request("stats")->starts_with("ok"));
+
+    // Lines received together are served one after the other, in order.
+    ASSERT_TRUE(UnixSocket::writeLine(partialLineSocket, "ts\nrotate"));
+    auto pending = std::string();
+    EXPECT_TRUE(UnixSocket::readLine(partialLineSocket, pending)->starts_with("ok"));
+    EXPECT_EQ(UnixSocket::readLine(partialLineSocket, pending), "error Unknown command rotate");
+
+    EXPECT_EQ(client->request("shutdown"), "ok");
+    server.join();
+
+    close(partialLineSocket);
+    for (auto idleClient : idleClients) {
+        delete idleClient;
+    }
+    delete client;
+}
+
+TEST(FilterDaemonTests, FiltersSharedMemorySegments) {
+    using SharedPGM = SharedImage<double, PGMImage<double>>;
+    auto inputName = "/testFilterDaemon-" + std::to_string(getpid()) + "-input";
+    auto outputName = "/testFilterDaemon-" + std::to_string(getpid()) + "-output";
+
+    auto matrix = Matrix<double>::random(31, 26);
+    auto image = PGMImage<double>::withChannels(26, 31, {new Channel<double>(255, &matrix)});
+    auto input = SharedPGM::publish(inputName, image);
+    ASSERT_NE(input, nullptr);
+
+    // No socket needed to exercise the handling of a request.
+    auto daemon = FilterDaemon<double>(std::filesystem::temp_directory_path() / "testFilterDaemonShared.sock", 1);
+    auto reply = daemon.handle("filter input=shm:" + inputName + " output=shm:" + outputName + " kernel=average size=3 padding=zero");
+    EXPECT_TRUE(reply.starts_with("ok ")) << reply;
+
+    // The output segment was created by the daemon, shaped like the input one.
+    auto output = SharedPGM::open(outputName);
+    ASSERT_NE(output, nullptr);
+
+    auto expected = image->filtered(KernelCache<double>::averageKernel(3), new ZeroPaddingMatrixPaddingStrategy<double>());
+    auto filtered = output->wrapped();
+
+    for (int row = 0; row < 31; row++) {
+        for (int column = 0; column < 26; column++) {
+            EXPECT_DOUBLE_EQ(filtered->getChannel(0)->at(row, column), expected->getChannel(0)->at(row, column));
+        }
+    }
+
+    EXPECT_TRUE(daemon.handle("filter input=shm:/missing output=shm:" + outputName).starts_with("error"));
+
+    delete filtered;
+    delete output;
+    delete input;
+    delete image;
+    delete expected;
+
+    SharedPGM::remove(inputName);
+    SharedPGM::remove(outputName);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "../../Source/Core/EdgeDetection/EdgeDetector.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/EdgeKernels.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(EdgeDetectorTests, GradientMatchesTheOperatorKernels) {
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<double>();
+
+    std::pair<EdgeOperator, std::pair<ConvolutionKernel<double>*, ConvolutionKernel<double>*>> operators[] = {
+        {EdgeOperator::SOBEL, {Kernels::sobelX<double>(), Kernels::sobelY<double>()}},
+        {EdgeOperator::SCHARR, {Kernels::scharrX<double>(), Kernels::scharrY<double>()}},
+        {EdgeOperator::PREWITT, {Kernels::prewittX<double>(), Kernels::prewittY<double>()}}
+    };
+
+    for (const auto& [edgeOperator, kernels] : operators) {
+        auto detector = EdgeDetector<double>(edgeOperator, paddingStrategy);
+
+        for (auto layout : {ROW_MAJOR, TILED}) {
+            auto matrix = Matrix<double>::random(40, 33, layout);
+            auto channel = new Channel<double>(255, &matrix);
+            auto edgeMaps = detector.gradient(channel);
+
+            for (int row = 0; row < 40; row++) {
+                for (int column = 0; column < 33; column++) {
+                    double horizontalDerivative = 0;
+                    double verticalDerivative = 0;
+
+                    for (int i = -1; i <= 1; i++) {
+                        for (int j = -1; j <= 1; j++) {
+                            auto value = paddingStrategy->pad(*channel, row + i, column + j);
+
+                            horizontalDerivative += value * kernels.first->getValue(i, j);
+                            verticalDerivative += value * kernels.second->getValue(i, j);
+                        }
+                    }
+
+                    auto expectedMagnitude = std::clamp(std::round(std::hypot(horizontalDerivative, verticalDerivative)), 0.0, 255.0);
+                    auto expectedOrientation = std::atan2(verticalDerivative, horizontalDerivative) * 180 / M_PI;
+
+                    EXPECT_DOUBLE_EQ(edgeMaps.magnitude->at(row, column), expectedMagnitude);
+                    EXPECT_NEAR(edgeMaps.orientation->at(row, column), expectedOrientation < 0 ? expectedOrientation + 360 : expectedOrientation, 1e-9);
+                }
+            }
+        }
+    }
+
+    // Derivatives grow towards the right and the bottom.
+    EXPECT_DOUBLE_EQ(operators[0].second.first->getValue(0, 1), 2.0);
+    EXPECT_DOUBLE_EQ(operators[0].second.second->getValue(1, 0), 2.0);
+}
+
+TEST(EdgeDetectorTests, EdgesOfASquare) {
+    auto elements = std::vector<float>(24 * 24, 0);
+    for (int i = 8; i < 16; i++) {
+        for (int j = 8; j < 16; j++) {
+            elements[i * 24 + j] = 200;
+        }
+    }
+
+    auto channel = new Channel<float>(255, elements.data(), 24, 24);
+    auto detector = EdgeDetector<float>(EdgeOperator::SOBEL, new ZeroPaddingMatrixPaddingStrategy<float>());
+
+    auto edges = detector.edges(channel, 100, 500);
+    auto isEdge = [edges](int row, int column) { return edges->at(row, column) == 255; };
+
+    // The sides of the square, within a pixel of the step.
+    EXPECT_TRUE(isEdge(12, 7) || isEdge(12, 8));
+    EXPECT_TRUE(isEdge(12, 15) || isEdge(12, 16));
+    EXPECT_TRUE(isEdge(7, 12) || isEdge(8, 12));
+
+    // Non maxima across the step are suppressed, the flat regions have no edges.
+    EXPECT_FALSE(isEdge(12, 6) || isEdge(12, 9));
+    EXPECT_FALSE(isEdge(12, 12));
+    EXPECT_FALSE(isEdge(2, 2));
+
+    // Without suppression, a threshold above the strongest response gives no edges at all.
+    auto noEdges = detector.edges(channel, 1000, 1000, false);
+    for (int i = 0; i < 24; i++) {
+        for (int j = 0; j < 24; j++) {
+            EXPECT_EQ(noEdges->at(i, j), 0);
+        }
+    }
+}
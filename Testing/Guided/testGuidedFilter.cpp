@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <functional>
+
+#include "../../Source/Core/Guided/GuidedFilter.h"
+#include "../../Source/Core/Image/ImageFormats/PPM/PPMImage.h"
+#include "../../Source/Core/Image/ImageFormats/PGM/PGMImage.h"
+
+namespace {
+    // Mean of `value` over the window of `radius` around (row, column), cropped to the channel.
+    double boxMean(int rows, int columns, int row, int column, int radius, const std::function<double(int, int)>& value) {
+        auto sum = 0.0;
+        auto count = 0;
+
+        for (int i = std::max(0, row - radius); i <= std::min(rows - 1, row + radius); i++) {
+            for (int j = std::max(0, column - radius); j <= std::min(columns - 1, column + radius); j++) {
+                sum += value(i, j);
+                count++;
+            }
+        }
+
+        return sum / count;
+    }
+}
+
+TEST(GuidedFilterTests, MatchesTheDefinition) {
+    auto channelMatrix = Matrix<double>::random(37, 52);
+    auto guideMatrix = Matrix<double>::random(37, 52, TILED);
+    auto channel = new Channel<double>(255, &channelMatrix);
+    auto guide = new Channel<double>(255, &guideMatrix);
+
+    for (unsigned int radius : {1u, 4u}) {
+        for (const Channel<double>* guideChannel : {(const Channel<double>*) channel, (const Channel<double>*) guide}) {
+            double epsilon = 50;
+            auto filteredChannel = GuidedFilter<double>(radius, epsilon).filtered(channel, guideChannel);
+            auto r = static_cast<int>(radius);
+
+            auto slopeAt = [&](int row, int column) {
+                auto guideMean = boxMean(37, 52, row, column, r, [&](int i, int j) { return guideChannel->at(i, j); });
+                auto channelMean = boxMean(37, 52, row, column, r, [&](int i, int j) { return channel->at(i, j); });
+                auto guideVariance = boxMean(37, 52, row, column, r, [&](int i, int j) { return guideChannel->at(i, j) * guideChannel->at(i, j); }) - guideMean * guideMean;
+                auto covariance = boxMean(37, 52, row, column, r, [&](int i, int j) { return guideChannel->at(i, j) * channel->at(i, j); }) - guideMean * channelMean;
+
+                return covariance / (guideVariance + epsilon);
+            };
+
+            auto interceptAt = [&](int row, int column) {
+                auto guideMean = boxMean(37, 52, row, column, r, [&](int i, int j) { return guideChannel->at(i, j); });
+                auto channelMean = boxMean(37, 52, row, column, r, [&](int i, int j) { return channel->at(i, j); });
+
+                return channelMean - slopeAt(row, column) * guideMean;
+            };
+
+            for (int i = 0; i < 37; i++) {
+                for (int j = 0; j < 52; j++) {
+                    auto expectedValue = boxMean(37, 52, i, j, r, slopeAt) * guideChannel->at(i, j) + boxMean(37, 52, i, j, r, interceptAt);
+                    EXPECT_NEAR(filteredChannel->at(i, j), std::clamp(std::round(expectedValue), 0.0, 255.0), 1.0);
+                }
+            }
+        }
+    }
+}
+
+TEST(GuidedFilterTests, FiltersColorImagesWithAGrayGuide) {
+    // A colour image with a horizontal edge, whose gray guide has the same edge.
+    auto redElements = std::vector<float>(16 * 24);
+    auto guideElements = std::vector<float>(16 * 24);
+
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < 24; j++) {
+            redElements[i * 24 + j] = i < 8 ? 40 + (j % 2) * 20 : 210;
+            guideElements[i * 24 + j] = i < 8 ? 0 : 255;
+        }
+    }
+
+    auto image = PPMImage<float>::withChannels(24, 16, {
+        new Channel<float>(255, redElements.data(), 16, 24),
+        new Channel<float>(255, redElements.data(), 16, 24),
+        new Channel<float>(255, redElements.data(), 16, 24)
+    });
+    auto guide = PGMImage<float>::withChannels(24, 16, {new Channel<float>(255, guideElements.data(), 16, 24)});
+
+    auto filteredImage = image->guidedFiltered(guide, 2, 100);
+    auto selfGuidedImage = image->guidedFiltered(nullptr, 2, 100);
+
+    ASSERT_EQ(filteredImage->getChannelsCount(), 3);
+    ASSERT_EQ(selfGuidedImage->getChannelsCount(), 3);
+
+    for (int c = 0; c < 3; c++) {
+        // The flat guide above the edge smooths the stripes away, the edge itself stays sharp.
+        EXPECT_NEAR(filteredImage->getChannel(c)->at(3, 12), 50, 1);
+        EXPECT_NEAR(filteredImage->getChannel(c)->at(7, 12), 50, 1);
+        EXPECT_NEAR(filteredImage->getChannel(c)->at(8, 12), 210, 1);
+    }
+}
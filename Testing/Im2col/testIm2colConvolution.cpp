@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "../../Source/Core/Im2col/Im2colConvolution.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/ConvolutionKernel/Kernels/EdgeKernels.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(Im2colConvolutionTests, BlockedProductMatchesTheDefinition) {
+    // Sizes that aren't multiples of any of the blocks.
+    auto left = Matrix<double>::random(70, 131, TILED);
+    auto right = Matrix<double>::random(131, 263);
+    auto product = left.multiplied(&right);
+
+    ASSERT_EQ(product->getRows(), 70);
+    ASSERT_EQ(product->getColumns(), 263);
+    EXPECT_EQ(product->getMatrixLayout(), TILED);
+
+    for (int i = 0; i < 70; i++) {
+        for (int j = 0; j < 263; j++) {
+            double expectedValue = 0;
+            for (int k = 0; k < 131; k++) {
+                expectedValue += left.at(i, k) * right.at(k, j);
+            }
+
+            EXPECT_EQ(product->at(i, j), expectedValue);
+        }
+    }
+}
+
+TEST(Im2colConvolutionTests, MatchesFilteringEachKernel) {
+    auto kernels = std::vector<const ConvolutionKernel<double>*>{
+        Kernels::gaussianKernel<double>(5, 1.0),
+        Kernels::gaussianKernel<double>(3, 0.5),
+        Kernels::sobelX<double>(),
+        Kernels::sobelY<double>(),
+        Kernels::scharrX<double>(),
+        Kernels::scharrY<double>(),
+        Kernels::prewittX<double>(),
+        Kernels::prewittY<double>(),
+        Kernels::gaussianKernel<double>(7, 2.0)
+    };
+
+    auto zeroPadding = new ZeroPaddingMatrixPaddingStrategy<double>();
+    auto periodicPadding = new PeriodicExtensionMatrixPaddingStrategy<double>();
+    auto convolution = Im2colConvolution<double>(kernels);
+
+    EXPECT_EQ(convolution.getKernelsCount(), 9);
+    EXPECT_EQ(convolution.getWindowSize(), 49);
+
+    for (auto layout : {ROW_MAJOR, TILED}) {
+        for (const MatrixPaddingStrategy<double>* paddingStrategy : {(const MatrixPaddingStrategy<double>*) zeroPadding, (const MatrixPaddingStrategy<double>*) periodicPadding}) {
+            auto matrix = Matrix<double>::random(50, 71, layout);
+            auto channel = new Channel<double>(255, &matrix);
+
+            // Large enough a bank goes through the matrix product in `filteredBank` too.
+            for (const auto& filteredChannels : {convolution.filtered(channel, paddingStrategy), channel->filteredBank(kernels, paddingStrategy)}) {
+                ASSERT_EQ(filteredChannels.size(), kernels.size());
+
+                for (int k = 0; k < kernels.size(); k++) {
+                    auto expectedChannel = channel->filtered(kernels[k], paddingStrategy);
+                    EXPECT_EQ(filteredChannels[k]->getMatrixLayout(), layout);
+
+                    for (int i = 0; i < 50; i++) {
+                        for (int j = 0; j < 71; j++) {
+                            EXPECT_EQ(filteredChannels[k]->at(i, j), expectedChannel->at(i, j));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
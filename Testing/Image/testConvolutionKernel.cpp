@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include  "../../Source/Core/ConvolutionKernel/ConvolutionKernel.h"
 #include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/ConvolutionKernel/KernelCache/KernelCache.h"
+#include <thread>
 
 
 TEST(ConvolutionKernelTests, CentralIndexOddRowMajor) {
@@ -190,4 +192,82 @@ TEST(ConvolutionKernelTests, GaussianOddSize) {
             EXPECT_FLOAT_EQ(gaussianBlur->at(j, (randomKernelSize - 1) / 2 - distanceFromMidColumn), gaussianBlur->at(j, (randomKernelSize - 1) / 2 + distanceFromMidColumn));
         }
     }
-}
\ No newline at end of file
+}
+
+
+TEST(ConvolutionKernelTests, PrecomputedMetadata) {
+    auto gaussianBlur = Kernels::gaussianKernel<double>(7, 1.2);
+
+    EXPECT_NEAR(gaussianBlur->getSum(), 1.0, 1e-12);
+    EXPECT_TRUE(gaussianBlur->isSymmetric());
+    ASSERT_TRUE(gaussianBlur->isSeparable());
+    ASSERT_EQ(gaussianBlur->getColumnFactor().size(), 7);
+    ASSERT_EQ(gaussianBlur->getRowFactor().size(), 7);
+
+    for (int i = 0; i < 7; i++) {
+        for (int j = 0; j < 7; j++) {
+            EXPECT_NEAR(gaussianBlur->getColumnFactor()[i] * gaussianBlur->getRowFactor()[j], gaussianBlur->at(i, j), 1e-15);
+        }
+    }
+
+    double sobelValues[9] = {
+        -1, 0, 1,
+        -2, 0, 2,
+        -1, 0, 1
+    };
+    auto sobel = new ConvolutionKernel<double>(sobelValues, 3, 3);
+
+    EXPECT_DOUBLE_EQ(sobel->getSum(), 0);
+    EXPECT_FALSE(sobel->isSymmetric());
+    EXPECT_TRUE(sobel->isSeparable());
+
+    double laplacianValues[9] = {
+        0,  1, 0,
+        1, -4, 1,
+        0,  1, 0
+    };
+    auto laplacian = new ConvolutionKernel<double>(laplacianValues, 3, 3);
+
+    EXPECT_TRUE(laplacian->isSymmetric());
+    EXPECT_FALSE(laplacian->isSeparable());
+    EXPECT_TRUE(laplacian->getRowFactor().empty());
+}
+
+
+TEST(ConvolutionKernelTests, KernelCacheReturnsSharedInstances) {
+    auto first = KernelCache<float>::gaussianKernel(9, 1.3);
+    auto second = KernelCache<float>::gaussianKernel(9, 1.3);
+    auto otherSigma = KernelCache<float>::gaussianKernel(9, 1.5);
+    auto otherType = KernelCache<double>::gaussianKernel(9, 1.3);
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, otherSigma);
+    EXPECT_NE(static_cast<const void*>(first), static_cast<const void*>(otherType));
+    EXPECT_NE(KernelCache<float>::averageKernel(9), KernelCache<float>::identity(9));
+
+    auto generated = Kernels::gaussianKernel<float>(9, 1.3);
+    for (int i = 0; i < 9; i++) {
+        for (int j = 0; j < 9; j++) {
+            EXPECT_FLOAT_EQ(first->at(i, j), generated->at(i, j));
+        }
+    }
+
+    auto kernelsCount = KernelCache<float>::getCachedKernelsCount();
+    auto concurrentRequests = std::vector<std::thread>();
+    auto returnedKernels = std::vector<const ConvolutionKernel<float>*>(8);
+
+    for (int i = 0; i < 8; i++) {
+        concurrentRequests.emplace_back([i, &returnedKernels] {
+            returnedKernels[i] = KernelCache<float>::gaussianKernel(21, 3.5);
+        });
+    }
+
+    for (auto& request : concurrentRequests) {
+        request.join();
+    }
+
+    for (auto kernel : returnedKernels) {
+        EXPECT_EQ(kernel, returnedKernels.front());
+    }
+    EXPECT_EQ(KernelCache<float>::getCachedKernelsCount(), kernelsCount + 1);
+}
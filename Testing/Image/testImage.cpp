@@ -125,5 +125,44 @@ TEST(ImageTests, TestImageWriteToFile) {
 
     auto loadedImage = NetpbmImage<float, PPMImage<float>>::loadImage(tempDir / "paw.ppm");
     EXPECT_EQ(loadedImage->getChannel(0)->at(0, 0), 47);
+
+    auto tiledImage = NetpbmImage<float, PPMImage<float>>::loadImage(tempDir / "paw.ppm", TILED);
+    EXPECT_EQ(tiledImage->getChannel(0)->getMatrixLayout(), TILED);
+
+    for (int k = 0; k < 3; k++) {
+        for (int i = 0; i < loadedImage->getHeight(); i++) {
+            for (int j = 0; j < loadedImage->getWidth(); j++) {
+                ASSERT_EQ(tiledImage->getChannel(k)->at(i, j), loadedImage->getChannel(k)->at(i, j));
+            }
+        }
+    }
+
     std::filesystem::remove_all(tempDir);
-}
\ No newline at end of file
+}
+
+TEST(ImageTests, TestImageRegionFiltering) {
+    auto channel = [] {
+        auto matrix = Matrix<float>::random(32, 48);
+        return new Channel<float>(255, &matrix);
+    };
+
+    Image<float>* image = new PPMImage<float>(48, 32, channel(), channel(), channel());
+    auto kernel = Kernels::gaussianKernel<float>(7, 1.5);
+    auto strategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    auto filteredImage = image->filtered(kernel, strategy);
+    auto region = MatrixRegion{20, 1, 12, 30};
+    auto filteredRegion = image->filteredRegion(region, kernel, strategy);
+
+    ASSERT_EQ(filteredRegion->getWidth(), region.columns);
+    ASSERT_EQ(filteredRegion->getHeight(), region.rows);
+    ASSERT_EQ(filteredRegion->getChannelsCount(), 3);
+
+    for (int k = 0; k < 3; k++) {
+        for (int i = 0; i < region.rows; i++) {
+            for (int j = 0; j < region.columns; j++) {
+                EXPECT_FLOAT_EQ(filteredRegion->getChannel(k)->at(i, j), filteredImage->getChannel(k)->at(region.row + i, region.column + j));
+            }
+        }
+    }
+}
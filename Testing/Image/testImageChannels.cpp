@@ -1,9 +1,14 @@
+#include <numeric>
+#include <optional>
 #include <random>
 #include <gtest/gtest.h>
 #include  "../../Source/Core/Channel/Channel.h"
 #include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
 #include "../../Source/Core/ConvolutionKernel/Kernels/AverageKernel.cpp"
 #include "../../Source/Core/ConvolutionKernel/Kernels/Identity.cpp"
+#include "../../Source/Core/ConvolutionKernel/AccumulationPolicy/AccumulationPolicy.h"
+#include "../../Source/Core/Scheduler/WorkStealingScheduler.h"
 
 
 float mockImageRChannel[] = {
@@ -55,6 +60,42 @@ TEST(ImageChannel, TestClamp) {
     }
 }
 
+TEST(ImageChannel, PointOperationsOnWorkersMatchSerialOnes) {
+    auto scheduler = WorkStealingScheduler(4);
+
+    for (auto layout : {ROW_MAJOR, TILED}) {
+        // Large enough to be split across the workers.
+        auto matrix = Matrix<double>::random(300, 517, layout);
+        auto channel = new Channel<double>(255, &matrix);
+
+        auto [minValue, maxValue] = channel->getValueRange();
+        EXPECT_EQ(channel->getValueRange(&scheduler), std::make_pair(minValue, maxValue));
+
+        auto normalizedChannel = channel->normalized();
+        auto parallelNormalizedChannel = channel->normalized(&scheduler);
+        auto parallelClampedChannel = channel->clamped(20, 70, &scheduler);
+
+        EXPECT_EQ(parallelNormalizedChannel->getMatrixLayout(), layout);
+
+        for (int i = 0; i < 300; i++) {
+            for (int j = 0; j < 517; j++) {
+                auto value = channel->at(i, j);
+
+                EXPECT_DOUBLE_EQ(normalizedChannel->at(i, j), (value - minValue) / (maxValue - minValue));
+                EXPECT_EQ(parallelNormalizedChannel->at(i, j), normalizedChannel->at(i, j));
+                EXPECT_EQ(parallelClampedChannel->at(i, j), std::clamp(value, 20.0, 70.0));
+            }
+        }
+
+        EXPECT_EQ(parallelNormalizedChannel->getValueRange(&scheduler), std::make_pair(0.0, 1.0));
+    }
+
+    // A constant channel has nothing to rescale.
+    auto constantValues = std::vector<float>(64, 42);
+    auto constantChannel = Channel<float>(255, constantValues.data(), 8, 8);
+    EXPECT_EQ(constantChannel.normalized()->getValueRange(), std::make_pair(0.0f, 0.0f));
+}
+
 TEST(ImageChannel, OutputPixelForKernel) {
     auto matrix = new Matrix<float>(
         mockImageRChannel,
@@ -103,4 +144,302 @@ TEST(ImageChannel, OutputPixelForKernel) {
             EXPECT_FLOAT_EQ(sameChannel->at(i, j), channel->at(i, j));
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(ImageChannel, FilteredRegionMatchesFullFiltering) {
+    auto averageKernel = Kernels::averageKernel<float>(5);
+    auto paddingStrategy = new ZeroPaddingMatrixPaddingStrategy<float>();
+
+    for (auto layout : {ROW_MAJOR, COLUMN_MAJOR}) {
+        auto matrix = Matrix<float>::random(40, 30, layout);
+        auto channel = new Channel(255, &matrix);
+        auto filteredChannel = channel->filtered(averageKernel, paddingStrategy);
+
+        for (auto region : {MatrixRegion{10, 5, 12, 7}, MatrixRegion{0, 0, 3, 30}, MatrixRegion{35, 26, 5, 4}, MatrixRegion{0, 0, 40, 30}}) {
+            auto filteredRegion = channel->filteredRegion(region, averageKernel, paddingStrategy);
+
+            ASSERT_EQ(filteredRegion->getRows(), region.rows);
+            ASSERT_EQ(filteredRegion->getColumns(), region.columns);
+            EXPECT_EQ(filteredRegion->getMatrixLayout(), layout);
+
+            for (int i = 0; i < region.rows; i++) {
+                for (int j = 0; j < region.columns; j++) {
+                    EXPECT_FLOAT_EQ(filteredRegion->at(i, j), filteredChannel->at(region.row + i, region.column + j));
+                }
+            }
+        }
+
+        for (int i = 0; i < 40; i++) {
+            for (int j = 0; j < 30; j++) {
+                auto expectedValue = std::clamp(std::round(channel->outputPixel(i, j, averageKernel, paddingStrategy)), 0.0f, 255.0f);
+                EXPECT_FLOAT_EQ(filteredChannel->at(i, j), expectedValue);
+            }
+        }
+    }
+}
+
+TEST(ImageChannel, RefilteredMatchesFilteringFromScratch) {
+    // An asymmetric kernel, to catch halos dilated the wrong way.
+    float kernelElements[] = {
+        0.0, 1.0, 2.0, 0.5, 0.0,
+        1.0, 0.0, 0.0, 0.0, 0.0,
+        0.0, 0.0, 3.0, 0.0, 0.25
+    };
+    auto kernel = new ConvolutionKernel<float>(kernelElements, 3, 5);
+
+    auto zeroPadding = new ZeroPaddingMatrixPaddingStrategy<float>();
+    auto periodicPadding = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    for (const MatrixPaddingStrategy<float>* paddingStrategy : {(const MatrixPaddingStrategy<float>*) zeroPadding, (const MatrixPaddingStrategy<float>*) periodicPadding}) {
+        for (auto layout : {ROW_MAJOR, COLUMN_MAJOR}) {
+            auto matrix = Matrix<float>::random(40, 30, layout);
+            auto channel = new Channel(255, &matrix);
+
+            auto firstOutput = channel->refiltered(kernel, paddingStrategy);
+            EXPECT_EQ(channel->refiltered(kernel, paddingStrategy), firstOutput);
+
+            float patchElements[] = {12.0, 99.0, 3.0, 250.0, 7.0, 0.0};
+            auto patch = Matrix<float>(patchElements, 2, 3);
+
+            channel->setValue(20, 15, 200.0);
+            channel->setValue(0, 29, 255.0);
+            channel->setRegion({39, 0, 1, 3}, new Matrix<float>(patchElements, 1, 3));
+            channel->setRegion({7, 9, 2, 3}, &patch);
+            EXPECT_EQ(channel->getDirtyRegions().size(), 4);
+
+            auto refilteredChannel = channel->refiltered(kernel, paddingStrategy);
+            auto expectedChannel = channel->filtered(kernel, paddingStrategy);
+            EXPECT_TRUE(channel->getDirtyRegions().empty());
+
+            for (int i = 0; i < 40; i++) {
+                for (int j = 0; j < 30; j++) {
+                    EXPECT_FLOAT_EQ(refilteredChannel->at(i, j), expectedChannel->at(i, j));
+                }
+            }
+        }
+    }
+}
+
+TEST(ImageChannel, RefilteredWithAnotherKernelAtTheSameAddressStartsOver) {
+    auto padding = ZeroPaddingMatrixPaddingStrategy<float>();
+    auto matrix = Matrix<float>::random(20, 25);
+    auto channel = Channel(255, &matrix);
+
+    // Replacing the kernel in place guarantees that the second one lives where the first one did.
+    float firstElements[] = {0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    float secondElements[] = {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 0.0};
+    auto kernel = std::optional<ConvolutionKernel<float>>(std::in_place, firstElements, 3, 3);
+    auto firstKernel = &*kernel;
+    channel.refiltered(firstKernel, &padding);
+
+    kernel.emplace(secondElements, 3, 3);
+    ASSERT_EQ(&*kernel, firstKernel);
+
+    auto refilteredChannel = channel.refiltered(&*kernel, &padding);
+    auto expectedChannel = channel.filtered(&*kernel, &padding);
+
+    for (int i = 0; i < 20; i++) {
+        for (int j = 0; j < 25; j++) {
+            EXPECT_FLOAT_EQ(refilteredChannel->at(i, j), expectedChannel->at(i, j));
+        }
+    }
+
+    delete expectedChannel;
+}
+
+TEST(ImageChannel, TiledLayoutFiltersLikeRowMajor) {
+    auto averageKernel = Kernels::averageKernel<float>(7);
+    auto zeroPadding = new ZeroPaddingMatrixPaddingStrategy<float>();
+    auto periodicPadding = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    auto matrix = Matrix<float>::random(75, 100);
+    auto channel = new Channel(255, &matrix);
+    auto tiledChannel = channel->withLayout(TILED);
+
+    EXPECT_EQ(tiledChannel->getMatrixLayout(), TILED);
+
+    for (const MatrixPaddingStrategy<float>* paddingStrategy : {(const MatrixPaddingStrategy<float>*) zeroPadding, (const MatrixPaddingStrategy<float>*) periodicPadding}) {
+        auto expectedChannel = channel->filtered(averageKernel, paddingStrategy);
+        auto filteredChannel = tiledChannel->filtered(averageKernel, paddingStrategy);
+        auto filteredRegion = tiledChannel->filteredRegion({30, 20, 40, 50}, averageKernel, paddingStrategy);
+
+        EXPECT_EQ(filteredChannel->getMatrixLayout(), TILED);
+
+        for (int i = 0; i < 75; i++) {
+            for (int j = 0; j < 100; j++) {
+                EXPECT_FLOAT_EQ(tiledChannel->at(i, j), channel->at(i, j));
+                EXPECT_FLOAT_EQ(filteredChannel->at(i, j), expectedChannel->at(i, j));
+            }
+        }
+
+        for (int i = 0; i < 40; i++) {
+            for (int j = 0; j < 50; j++) {
+                EXPECT_FLOAT_EQ(filteredRegion->at(i, j), expectedChannel->at(30 + i, 20 + j));
+            }
+        }
+    }
+}
+
+TEST(ImageChannel, FilteredBankMatchesFilteringEachKernel) {
+    float edgeElements[] = {
+        -1.0, 0.0, 1.0,
+        -2.0, 0.0, 2.0,
+        -1.0, 0.0, 1.0
+    };
+    float wideElements[] = {0.25, 0.5, 0.25, 1.0, 0.0, 0.0, 1.0};
+
+    auto bank = std::vector<const ConvolutionKernel<float>*>{
+        new ConvolutionKernel<float>(edgeElements, 3, 3),
+        Kernels::averageKernel<float>(5),
+        Kernels::identity<float>(1),
+        new ConvolutionKernel<float>(wideElements, 1, 7)
+    };
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    for (auto layout : {ROW_MAJOR, COLUMN_MAJOR, TILED}) {
+        auto matrix = Matrix<float>::random(50, 37, layout);
+        auto channel = new Channel(255, &matrix);
+        auto filteredChannels = channel->filteredBank(bank, paddingStrategy);
+
+        ASSERT_EQ(filteredChannels.size(), bank.size());
+
+        for (size_t k = 0; k < bank.size(); k++) {
+            auto expectedChannel = channel->filtered(bank[k], paddingStrategy);
+            EXPECT_EQ(filteredChannels[k]->getMatrixLayout(), layout);
+
+            for (int i = 0; i < 50; i++) {
+                for (int j = 0; j < 37; j++) {
+                    EXPECT_FLOAT_EQ(filteredChannels[k]->at(i, j), expectedChannel->at(i, j));
+                }
+            }
+        }
+    }
+}
+
+TEST(ImageChannel, AccumulatorTypeIsIndependentOfStorage) {
+    auto floatKernel = Kernels::averageKernel<float>(5);
+    auto doubleKernel = Kernels::averageKernel<double>(5);
+    auto floatPadding = new ZeroPaddingMatrixPaddingStrategy<float>();
+    auto doublePadding = new ZeroPaddingMatrixPaddingStrategy<double>();
+
+    auto floatMatrix = Matrix<float>::random(30, 40);
+    auto floatChannel = new Channel(255, &floatMatrix);
+
+    auto doubleElements = std::vector<double>();
+    for (int i = 0; i < 30; i++) {
+        for (int j = 0; j < 40; j++) {
+            doubleElements.push_back(floatChannel->at(i, j));
+        }
+    }
+    auto doubleChannel = new Channel<double>(255, doubleElements.data(), 30, 40);
+
+    auto floatAccumulated = floatChannel->filtered(floatKernel, floatPadding);
+    auto doubleAccumulated = floatChannel->filtered<double>(floatKernel, floatPadding);
+    auto expectedChannel = doubleChannel->filtered(doubleKernel, doublePadding);
+
+    // The outputs are rounded to integers, the float accumulation may only differ on the sums within its error bound of a .5 tie.
+    auto floatBound = AccumulationPolicy<float, float>::errorBound(floatKernel, 255);
+    for (int i = 0; i < 30; i++) {
+        for (int j = 0; j < 40; j++) {
+            EXPECT_NEAR(floatAccumulated->at(i, j), expectedChannel->at(i, j), 1.0);
+            EXPECT_NEAR(doubleAccumulated->at(i, j), expectedChannel->at(i, j), 1.0);
+        }
+    }
+
+    EXPECT_GT(floatBound, (AccumulationPolicy<float, double>::errorBound(floatKernel, 255)));
+    EXPECT_GT((AccumulationPolicy<double, float>::errorBound(doubleKernel, 255)), (AccumulationPolicy<double, double>::errorBound(doubleKernel, 255)));
+    EXPECT_NEAR(floatBound, 26 * std::numeric_limits<float>::epsilon() / 2 * 255, 1e-5);
+
+    EXPECT_TRUE((AccumulationPolicy<float, float>::meetsTolerance(floatKernel, 255, 0.5)));
+    EXPECT_FALSE((AccumulationPolicy<float, float>::meetsTolerance(floatKernel, 255, 1e-6)));
+    EXPECT_TRUE((AccumulationPolicy<double, double>::meetsTolerance(doubleKernel, 255, 1e-9)));
+}
+
+TEST(ImageChannel, WiderAccumulatorIsCloserToTheReference) {
+    // 16 bit values and a large kernel of alternating signs: the partial sums are much larger than the outputs, so float sums are often
+    // off by more than the rounding of the outputs to integers absorbs. Outputs out of [0, maxValue] saturate alike whatever the accumulator.
+    constexpr unsigned int maxValue = 65535;
+    constexpr int kernelSize = 31;
+    constexpr unsigned int rows = 60;
+    constexpr unsigned int columns = 80;
+
+    auto generator = std::mt19937(7);
+    auto distribution = std::uniform_int_distribution<unsigned int>(0, maxValue);
+    auto floatElements = std::vector<float>();
+    auto referenceElements = std::vector<long double>();
+    for (unsigned int i = 0; i < rows * columns; i++) {
+        floatElements.push_back(static_cast<float>(distribution(generator)));
+        referenceElements.push_back(floatElements.back());
+    }
+
+    // Not separable, so that the strided path sums the same products as the others.
+    auto kernelValues = std::vector<float>();
+    for (int i = 0; i < kernelSize * kernelSize; i++) {
+        kernelValues.push_back(static_cast<float>(i % 2 == 0 ? 1 + i % 7 : -1 - i % 7) / 5);
+    }
+
+    // The center value makes the kernel sum to about 1, so that the outputs are spread around the mean of the values.
+    auto center = kernelSize * kernelSize / 2;
+    kernelValues[center] = 1 - (std::accumulate(kernelValues.begin(), kernelValues.end(), 0.0f) - kernelValues[center]);
+    auto referenceKernelValues = std::vector<long double>(kernelValues.begin(), kernelValues.end());
+
+    auto kernel = new ConvolutionKernel<float>(kernelValues.data(), kernelSize, kernelSize);
+    auto referenceKernel = new ConvolutionKernel<long double>(referenceKernelValues.data(), kernelSize, kernelSize);
+    auto paddingStrategy = new ZeroPaddingMatrixPaddingStrategy<float>();
+    auto referencePaddingStrategy = new ZeroPaddingMatrixPaddingStrategy<long double>();
+    ASSERT_FALSE(kernel->isSeparable());
+
+    auto channel = new Channel<float>(maxValue, floatElements.data(), rows, columns);
+    auto referenceChannel = new Channel<long double>(maxValue, referenceElements.data(), rows, columns);
+    auto expectedChannel = referenceChannel->filtered<long double>(referenceKernel, referencePaddingStrategy);
+
+    const ConvolutionKernel<float>* bank[] = {kernel};
+    auto stridedElements = std::vector<float>(rows * columns);
+    auto scratch = std::vector<double>();
+    channel->filterStridedInto<double>(stridedElements.data(), scratch, kernel, paddingStrategy, 1);
+
+    auto floatAccumulated = channel->filtered<float>(kernel, paddingStrategy);
+    auto doubleAccumulated = channel->filtered<double>(kernel, paddingStrategy);
+    auto bankAccumulated = channel->filteredBank<double>(bank, paddingStrategy);
+    auto stridedAccumulated = new Channel<float>(maxValue, stridedElements.data(), rows, columns);
+    auto refilteredAccumulated = channel->refiltered<double>(kernel, paddingStrategy);
+
+    // Outputs are rounded to integers, which adds up to one unit to the error of the sums.
+    auto floatBound = AccumulationPolicy<float, float>::errorBound(kernel, maxValue) + 1;
+    auto doubleBound = AccumulationPolicy<float, double>::errorBound(kernel, maxValue) + 1;
+    long double floatError = 0;
+    long double doubleErrors[4] = {};
+
+    for (unsigned int i = 0; i < rows; i++) {
+        for (unsigned int j = 0; j < columns; j++) {
+            auto expected = expectedChannel->at(i, j);
+            auto error = std::abs(floatAccumulated->at(i, j) - expected);
+            EXPECT_LE(error, floatBound);
+            floatError += error;
+
+            const Channel<float>* doubleChannels[] = {doubleAccumulated, bankAccumulated[0], stridedAccumulated, refilteredAccumulated};
+            for (int k = 0; k < 4; k++) {
+                error = std::abs(doubleChannels[k]->at(i, j) - expected);
+                EXPECT_LE(error, doubleBound) << k;
+                doubleErrors[k] += error;
+            }
+        }
+    }
+
+    EXPECT_GT(floatError, 0);
+    for (auto doubleError : doubleErrors) {
+        EXPECT_LT(doubleError * 10, floatError);
+    }
+
+    delete floatAccumulated;
+    delete doubleAccumulated;
+    delete bankAccumulated[0];
+    delete stridedAccumulated;
+    delete expectedChannel;
+    delete referenceChannel;
+    delete channel;
+    delete referencePaddingStrategy;
+    delete paddingStrategy;
+    delete referenceKernel;
+    delete kernel;
+}
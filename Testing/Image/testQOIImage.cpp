@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include "../../Source/Core/Image/ImageFormats/QOI/QOIImage.h"
+#include "../../Source/Core/Image/ImageFormats/PPM/PPMImage.h"
+#include "../../Source/Core/Image/ImageFormats/PGM/PGMImage.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+namespace {
+    std::filesystem::path temporaryPathFor(const std::string& name) {
+        return std::filesystem::temp_directory_path() / (name + std::to_string(getpid()));
+    }
+
+    Channel<float>* roundedRandomChannel(unsigned int rows, unsigned int columns) {
+        auto matrix = Matrix<float>::random(rows, columns);
+        auto values = std::vector<float>();
+
+        for (unsigned int row = 0; row < rows; row++) {
+            for (unsigned int column = 0; column < columns; column++) {
+                values.push_back(std::round(matrix.at(row, column) * 2.55f));
+            }
+        }
+
+        return new Channel<float>(255, values.data(), rows, columns);
+    }
+}
+
+TEST(QOIImageTests, EncodesAsTheSpecificationSays) {
+    auto stream = std::ostringstream();
+    QOIHeader{2, 1, 3, 0}.writeTo(stream);
+
+    // The first pixel repeats the initial black one, the second is a small difference from it.
+    uint8_t pixels[] = {0, 0, 0, 1, 1, 1};
+    auto encoder = QOIEncoder(stream);
+    encoder.encode(pixels, 2);
+    ASSERT_TRUE(encoder.finish());
+
+    auto expected = std::string("qoif\0\0\0\2\0\0\0\1\3\0\xc0\x7f\0\0\0\0\0\0\0\1", 24);
+    EXPECT_EQ(stream.str(), expected);
+}
+
+TEST(QOIImageTests, BandsEncodeLikeTheWholeImage) {
+    // Long runs, repeated colours, small and large differences.
+    auto pixels = std::vector<uint8_t>();
+    for (int i = 0; i < 700; i++) {
+        auto value = static_cast<uint8_t>(i < 100 ? 10 : (i < 300 ? i % 7 : (i * 37) % 256));
+        pixels.insert(pixels.end(), {value, static_cast<uint8_t>(value + i % 3), static_cast<uint8_t>(255 - value)});
+    }
+
+    auto whole = std::ostringstream();
+    auto wholeEncoder = QOIEncoder(whole);
+    wholeEncoder.encode(pixels.data(), 700);
+    wholeEncoder.finish();
+
+    auto banded = std::ostringstream();
+    auto bandedEncoder = QOIEncoder(banded);
+    for (size_t first = 0; first < 700; first += 93) {
+        bandedEncoder.encode(pixels.data() + 3 * first, std::min<size_t>(93, 700 - first));
+    }
+    bandedEncoder.finish();
+
+    EXPECT_EQ(banded.str(), whole.str());
+    EXPECT_EQ(bandedEncoder.getWrittenBytes(), whole.str().size());
+
+    auto header = std::ostringstream();
+    QOIHeader{700, 1, 3, 0}.writeTo(header);
+    auto file = header.str() + whole.str();
+
+    auto decoder = QOIDecoder(reinterpret_cast<const uint8_t*>(file.data()), file.size());
+    for (int i = 0; i < 700; i++) {
+        uint8_t rgb[3];
+        ASSERT_TRUE(decoder.next(rgb));
+        EXPECT_EQ(rgb[0], pixels[3 * i]);
+        EXPECT_EQ(rgb[1], pixels[3 * i + 1]);
+        EXPECT_EQ(rgb[2], pixels[3 * i + 2]);
+    }
+}
+
+TEST(QOIImageTests, WrittenImagesLoadBack) {
+    auto image = PPMImage<float>(45, 130, roundedRandomChannel(130, 45), roundedRandomChannel(130, 45), roundedRandomChannel(130, 45));
+    auto qoiImage = QOIImage<float>::fromImage(&image);
+    auto path = temporaryPathFor("testQOIImage");
+
+    qoiImage->writeToFile(path, ImageChannelsEncoding::BINARY);
+
+    for (auto layout : {ROW_MAJOR, TILED}) {
+        auto loadedImage = QOIImage<float>::loadImage(path.string() + ".qoi", layout);
+        ASSERT_NE(loadedImage, nullptr);
+        ASSERT_EQ(loadedImage->getWidth(), 45);
+        ASSERT_EQ(loadedImage->getHeight(), 130);
+
+        for (unsigned int k = 0; k < 3; k++) {
+            EXPECT_EQ(loadedImage->getChannel(k)->getMatrixLayout(), layout);
+
+            for (unsigned int row = 0; row < 130; row++) {
+                for (unsigned int column = 0; column < 45; column++) {
+                    EXPECT_EQ(loadedImage->getChannel(k)->at(row, column), image.getChannel(k)->at(row, column));
+                }
+            }
+        }
+
+        delete loadedImage;
+    }
+
+    std::filesystem::remove(path.string() + ".qoi");
+    delete qoiImage;
+}
+
+TEST(QOIImageTests, FilteringStraightToAFileMatchesFiltering) {
+    auto kernel = Kernels::gaussianKernel<float>(5, 1.5);
+    auto paddingStrategy = PeriodicExtensionMatrixPaddingStrategy<float>();
+    auto path = temporaryPathFor("testQOIFiltered");
+
+    // A smooth gradient with some noise: once blurred, it should take far less than the 3 bytes per pixel of binary PPM.
+    auto channels = std::vector<Channel<float>*>();
+    for (int k = 0; k < 3; k++) {
+        auto noise = roundedRandomChannel(150, 200);
+        for (unsigned int row = 0; row < 150; row++) {
+            for (unsigned int column = 0; column < 200; column++) {
+                noise->setValue(row, column, std::round((row + column) * 0.5f + k * 20 + noise->at(row, column) / 32));
+            }
+        }
+        channels.push_back(noise);
+    }
+
+    auto image = PPMImage<float>(200, 150, channels[0], channels[1], channels[2]);
+    auto expected = image.filtered(kernel, &paddingStrategy);
+
+    auto writtenBytes = QOIImage<float>::filteredToFile(&image, kernel, &paddingStrategy, path, 17);
+    EXPECT_EQ(writtenBytes, std::filesystem::file_size(path.string() + ".qoi"));
+    EXPECT_LT(writtenBytes, 200 * 150 * 3 / 2);
+
+    auto loadedImage = QOIImage<float>::loadImage(path.string() + ".qoi");
+    ASSERT_NE(loadedImage, nullptr);
+
+    for (unsigned int k = 0; k < 3; k++) {
+        for (unsigned int row = 0; row < 150; row++) {
+            for (unsigned int column = 0; column < 200; column++) {
+                EXPECT_EQ(loadedImage->getChannel(k)->at(row, column), expected->getChannel(k)->at(row, column));
+            }
+        }
+    }
+
+    // Gray images are stored as gray RGB pixels.
+    auto grayImage = PGMImage<float>(200, 150, new Channel<float>(255, channels[1]));
+    QOIImage<float>::filteredToFile(&grayImage, kernel, &paddingStrategy, path);
+
+    auto loadedGrayImage = QOIImage<float>::loadImage(path.string() + ".qoi");
+    ASSERT_NE(loadedGrayImage, nullptr);
+    for (unsigned int k = 0; k < 3; k++) {
+        EXPECT_EQ(loadedGrayImage->getChannel(k)->at(75, 100), expected->getChannel(1)->at(75, 100));
+    }
+
+    std::filesystem::remove(path.string() + ".qoi");
+    delete loadedGrayImage;
+    delete loadedImage;
+    delete expected;
+    delete kernel;
+}
+
+TEST(QOIImageTests, SixteenBitImagesAreRejected) {
+    auto matrix = Matrix<float>::random(10, 12);
+    auto image = PGMImage<float>(12, 10, new Channel<float>(65535, &matrix));
+    auto kernel = Kernels::gaussianKernel<float>(3, 0.8);
+    auto paddingStrategy = PeriodicExtensionMatrixPaddingStrategy<float>();
+    auto path = temporaryPathFor("testQOISixteenBit");
+
+    EXPECT_THROW(QOIImage<float>::fromImage(&image), std::invalid_argument);
+    EXPECT_THROW(QOIImage<float>::filteredToFile(&image, kernel, &paddingStrategy, path), std::invalid_argument);
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".qoi"));
+
+    delete kernel;
+}
+
+TEST(QOIImageTests, InvalidFilesAreNotLoaded) {
+    auto path = temporaryPathFor("testQOIInvalid");
+    auto image = PPMImage<float>(20, 20, roundedRandomChannel(20, 20), roundedRandomChannel(20, 20), roundedRandomChannel(20, 20));
+    auto qoiImage = QOIImage<float>::fromImage(&image);
+    qoiImage->writeToFile(path, ImageChannelsEncoding::BINARY);
+
+    auto qoiPath = path.string() + ".qoi";
+    std::filesystem::resize_file(qoiPath, std::filesystem::file_size(qoiPath) / 2);
+    EXPECT_EQ(QOIImage<float>::loadImage(qoiPath), nullptr);
+
+    {
+        auto file = std::ofstream(qoiPath, std::ios::trunc | std::ios::binary);
+        file << "P6\n20 20\n255\n";
+    }
+    EXPECT_EQ(QOIImage<float>::loadImage(qoiPath), nullptr);
+    EXPECT_EQ(QOIImage<float>::loadImage(qoiPath + ".missing"), nullptr);
+
+    // A valid header announcing far more pixels than the file can encode.
+    {
+        auto file = std::ofstream(qoiPath, std::ios::trunc | std::ios::binary);
+        QOIHeader{20000, 20000, 3, 0}.writeTo(file);
+        file.write("\0\0\0\0\0\0\0\1", 8);
+    }
+    EXPECT_EQ(std::filesystem::file_size(qoiPath), QOI_HEADER_SIZE + QOI_END_MARKER_SIZE);
+    EXPECT_EQ(QOIImage<float>::loadImage(qoiPath), nullptr);
+
+    std::filesystem::remove(qoiPath);
+    delete qoiImage;
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "../../Source/Core/Instrumentation/Instrumentation.h"
+
+TEST(InstrumentationTests, NestedScopesAreRecordedWithTheirDepth) {
+    auto& instrumentation = Instrumentation::shared();
+    instrumentation.reset();
+
+    {
+        Instrumentation::Scope outer("outer");
+        Instrumentation::Scope inner("inner");
+    }
+
+    auto events = instrumentation.getEvents();
+    ASSERT_EQ(events.size(), 2);
+
+    EXPECT_EQ(events[0].stage, "inner");
+    EXPECT_EQ(events[0].depth, 1);
+    EXPECT_EQ(events[1].stage, "outer");
+    EXPECT_EQ(events[1].depth, 0);
+    EXPECT_LE(events[1].startNanoseconds, events[0].startNanoseconds);
+    EXPECT_GE(events[1].durationNanoseconds, events[0].durationNanoseconds);
+
+    instrumentation.reset();
+    EXPECT_TRUE(instrumentation.getEvents().empty());
+}
+
+TEST(InstrumentationTests, ExportsSummaryAndTraceEvents) {
+    Instrumentation instrumentation;
+
+    instrumentation.recordEvent("loadImage", 0, 0, 4000);
+    instrumentation.recordEvent("parseHeader", 1, 0, 1000);
+    std::thread([&instrumentation] {
+        instrumentation.recordEvent("filtered", 0, 2000, 6000);
+    }).join();
+
+    instrumentation.addToCounter(InstrumentationCounter::BYTES_READ, 1024);
+    instrumentation.addToCounter(InstrumentationCounter::BYTES_READ, 1024);
+    instrumentation.addToCounter(InstrumentationCounter::PIXELS_PROCESSED, 64);
+    EXPECT_EQ(instrumentation.getCounter(InstrumentationCounter::BYTES_READ), 2048);
+
+    auto json = instrumentation.toJSON();
+    EXPECT_NE(json.find("\"wallNanoseconds\":6000"), std::string::npos);
+    EXPECT_NE(json.find("\"loadImage\":{\"count\":1,\"totalNanoseconds\":4000,\"maxNanoseconds\":4000}"), std::string::npos);
+    EXPECT_NE(json.find("\"bytesRead\":2048"), std::string::npos);
+    EXPECT_NE(json.find("\"pixelsProcessed\":64"), std::string::npos);
+    EXPECT_NE(json.find("{\"thread\":0,\"busyNanoseconds\":4000"), std::string::npos);
+    EXPECT_NE(json.find("{\"thread\":1,\"busyNanoseconds\":4000"), std::string::npos);
+
+    auto trace = instrumentation.toChromeTrace();
+    EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0);
+    EXPECT_NE(trace.find("{\"name\":\"filtered\",\"cat\":\"ImageConvolutionKernel\",\"ph\":\"X\",\"ts\":2,\"dur\":4,\"pid\":1,\"tid\":1}"), std::string::npos);
+    EXPECT_NE(trace.find("\"ph\":\"C\""), std::string::npos);
+}
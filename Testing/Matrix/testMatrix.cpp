@@ -99,6 +99,43 @@ TEST(MatrixTest, MirroringPadding) {
     }
 }
 
+TEST(MatrixTest, TiledLayout) {
+    unsigned int rows = 70;
+    unsigned int columns = 45;
+
+    auto isUsed = std::vector<bool>(rows * columns, false);
+    auto elements = std::vector<float>(rows * columns);
+
+    for (unsigned int i = 0; i < rows; i++) {
+        for (unsigned int j = 0; j < columns; j++) {
+            auto flatIndex = flatIndexOf(i, j, rows, columns, TILED);
+
+            ASSERT_LT(flatIndex, rows * columns);
+            EXPECT_FALSE(isUsed[flatIndex]);
+
+            isUsed[flatIndex] = true;
+            elements[flatIndex] = static_cast<float>(i * columns + j);
+        }
+    }
+
+    // Rows of a tile are contiguous, and the tiles of the last band are cropped to the matrix.
+    EXPECT_EQ(flatIndexOf(0, 1, rows, columns, TILED), 1);
+    EXPECT_EQ(flatIndexOf(1, 0, rows, columns, TILED), MATRIX_TILE_SIZE);
+    EXPECT_EQ(flatIndexOf(64, 32, rows, columns, TILED), 64 * columns + 32 * 6);
+
+    auto tiledMatrix = Matrix<float>(elements.data(), rows, columns, TILED);
+    auto itsTranspose = tiledMatrix.transposed();
+
+    for (unsigned int i = 0; i < rows; i++) {
+        for (unsigned int j = 0; j < columns; j++) {
+            EXPECT_EQ(tiledMatrix.at(i, j), static_cast<float>(i * columns + j));
+            EXPECT_EQ(itsTranspose->at(j, i), tiledMatrix.at(i, j));
+        }
+    }
+
+    delete itsTranspose;
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
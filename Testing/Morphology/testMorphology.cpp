@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "../../Source/Core/Morphology/Morphology.h"
+#include "../../Source/Core/Scheduler/WorkStealingScheduler.h"
+#include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(MorphologyTests, MatchesScanningTheElement) {
+    auto zeroPadding = new ZeroPaddingMatrixPaddingStrategy<float>();
+    auto periodicPadding = new PeriodicExtensionMatrixPaddingStrategy<float>();
+    auto scheduler = WorkStealingScheduler(3);
+
+    for (auto layout : {ROW_MAJOR, TILED}) {
+        auto matrix = Matrix<float>::random(45, 62, layout);
+        auto channel = new Channel<float>(255, &matrix);
+
+        for (const MatrixPaddingStrategy<float>* paddingStrategy : {(const MatrixPaddingStrategy<float>*) zeroPadding, (const MatrixPaddingStrategy<float>*) periodicPadding}) {
+            for (auto [elementRows, elementColumns] : {std::pair(1u, 1u), std::pair(3u, 5u), std::pair(7u, 3u), std::pair(11u, 11u)}) {
+                auto morphology = Morphology<float>(elementRows, elementColumns, paddingStrategy);
+
+                auto erodedChannel = morphology.eroded(channel);
+                auto dilatedChannel = morphology.dilated(channel, &scheduler);
+
+                EXPECT_EQ(erodedChannel->getMatrixLayout(), layout);
+
+                for (int i = 0; i < 45; i++) {
+                    for (int j = 0; j < 62; j++) {
+                        auto minValue = paddingStrategy->pad(*channel, i, j);
+                        auto maxValue = minValue;
+
+                        for (int k = -static_cast<int>(elementRows / 2); k <= static_cast<int>(elementRows / 2); k++) {
+                            for (int l = -static_cast<int>(elementColumns / 2); l <= static_cast<int>(elementColumns / 2); l++) {
+                                minValue = std::min(minValue, paddingStrategy->pad(*channel, i + k, j + l));
+                                maxValue = std::max(maxValue, paddingStrategy->pad(*channel, i + k, j + l));
+                            }
+                        }
+
+                        EXPECT_EQ(erodedChannel->at(i, j), minValue);
+                        EXPECT_EQ(dilatedChannel->at(i, j), maxValue);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(MorphologyTests, WorkersMatchASingleThread) {
+    // Large enough to be split across the workers.
+    auto matrix = Matrix<float>::random(300, 410);
+    auto channel = new Channel<float>(255, &matrix);
+    auto morphology = Morphology<float>(15, 9, new PeriodicExtensionMatrixPaddingStrategy<float>());
+    auto scheduler = WorkStealingScheduler(4);
+
+    auto expectedChannel = morphology.closed(channel);
+    auto closedChannel = morphology.closed(channel, &scheduler);
+
+    for (int i = 0; i < 300; i++) {
+        for (int j = 0; j < 410; j++) {
+            EXPECT_EQ(closedChannel->at(i, j), expectedChannel->at(i, j));
+        }
+    }
+}
+
+TEST(MorphologyTests, OpeningAndClosingOfAMask) {
+    // A 12x12 square with a one pixel hole, and a speck of noise.
+    auto elements = std::vector<double>(30 * 30, 0);
+    for (int i = 5; i < 17; i++) {
+        for (int j = 5; j < 17; j++) {
+            elements[i * 30 + j] = 255;
+        }
+    }
+
+    elements[10 * 30 + 10] = 0;
+    elements[25 * 30 + 25] = 255;
+
+    auto channel = new Channel<double>(255, elements.data(), 30, 30);
+    auto morphology = Morphology<double>(3, 3, new ZeroPaddingMatrixPaddingStrategy<double>());
+
+    auto openedChannel = morphology.opened(channel);
+    auto closedChannel = morphology.closed(channel);
+
+    // Opening removes the speck and keeps the square, closing fills the hole.
+    EXPECT_EQ(openedChannel->at(25, 25), 0);
+    EXPECT_EQ(openedChannel->at(6, 6), 255);
+    EXPECT_EQ(closedChannel->at(10, 10), 255);
+    EXPECT_EQ(closedChannel->at(25, 25), 255);
+
+    // Opening is anti-extensive, closing extensive.
+    for (int i = 0; i < 30; i++) {
+        for (int j = 0; j < 30; j++) {
+            EXPECT_LE(openedChannel->at(i, j), channel->at(i, j));
+            EXPECT_GE(closedChannel->at(i, j), channel->at(i, j));
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+#include "../../Source/Core/Pipeline/ImagePipeline.h"
+#include "../../Source/Core/Image/ImageFormats/PPM/PPMImage.h"
+#include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+
+static void writeMockPPM(const std::filesystem::path& filepath, unsigned int width, unsigned int height, unsigned int seed) {
+    std::ofstream fileHandle(filepath);
+    fileHandle << "P3" << std::endl << width << " " << height << std::endl << 255 << std::endl;
+
+    for (unsigned int i = 0; i < width * height * 3; i++) {
+        fileHandle << (i * 7 + seed * 13) % 256 << " ";
+    }
+}
+
+TEST(ImagePipelineTests, FiltersEveryJobOfTheBatch) {
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "testImagePipeline";
+    std::filesystem::create_directories(tempDir);
+
+    auto jobs = std::vector<ImagePipelineJob>();
+    for (unsigned int i = 0; i < 6; i++) {
+        auto input = tempDir / ("input" + std::to_string(i) + ".ppm");
+        writeMockPPM(input, 5 + i, 4 + i, i);
+        jobs.push_back({input, tempDir / ("output" + std::to_string(i))});
+    }
+    jobs.push_back({tempDir / "missing.ppm", tempDir / "missing_output"});
+
+    float identityValues[9] = {0, 0, 0, 0, 1, 0, 0, 0, 0};
+    auto identity = new ConvolutionKernel<float>(identityValues, 3, 3);
+    auto strategy = new ZeroPaddingMatrixPaddingStrategy<float>();
+
+    auto pipeline = ImagePipeline<float, PPMImage<float>>(identity, strategy, ImageChannelsEncoding::BINARY, 2, 2);
+    auto results = pipeline.run(jobs);
+
+    ASSERT_EQ(results.size(), jobs.size());
+    for (unsigned int i = 0; i < 6; i++) {
+        EXPECT_TRUE(results[i].succeeded);
+        EXPECT_EQ(results[i].job.input, jobs[i].input);
+
+        auto original = NetpbmImage<float, PPMImage<float>>::loadImage(jobs[i].input);
+        auto written = NetpbmImage<float, PPMImage<float>>::loadImage(jobs[i].output.string() + ".ppm");
+        ASSERT_NE(written, nullptr);
+        ASSERT_EQ(written->getWidth(), original->getWidth());
+        ASSERT_EQ(written->getHeight(), original->getHeight());
+
+        for (int k = 0; k < original->getChannelsCount(); k++) {
+            for (int row = 0; row < original->getHeight(); row++) {
+                for (int column = 0; column < original->getWidth(); column++) {
+                    EXPECT_FLOAT_EQ(written->getChannel(k)->at(row, column), original->getChannel(k)->at(row, column));
+                }
+            }
+        }
+    }
+
+    EXPECT_FALSE(results.back().succeeded);
+    EXPECT_FALSE(results.back().error.empty());
+
+    std::filesystem::remove_all(tempDir);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+#include "../../Source/Core/Plan/ConvolutionPlan.h"
+#include "../../Source/Core/Scheduler/WorkStealingScheduler.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(ConvolutionPlanTests, ExactPlansMatchDirectFiltering) {
+    ConvolutionWisdom::shared().forget();
+
+    auto scheduler = WorkStealingScheduler(4);
+    auto kernel = Kernels::gaussianKernel<double>(5, 1.2);
+    auto paddingStrategy = PeriodicExtensionMatrixPaddingStrategy<double>();
+
+    for (auto layout : {ROW_MAJOR, COLUMN_MAJOR, TILED}) {
+        auto matrix = Matrix<double>::random(83, 71, layout);
+        auto channel = Channel<double>(255, &matrix);
+        auto expected = channel.filtered(kernel, &paddingStrategy);
+
+        for (auto mode : {PlanningMode::ESTIMATE, PlanningMode::MEASURE}) {
+            auto plan = ConvolutionPlan<double>(kernel, 83, 71, layout, &paddingStrategy, mode, &scheduler);
+            ASSERT_TRUE(plan.getStrategy() == ConvolutionStrategy::DIRECT || plan.getStrategy() == ConvolutionStrategy::DIRECT_PARALLEL);
+
+            auto filtered = channel.filtered(&plan);
+            for (unsigned int row = 0; row < 83; row++) {
+                for (unsigned int column = 0; column < 71; column++) {
+                    EXPECT_EQ(filtered->at(row, column), expected->at(row, column));
+                }
+            }
+
+            delete filtered;
+        }
+
+        delete expected;
+    }
+
+    delete kernel;
+}
+
+TEST(ConvolutionPlanTests, EstimatesFromTheShapes) {
+    ConvolutionWisdom::shared().forget();
+
+    auto scheduler = WorkStealingScheduler(2);
+    auto paddingStrategy = ZeroPaddingMatrixPaddingStrategy<float>();
+    auto smallKernel = Kernels::gaussianKernel<float>(3, 1.0);
+    auto wideKernel = Kernels::gaussianKernel<float>(7, 2.0);
+
+    EXPECT_EQ(ConvolutionPlan<float>(smallKernel, 64, 64, ROW_MAJOR, &paddingStrategy).getStrategy(), ConvolutionStrategy::DIRECT);
+    EXPECT_EQ(ConvolutionPlan<float>(smallKernel, 64, 64, ROW_MAJOR, &paddingStrategy, PlanningMode::ESTIMATE, &scheduler).getStrategy(), ConvolutionStrategy::DIRECT);
+    EXPECT_EQ(ConvolutionPlan<float>(smallKernel, 512, 512, ROW_MAJOR, &paddingStrategy, PlanningMode::ESTIMATE, &scheduler).getStrategy(), ConvolutionStrategy::DIRECT_PARALLEL);
+    EXPECT_EQ(ConvolutionPlan<float>(smallKernel, 64, 64, ROW_MAJOR, &paddingStrategy, PlanningMode::ESTIMATE, nullptr, true).getStrategy(), ConvolutionStrategy::WINOGRAD);
+    EXPECT_EQ(ConvolutionPlan<float>(wideKernel, 64, 64, ROW_MAJOR, &paddingStrategy, PlanningMode::ESTIMATE, nullptr, true).getStrategy(), ConvolutionStrategy::SEPARABLE);
+
+    // Estimating records nothing.
+    EXPECT_EQ(ConvolutionWisdom::shared().getEntriesCount(), 0);
+
+    delete smallKernel;
+    delete wideKernel;
+}
+
+TEST(ConvolutionPlanTests, RoundoffPlansStayCloseToDirectFiltering) {
+    ConvolutionWisdom::shared().forget();
+
+    auto paddingStrategy = ZeroPaddingMatrixPaddingStrategy<double>();
+    auto matrix = Matrix<double>::random(40, 52);
+    auto channel = Channel<double>(255, &matrix);
+
+    for (unsigned int size : {3u, 7u}) {
+        auto kernel = Kernels::gaussianKernel<double>(size, 1.5);
+        auto plan = ConvolutionPlan<double>(kernel, 40, 52, ROW_MAJOR, &paddingStrategy, PlanningMode::ESTIMATE, nullptr, true);
+        ASSERT_EQ(plan.getStrategy(), size == 3 ? ConvolutionStrategy::WINOGRAD : ConvolutionStrategy::SEPARABLE);
+
+        auto expected = channel.filtered(kernel, &paddingStrategy);
+        auto filtered = Channel<double>(255, &matrix);
+        channel.filteredInto(&filtered, &plan);
+
+        for (unsigned int row = 0; row < 40; row++) {
+            for (unsigned int column = 0; column < 52; column++) {
+                EXPECT_LE(std::abs(filtered.at(row, column) - expected->at(row, column)), 1);
+            }
+        }
+
+        delete expected;
+        delete kernel;
+    }
+}
+
+TEST(ConvolutionPlanTests, MeasuringRecordsWisdomThatOutlivesTheProcess) {
+    auto& wisdom = ConvolutionWisdom::shared();
+    wisdom.forget();
+
+    auto scheduler = WorkStealingScheduler(2);
+    auto kernel = Kernels::gaussianKernel<float>(3, 1.0);
+    auto paddingStrategy = ZeroPaddingMatrixPaddingStrategy<float>();
+
+    auto measuredPlan = ConvolutionPlan<float>(kernel, 96, 80, TILED, &paddingStrategy, PlanningMode::MEASURE, &scheduler, true);
+    EXPECT_FALSE(measuredPlan.isPlannedFromWisdom());
+    ASSERT_EQ(wisdom.getEntriesCount(), 1);
+
+    auto recorded = wisdom.lookup(measuredPlan.getSignature());
+    ASSERT_TRUE(recorded.has_value());
+    EXPECT_EQ(recorded->strategy, measuredPlan.getStrategy());
+    EXPECT_EQ(recorded->spansCount, measuredPlan.getSpansCount());
+
+    auto wisdomPath = std::filesystem::temp_directory_path() / ("ImageConvolutionKernelWisdom" + std::to_string(getpid()));
+    ASSERT_TRUE(wisdom.save(wisdomPath));
+    wisdom.forget();
+
+    // What a later run does at startup; an estimated plan then reuses the measured strategy.
+    ASSERT_TRUE(wisdom.load(wisdomPath));
+    auto plan = ConvolutionPlan<float>(kernel, 96, 80, TILED, &paddingStrategy, PlanningMode::ESTIMATE, &scheduler, true);
+    EXPECT_TRUE(plan.isPlannedFromWisdom());
+    EXPECT_EQ(plan.getStrategy(), measuredPlan.getStrategy());
+    EXPECT_EQ(plan.getSpansCount(), measuredPlan.getSpansCount());
+
+    // Another shape, another signature.
+    auto otherPlan = ConvolutionPlan<float>(kernel, 96, 81, TILED, &paddingStrategy, PlanningMode::ESTIMATE, &scheduler, true);
+    EXPECT_FALSE(otherPlan.isPlannedFromWisdom());
+
+    std::filesystem::remove(wisdomPath);
+    delete kernel;
+}
+
+TEST(ConvolutionPlanTests, WisdomUnusableByAPlanIsIgnored) {
+    auto& wisdom = ConvolutionWisdom::shared();
+    wisdom.forget();
+
+    auto kernel = Kernels::gaussianKernel<double>(5, 1.0);
+    auto paddingStrategy = ZeroPaddingMatrixPaddingStrategy<double>();
+    auto signature = ConvolutionPlan<double>(kernel, 30, 30, ROW_MAJOR, &paddingStrategy).getSignature();
+
+    auto wisdomPath = std::filesystem::temp_directory_path() / ("ImageConvolutionKernelWisdom" + std::to_string(getpid()));
+    {
+        auto file = std::ofstream(wisdomPath);
+        file << "# comment\n\nmalformed line\n" << signature << " fourier 1\n";
+    }
+
+    ASSERT_TRUE(wisdom.load(wisdomPath));
+    EXPECT_EQ(wisdom.getEntriesCount(), 0);
+
+    // An exact plan without a scheduler can't run the separable nor the parallel engines.
+    wisdom.record(signature, {ConvolutionStrategy::SEPARABLE, 1});
+    auto plan = ConvolutionPlan<double>(kernel, 30, 30, ROW_MAJOR, &paddingStrategy);
+    EXPECT_FALSE(plan.isPlannedFromWisdom());
+    EXPECT_EQ(plan.getStrategy(), ConvolutionStrategy::DIRECT);
+
+    EXPECT_FALSE(wisdom.load(wisdomPath.string() + ".missing"));
+
+    std::filesystem::remove(wisdomPath);
+    wisdom.forget();
+    delete kernel;
+}
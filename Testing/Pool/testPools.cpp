@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "../../Source/Core/Pool/ChannelPool.h"
+#include "../../Source/Core/Pool/ImagePool.h"
+#include "../../Source/Core/Image/ImageFormats/PPM/PPMImage.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(PoolTests, ReleasedChannelsAreReused) {
+    auto pool = ChannelPool<double>(1);
+
+    auto first = pool.acquire(255, 20, 30);
+    EXPECT_EQ(first->getRows(), 20);
+    EXPECT_EQ(first->getColumns(), 30);
+    EXPECT_EQ(first->at(5, 5), 0);
+
+    pool.release(first);
+    EXPECT_EQ(pool.getPooledChannelsCount(), 1);
+
+    // Same size and layout: the released channel, with the new maximum value.
+    auto second = pool.acquire(15, 20, 30);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(second->getMaxTheoreticalValue(), 15);
+
+    // Another layout is another bucket.
+    auto tiled = pool.acquire(255, 20, 30, TILED);
+    EXPECT_NE(tiled, first);
+    EXPECT_EQ(tiled->getMatrixLayout(), TILED);
+
+    EXPECT_EQ(pool.getAllocatedChannelsCount(), 2);
+    EXPECT_EQ(pool.getReusedChannelsCount(), 1);
+
+    // Beyond the bucket capacity, released channels are deleted.
+    pool.release(second);
+    pool.release(pool.acquire(255, 20, 30));
+    pool.release(new Channel<double>(255, std::vector<double>(600, 0).data(), 20, 30));
+    EXPECT_EQ(pool.getPooledChannelsCount(), 1);
+
+    pool.release(tiled);
+    EXPECT_EQ(pool.getPooledChannelsCount(), 2);
+}
+
+TEST(PoolTests, FilteringIntoPooledBuffersMatchesFiltering) {
+    auto kernel = Kernels::gaussianKernel<float>(5, 1.0);
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    auto channelPool = ChannelPool<float>();
+    auto imagePool = ImagePool<float, PPMImage<float>>();
+
+    for (auto layout : {ROW_MAJOR, TILED}) {
+        for (int iteration = 0; iteration < 3; iteration++) {
+            auto matrix = Matrix<float>::random(37, 41, layout);
+            auto channel = new Channel<float>(255, &matrix);
+            auto expectedChannel = channel->filtered(kernel, paddingStrategy);
+
+            auto pooledChannel = channelPool.acquire(255, 37, 41, layout);
+            channel->filteredInto(pooledChannel, kernel, paddingStrategy);
+
+            auto image = PPMImage<float>::withChannels(41, 37, {
+                channel,
+                new Channel<float>(255, &matrix),
+                new Channel<float>(255, &matrix)
+            });
+            auto pooledImage = imagePool.acquire(image);
+            image->filteredInto(pooledImage, kernel, paddingStrategy);
+
+            for (int i = 0; i < 37; i++) {
+                for (int j = 0; j < 41; j++) {
+                    EXPECT_EQ(pooledChannel->at(i, j), expectedChannel->at(i, j));
+                    EXPECT_EQ(pooledImage->getChannel(2)->at(i, j), expectedChannel->at(i, j));
+                }
+            }
+
+            channelPool.release(pooledChannel);
+            imagePool.release(pooledImage);
+
+            delete expectedChannel;
+            delete image;
+        }
+    }
+
+    // After the first image of each layout, every buffer comes from the pools.
+    EXPECT_EQ(channelPool.getAllocatedChannelsCount(), 2);
+    EXPECT_EQ(channelPool.getReusedChannelsCount(), 4);
+    EXPECT_EQ(imagePool.getAllocatedImagesCount(), 2);
+    EXPECT_EQ(imagePool.getReusedImagesCount(), 4);
+}
+
+TEST(PoolTests, PointOperationsIntoPooledBuffersMatchTheirCopies) {
+    auto pool = ChannelPool<double>();
+
+    for (auto layout : {ROW_MAJOR, TILED}) {
+        auto matrix = Matrix<double>::random(23, 70, layout);
+        auto channel = new Channel<double>(255, &matrix);
+
+        auto expectedNormalized = channel->normalized();
+        auto expectedClamped = channel->clamped(20, 60);
+        auto expectedTransposed = channel->transposedChannel();
+
+        auto pooledChannel = pool.acquire(255, 23, 70, layout);
+        auto pooledTransposed = pool.acquire(255, 70, 23, layout);
+
+        channel->normalizedInto(pooledChannel);
+        EXPECT_EQ(pooledChannel->getMaxTheoreticalValue(), 1);
+        for (int i = 0; i < 23; i++) {
+            for (int j = 0; j < 70; j++) {
+                EXPECT_EQ(pooledChannel->at(i, j), expectedNormalized->at(i, j));
+            }
+        }
+
+        channel->clampedInto(pooledChannel, 20, 60);
+        EXPECT_EQ(pooledChannel->getMaxTheoreticalValue(), 255);
+        channel->transposedInto(pooledTransposed);
+        for (int i = 0; i < 23; i++) {
+            for (int j = 0; j < 70; j++) {
+                EXPECT_EQ(pooledChannel->at(i, j), expectedClamped->at(i, j));
+                EXPECT_EQ(pooledTransposed->at(j, i), channel->at(i, j));
+                EXPECT_EQ(expectedTransposed->at(j, i), channel->at(i, j));
+            }
+        }
+
+        pool.release(pooledChannel);
+        pool.release(pooledTransposed);
+
+        delete expectedNormalized;
+        delete expectedClamped;
+        delete expectedTransposed;
+        delete channel;
+    }
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "../../Source/Core/Pyramid/GaussianPyramid.h"
+#include "../../Source/Core/Image/ImageFormats/PPM/PPMImage.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/ConvolutionKernel/KernelCache/KernelCache.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(GaussianPyramidTests, StridedFilteringMatchesDecimatedFiltering) {
+    float crossElements[] = {
+        0.0, 0.2, 0.0,
+        0.2, 0.1, 0.3,
+        0.0, 0.2, 0.0
+    };
+
+    auto separableKernel = Kernels::gaussianKernel<float>(5, 1.0);
+    auto nonSeparableKernel = new ConvolutionKernel<float>(crossElements, 3, 3);
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    ASSERT_TRUE(separableKernel->isSeparable());
+    ASSERT_FALSE(nonSeparableKernel->isSeparable());
+
+    for (auto layout : {ROW_MAJOR, COLUMN_MAJOR, TILED}) {
+        auto matrix = Matrix<float>::random(45, 38, layout);
+        auto channel = new Channel(255, &matrix);
+
+        for (unsigned int stride : {2, 3}) {
+            for (auto kernel : {separableKernel, nonSeparableKernel}) {
+                auto expectedChannel = channel->filtered(kernel, paddingStrategy);
+                auto stridedChannel = channel->filteredStrided(kernel, paddingStrategy, stride);
+
+                ASSERT_EQ(stridedChannel->getRows(), (45 + stride - 1) / stride);
+                ASSERT_EQ(stridedChannel->getColumns(), (38 + stride - 1) / stride);
+                EXPECT_EQ(stridedChannel->getMatrixLayout(), layout);
+
+                for (int i = 0; i < stridedChannel->getRows(); i++) {
+                    for (int j = 0; j < stridedChannel->getColumns(); j++) {
+                        // The separable passes round differently, which may flip the rounding of the saturated value.
+                        auto tolerance = kernel->isSeparable() ? 1.0f : 0.0f;
+                        EXPECT_NEAR(stridedChannel->at(i, j), expectedChannel->at(i * stride, j * stride), tolerance);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(GaussianPyramidTests, LevelsHalveThePreviousOne) {
+    auto channel = [] {
+        auto matrix = Matrix<float>::random(37, 50);
+        return new Channel<float>(255, &matrix);
+    };
+
+    auto image = new PPMImage<float>(50, 37, channel(), channel(), channel());
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    auto pyramid = GaussianPyramid<float, PPMImage<float>>(paddingStrategy, 5, 1.0);
+    auto levels = pyramid.levels(image, 3);
+
+    ASSERT_EQ(levels.size(), 3);
+    unsigned int expectedSizes[3][2] = {{25, 19}, {13, 10}, {7, 5}};
+
+    for (int level = 0; level < 3; level++) {
+        EXPECT_EQ(levels[level]->getWidth(), expectedSizes[level][0]);
+        EXPECT_EQ(levels[level]->getHeight(), expectedSizes[level][1]);
+        EXPECT_EQ(levels[level]->getChannel(0)->getColumns(), expectedSizes[level][0]);
+        EXPECT_EQ(levels[level]->getChannel(0)->getRows(), expectedSizes[level][1]);
+    }
+
+    auto firstLevel = image->filteredStrided(KernelCache<float>::gaussianKernel(5, 1.0), paddingStrategy, 2);
+    for (int k = 0; k < 3; k++) {
+        for (int i = 0; i < 19; i++) {
+            for (int j = 0; j < 25; j++) {
+                EXPECT_FLOAT_EQ(levels[0]->getChannel(k)->at(i, j), firstLevel->getChannel(k)->at(i, j));
+            }
+        }
+    }
+}
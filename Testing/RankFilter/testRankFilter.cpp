@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+#include "../../Source/Core/RankFilter/RankFilter.h"
+#include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(RankFilterTests, MatchesSortingEachWindow) {
+    auto zeroPadding = new ZeroPaddingMatrixPaddingStrategy<double>();
+    auto periodicPadding = new PeriodicExtensionMatrixPaddingStrategy<double>();
+    auto randomEngine = std::mt19937(7);
+
+    for (unsigned int maxValue : {255u, 65535u}) {
+        auto distribution = std::uniform_int_distribution<unsigned int>(0, maxValue);
+
+        // Wide enough for 16 bit channels to be split in stripes.
+        auto elements = std::vector<double>(29 * 77);
+        for (auto& element : elements) {
+            element = distribution(randomEngine);
+        }
+
+        for (auto layout : {ROW_MAJOR, TILED}) {
+            auto matrix = Matrix<double>(elements.data(), 29, 77);
+            auto channel = (new Channel<double>(maxValue, &matrix))->withLayout(layout);
+
+            for (const MatrixPaddingStrategy<double>* paddingStrategy : {(const MatrixPaddingStrategy<double>*) zeroPadding, (const MatrixPaddingStrategy<double>*) periodicPadding}) {
+                for (unsigned int radius : {1u, 3u}) {
+                    auto rankFilter = RankFilter<double>(radius, paddingStrategy);
+                    auto windowSize = rankFilter.getWindowSize();
+
+                    auto medianChannel = rankFilter.median(channel);
+                    auto minimumChannel = rankFilter.minimum(channel);
+                    auto maximumChannel = rankFilter.maximum(channel);
+                    auto percentileChannel = rankFilter.percentile(channel, 25);
+
+                    EXPECT_EQ(medianChannel->getMatrixLayout(), layout);
+                    EXPECT_EQ(medianChannel->getMaxTheoreticalValue(), maxValue);
+
+                    for (int i = 0; i < 29; i++) {
+                        for (int j = 0; j < 77; j++) {
+                            auto window = std::vector<double>();
+                            for (int k = -static_cast<int>(radius); k <= static_cast<int>(radius); k++) {
+                                for (int l = -static_cast<int>(radius); l <= static_cast<int>(radius); l++) {
+                                    window.push_back(paddingStrategy->pad(*channel, i + k, j + l));
+                                }
+                            }
+
+                            std::sort(window.begin(), window.end());
+
+                            EXPECT_EQ(medianChannel->at(i, j), window[windowSize / 2]);
+                            EXPECT_EQ(minimumChannel->at(i, j), window.front());
+                            EXPECT_EQ(maximumChannel->at(i, j), window.back());
+                            EXPECT_EQ(percentileChannel->at(i, j), window[std::lround(0.25 * (windowSize - 1))]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(RankFilterTests, MedianRemovesSaltAndPepperNoise) {
+    auto elements = std::vector<float>(40 * 40, 120);
+    auto randomEngine = std::mt19937(3);
+    auto pixelDistribution = std::uniform_int_distribution(0, 40 * 40 - 1);
+
+    // Isolated pixels: no window of radius 1 holds more than a few of them.
+    for (int i = 0; i < 30; i++) {
+        elements[pixelDistribution(randomEngine)] = i % 2 == 0 ? 0 : 255;
+    }
+
+    auto channel = new Channel<float>(255, elements.data(), 40, 40);
+    auto medianChannel = RankFilter<float>(1, new PeriodicExtensionMatrixPaddingStrategy<float>()).median(channel);
+
+    auto noisyPixels = 0;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            noisyPixels += medianChannel->at(i, j) != 120;
+        }
+    }
+
+    EXPECT_EQ(noisyPixels, 0);
+}
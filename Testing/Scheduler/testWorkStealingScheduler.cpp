@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+
+#include "../../Source/Core/Scheduler/WorkStealingScheduler.h"
+#include "../../Source/Core/Image/ImageFormats/PPM/PPMImage.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(WorkStealingSchedulerTests, RunsEveryTaskIncludingNestedOnes) {
+    WorkStealingScheduler scheduler(4);
+    std::atomic<int> executed = 0;
+
+    for (int i = 0; i < 100; i++) {
+        scheduler.submit([&scheduler, &executed] {
+            executed++;
+
+            for (int j = 0; j < 10; j++) {
+                scheduler.submit([&executed] { executed++; });
+            }
+        });
+    }
+
+    scheduler.wait();
+
+    EXPECT_EQ(executed, 1100);
+    EXPECT_EQ(scheduler.getStatistics().executedTasks, 1100);
+
+    scheduler.resetStatistics();
+    EXPECT_EQ(scheduler.getStatistics().executedTasks, 0);
+}
+
+TEST(WorkStealingSchedulerTests, RethrowsTaskFailuresOnWait) {
+    WorkStealingScheduler scheduler(2);
+
+    scheduler.submit([] { throw std::runtime_error("failed task"); });
+    EXPECT_THROW(scheduler.wait(), std::runtime_error);
+
+    std::atomic<int> executed = 0;
+    scheduler.submit([&executed] { executed++; });
+    EXPECT_NO_THROW(scheduler.wait());
+    EXPECT_EQ(executed, 1);
+}
+
+TEST(WorkStealingSchedulerTests, FilteredBatchMatchesSerialFiltering) {
+    WorkStealingScheduler scheduler(3);
+
+    auto kernel = Kernels::gaussianKernel<float>(5, 1.0);
+    auto strategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    auto images = std::vector<const NetpbmImage<float, PPMImage<float>>*>();
+    unsigned int sizes[3][2] = {{7, 5}, {64, 45}, {3, 90}};
+
+    for (auto [width, height] : sizes) {
+        auto channel = [width, height] {
+            auto matrix = Matrix<float>::random(height, width);
+            return new Channel<float>(255, &matrix);
+        };
+
+        images.push_back(new PPMImage<float>(width, height, channel(), channel(), channel()));
+    }
+
+    auto filteredImages = NetpbmImage<float, PPMImage<float>>::filteredBatch(images, kernel, strategy, scheduler, 8);
+    ASSERT_EQ(filteredImages.size(), images.size());
+
+    for (size_t i = 0; i < images.size(); i++) {
+        auto expectedImage = images[i]->filtered(kernel, strategy);
+
+        ASSERT_EQ(filteredImages[i]->getWidth(), images[i]->getWidth());
+        ASSERT_EQ(filteredImages[i]->getHeight(), images[i]->getHeight());
+
+        for (int k = 0; k < expectedImage->getChannelsCount(); k++) {
+            for (int row = 0; row < expectedImage->getHeight(); row++) {
+                for (int column = 0; column < expectedImage->getWidth(); column++) {
+                    EXPECT_FLOAT_EQ(filteredImages[i]->getChannel(k)->at(row, column), expectedImage->getChannel(k)->at(row, column));
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(scheduler.getStatistics().executedTasks, 0);
+}
+
+TEST(WorkStealingSchedulerTests, FilteredBatchRethrowsTaskFailures) {
+    struct FailingPaddingStrategy : MatrixPaddingStrategy<float> {
+        float pad(const Matrix<float>&, int, int) const override {
+            throw std::runtime_error("failed padding");
+        }
+    };
+
+    WorkStealingScheduler scheduler(2);
+    auto kernel = Kernels::gaussianKernel<float>(3, 1.0);
+    auto strategy = FailingPaddingStrategy();
+
+    auto matrix = Matrix<float>::random(20, 30);
+    auto image = PPMImage<float>(30, 20, new Channel<float>(255, &matrix), new Channel<float>(255, &matrix), new Channel<float>(255, &matrix));
+    using PPM = NetpbmImage<float, PPMImage<float>>;
+    auto images = std::vector<const PPM*>{&image};
+
+    EXPECT_THROW(PPM::filteredBatch(images, kernel, &strategy, scheduler, 4), std::runtime_error);
+
+    delete kernel;
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <thread>
+#include <unistd.h>
+
+#include "../../Source/Core/Sharding/ShardedConvolution.h"
+#include "../../Source/Core/Image/ImageFormats/PPM/PPMImage.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(ShardedConvolutionTests, MatchesFilteringTheWholeImage) {
+    auto sharded = ShardedConvolution<double>(4);
+    ASSERT_EQ(sharded.getWorkersCount(), 4);
+
+    double wideValues[21];
+    for (int i = 0; i < 21; i++) {
+        wideValues[i] = (i % 5 - 2) * 0.1;
+    }
+
+    ConvolutionKernel<double>* kernels[] = {Kernels::gaussianKernel<double>(5, 1.4), new ConvolutionKernel<double>(wideValues, 3, 7)};
+    MatrixPaddingStrategy<double>* paddingStrategies[] = {new ZeroPaddingMatrixPaddingStrategy<double>(), new PeriodicExtensionMatrixPaddingStrategy<double>()};
+
+    for (auto layout : {ROW_MAJOR, COLUMN_MAJOR, TILED}) {
+        auto channels = std::vector<Channel<double>*>();
+        for (int i = 0; i < 3; i++) {
+            auto matrix = Matrix<double>::random(97, 61, layout);
+            channels.push_back(new Channel<double>(255, &matrix));
+        }
+
+        auto image = PPMImage<double>::withChannels(61, 97, channels);
+
+        for (auto kernel : kernels) {
+            for (auto paddingStrategy : paddingStrategies) {
+                auto filtered = sharded.filtered(image, kernel, paddingStrategy);
+                ASSERT_NE(filtered, nullptr);
+
+                for (int k = 0; k < 3; k++) {
+                    auto expected = image->getChannel(k)->filtered(kernel, paddingStrategy);
+                    EXPECT_EQ(filtered->getChannel(k)->getMatrixLayout(), layout);
+
+                    for (int row = 0; row < 97; row++) {
+                        for (int column = 0; column < 61; column++) {
+                            EXPECT_EQ(filtered->getChannel(k)->at(row, column), expected->at(row, column));
+                        }
+                    }
+
+                    delete expected;
+                }
+
+                delete filtered;
+            }
+        }
+
+        delete image;
+    }
+
+    for (auto kernel : kernels) {
+        delete kernel;
+    }
+
+    for (auto paddingStrategy : paddingStrategies) {
+        delete paddingStrategy;
+    }
+}
+
+TEST(ShardedConvolutionTests, HalosCanBeTallerThanTheStrips) {
+    auto sharded = ShardedConvolution<float>(5);
+    auto kernel = Kernels::gaussianKernel<float>(7, 2.0);
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    // Fewer rows than workers: one row per strip, and a halo of three rows on each side.
+    auto matrix = Matrix<float>::random(3, 40);
+    auto channel = new Channel<float>(255, &matrix);
+    const Channel<float>* channels[] = {channel};
+
+    auto filtered = sharded.filtered(std::span<const Channel<float>* const>(channels), kernel, paddingStrategy);
+    ASSERT_EQ(filtered.size(), 1);
+
+    auto expected = channel->filtered(kernel, paddingStrategy);
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 40; column++) {
+            EXPECT_EQ(filtered[0]->at(row, column), expected->at(row, column));
+        }
+    }
+
+    delete filtered[0];
+    delete expected;
+    delete channel;
+    delete paddingStrategy;
+    delete kernel;
+}
+
+TEST(ShardedConvolutionTests, LosingAWorkerStopsThemAll) {
+    auto sharded = ShardedConvolution<float>(3);
+    ASSERT_EQ(sharded.getWorkersCount(), 3);
+
+    ASSERT_EQ(kill(sharded.workers[1].pid, SIGKILL), 0);
+
+    auto kernel = Kernels::gaussianKernel<float>(3, 1.0);
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+    auto matrix = Matrix<float>::random(30, 30);
+    auto channel = new Channel<float>(255, &matrix);
+    const Channel<float>* channels[] = {channel};
+
+    EXPECT_TRUE(sharded.filtered(std::span<const Channel<float>* const>(channels), kernel, paddingStrategy).empty());
+    EXPECT_EQ(sharded.getWorkersCount(), 0);
+    EXPECT_TRUE(sharded.filtered(std::span<const Channel<float>* const>(channels), kernel, paddingStrategy).empty());
+
+    delete channel;
+    delete paddingStrategy;
+    delete kernel;
+}
+
+TEST(ShardedConvolutionTests, WorkersServeRequestsOverPipes) {
+    int requests[2];
+    int replies[2];
+    ASSERT_EQ(pipe(requests), 0);
+    ASSERT_EQ(pipe(replies), 0);
+
+    auto servedRequests = 0u;
+    auto worker = std::thread([&] { servedRequests = ShardWorker<float>::serve(requests[0], replies[1]); });
+
+    // A 2x3 strip with a one pixel halo of zeros, filtered with a 3x3 box.
+    float kernelValues[9] = {1, 1, 1, 1, 1, 1, 1, 1, 1};
+    uint32_t maxValue = 255;
+    float block[4 * 5] = {
+        0, 0, 0, 0, 0,
+        0, 1, 2, 3, 0,
+        0, 4, 5, 6, 0,
+        0, 0, 0, 0, 0
+    };
+
+    auto header = ShardRequestHeader{SHARD_REQUEST_MAGIC, sizeof(float), 1, 4, 5, 1, 1, 2, 3, 3, 3};
+    ASSERT_TRUE(ShardTransport::writeFully(requests[1], &header, sizeof(header)));
+    ASSERT_TRUE(ShardTransport::writeFully(requests[1], kernelValues, sizeof(kernelValues)));
+    ASSERT_TRUE(ShardTransport::writeFully(requests[1], &maxValue, sizeof(maxValue)));
+    ASSERT_TRUE(ShardTransport::writeFully(requests[1], block, sizeof(block)));
+
+    float reply[6];
+    ASSERT_TRUE(ShardTransport::readFully(replies[0], reply, sizeof(reply)));
+
+    float expected[6] = {12, 21, 16, 12, 21, 16};
+    for (int i = 0; i < 6; i++) {
+        EXPECT_FLOAT_EQ(reply[i], expected[i]);
+    }
+
+    close(requests[1]);
+    worker.join();
+    EXPECT_EQ(servedRequests, 1);
+
+    close(requests[0]);
+    close(replies[0]);
+    close(replies[1]);
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <functional>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../../Source/Core/SharedMemory/SharedImage.h"
+#include "../../Source/Core/Image/ImageFormats/PPM/PPMImage.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+static std::string segmentName(const std::string& suffix) {
+    return "/testSharedImage-" + std::to_string(getpid()) + "-" + suffix;
+}
+
+static NetpbmImage<float, PPMImage<float>>* randomImage(unsigned int width, unsigned int height, MatrixLayout layout) {
+    auto channels = std::vector<Channel<float>*>();
+    for (int i = 0; i < 3; i++) {
+        auto matrix = Matrix<float>::random(height, width, layout);
+        channels.push_back(new Channel<float>(255, &matrix));
+    }
+
+    return PPMImage<float>::withChannels(width, height, channels);
+}
+
+static void expectSameImages(const Image<float>* image, const Image<float>* expected) {
+    ASSERT_EQ(image->getWidth(), expected->getWidth());
+    ASSERT_EQ(image->getHeight(), expected->getHeight());
+    ASSERT_EQ(image->getChannelsCount(), expected->getChannelsCount());
+
+    for (int k = 0; k < expected->getChannelsCount(); k++) {
+        for (int row = 0; row < expected->getHeight(); row++) {
+            for (int column = 0; column < expected->getWidth(); column++) {
+                EXPECT_FLOAT_EQ(image->getChannel(k)->at(row, column), expected->getChannel(k)->at(row, column));
+            }
+        }
+    }
+}
+
+TEST(SharedImageTests, PlanarSegmentsAreWrappedInPlace) {
+    using SharedPPM = SharedImage<float, PPMImage<float>>;
+    auto name = segmentName("planar");
+    auto image = randomImage(45, 38, TILED);
+
+    auto published = SharedPPM::publish(name, image);
+    ASSERT_NE(published, nullptr);
+    EXPECT_EQ(SharedPPM::create(name, 1, 1, 3, 255), nullptr);
+
+    // A second mapping of the same segment, as another process would get.
+    auto opened = SharedPPM::open(name);
+    ASSERT_NE(opened, nullptr);
+    EXPECT_EQ(opened->getWidth(), 45);
+    EXPECT_EQ(opened->getHeight(), 38);
+    EXPECT_EQ(opened->getChannelsCount(), 3);
+    EXPECT_EQ(opened->getMaxValue(), 255);
+    EXPECT_EQ(opened->getMatrixLayout(), TILED);
+    EXPECT_EQ(opened->getArrangement(), SampleArrangement::PLANAR);
+
+    auto wrapped = opened->wrapped();
+    EXPECT_TRUE(wrapped->getChannel(0)->isBorrowingStorage());
+    expectSameImages(wrapped, image);
+
+    // Writes through the wrapped channels land in the segment.
+    wrapped->getChannel(2)->setValue(7, 9, 42);
+    EXPECT_FLOAT_EQ(published->getSamples()[2 * 45 * 38 + flatIndexOf(7, 9, 38, 45, TILED)], 42);
+    delete wrapped;
+
+    // Another scalar type doesn't map the segment.
+    EXPECT_EQ((SharedImage<double, PPMImage<double>>::open(name)), nullptr);
+    EXPECT_EQ(SharedPPM::open(segmentName("missing")), nullptr);
+
+    delete opened;
+    delete published;
+    delete image;
+
+    EXPECT_TRUE(SharedPPM::remove(name));
+    EXPECT_EQ(SharedPPM::open(name), nullptr);
+}
+
+TEST(SharedImageTests, InconsistentHeadersAreRejected) {
+    using SharedPPM = SharedImage<float, PPMImage<float>>;
+    auto name = segmentName("inconsistent");
+    auto published = SharedPPM::create(name, 4, 4, 3, 255);
+    ASSERT_NE(published, nullptr);
+
+    // Another mapping of the header, to tamper with it as a foreign or buggy process could.
+    auto descriptor = shm_open(name.c_str(), O_RDWR, 0);
+    ASSERT_GE(descriptor, 0);
+    auto mapping = mmap(nullptr, sizeof(SharedImageHeader), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    ASSERT_NE(mapping, MAP_FAILED);
+
+    auto header = static_cast<SharedImageHeader*>(mapping);
+    auto original = *header;
+    std::function<void(SharedImageHeader&)> tamperings[] = {
+        [](SharedImageHeader& tampered) { tampered.layout = 7; },
+        [](SharedImageHeader& tampered) { tampered.arrangement = static_cast<SampleArrangement>(5); },
+        [](SharedImageHeader& tampered) { tampered.arrangement = SampleArrangement::INTERLEAVED; tampered.layout = TILED; },
+        // Its size wraps around to less than that of the segment.
+        [](SharedImageHeader& tampered) { tampered.width = 1u << 31; tampered.height = 1u << 31; tampered.channelsCount = 16; }
+    };
+
+    for (const auto& tamper : tamperings) {
+        tamper(*header);
+        EXPECT_EQ(SharedPPM::open(name), nullptr);
+        *header = original;
+    }
+
+    auto opened = SharedPPM::open(name);
+    ASSERT_NE(opened, nullptr);
+
+    // Once opened, the image keeps the header it checked: growing the image afterwards can't make it read past the segment.
+    header->width = 1u << 20;
+    header->arrangement = SampleArrangement::INTERLEAVED;
+    header->samplesOffset = 1ull << 40;
+    EXPECT_EQ(opened->getWidth(), 4);
+    EXPECT_EQ(opened->getArrangement(), SampleArrangement::PLANAR);
+
+    auto copy = opened->copied();
+    EXPECT_EQ(copy->getWidth(), 4);
+    EXPECT_EQ(copy->getHeight(), 4);
+
+    delete copy;
+    delete opened;
+    delete published;
+    munmap(mapping, sizeof(SharedImageHeader));
+    EXPECT_TRUE(SharedPPM::remove(name));
+}
+
+TEST(SharedImageTests, AnotherProcessFiltersIntoASecondSegment) {
+    using SharedPPM = SharedImage<float, PPMImage<float>>;
+    auto inputName = segmentName("input");
+    auto outputName = segmentName("output");
+
+    auto image = randomImage(70, 51, ROW_MAJOR);
+    auto kernel = Kernels::gaussianKernel<float>(5, 1.1);
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+    auto expected = image->filtered(kernel, paddingStrategy);
+
+    auto input = SharedPPM::publish(inputName, image);
+    auto output = SharedPPM::create(outputName, 70, 51, 3, 255);
+    ASSERT_NE(input, nullptr);
+    ASSERT_NE(output, nullptr);
+
+    auto child = fork();
+    ASSERT_GE(child, 0);
+
+    if (child == 0) {
+        auto childInput = SharedPPM::open(inputName);
+        auto childOutput = SharedPPM::open(outputName);
+
+        if (childInput == nullptr || childOutput == nullptr) {
+            _exit(1);
+        }
+
+        childInput->filteredInto(childOutput, kernel, paddingStrategy);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    auto filtered = output->wrapped();
+    expectSameImages(filtered, expected);
+
+    delete filtered;
+    delete input;
+    delete output;
+    delete image;
+    delete expected;
+
+    SharedPPM::remove(inputName);
+    SharedPPM::remove(outputName);
+}
+
+TEST(SharedImageTests, InterleavedSegmentsAreCopiedInAndOut) {
+    using SharedPPM = SharedImage<float, PPMImage<float>>;
+    auto inputName = segmentName("interleaved-input");
+    auto outputName = segmentName("interleaved-output");
+
+    auto image = randomImage(33, 29, ROW_MAJOR);
+    auto input = SharedPPM::publish(inputName, image, SampleArrangement::INTERLEAVED);
+    ASSERT_NE(input, nullptr);
+
+    // Red, green and blue of each pixel next to each other.
+    auto samples = input->getSamples();
+    EXPECT_FLOAT_EQ(samples[(4 * 33 + 5) * 3 + 0], image->getChannel(0)->at(4, 5));
+    EXPECT_FLOAT_EQ(samples[(4 * 33 + 5) * 3 + 1], image->getChannel(1)->at(4, 5));
+    EXPECT_FLOAT_EQ(samples[(4 * 33 + 5) * 3 + 2], image->getChannel(2)->at(4, 5));
+
+    auto copied = input->copied();
+    expectSameImages(copied, image);
+
+    // Interleaved to planar goes through a copy, and gives the same result as filtering the image.
+    auto kernel = Kernels::gaussianKernel<float>(3, 0.8);
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+    auto expected = image->filtered(kernel, paddingStrategy);
+
+    auto output = SharedPPM::create(outputName, 33, 29, 3, 255, COLUMN_MAJOR);
+    input->filteredInto(output, kernel, paddingStrategy);
+
+    auto filtered = output->wrapped();
+    expectSameImages(filtered, expected);
+
+    delete filtered;
+    delete copied;
+    delete input;
+    delete output;
+    delete image;
+    delete expected;
+
+    SharedPPM::remove(inputName);
+    SharedPPM::remove(outputName);
+}
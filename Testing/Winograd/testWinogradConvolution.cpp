@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "../../Source/Core/Winograd/WinogradConvolution.h"
+#include "../../Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
+#include "../../Source/Core/ConvolutionKernel/Kernels/EdgeKernels.cpp"
+#include "../../Source/Core/MatrixPaddingStrategy/Zero Padding/ZeroPaddingMatrixPaddingStrategy.h"
+#include "../../Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+
+TEST(WinogradConvolutionTests, ExactOnIntegerValues) {
+    float laplacianElements[] = {
+        0.0, 1.0, 0.0,
+        1.0, -4.0, 1.0,
+        0.0, 1.0, 0.0
+    };
+    float sharpenElements[] = {
+        0.0, -1.0, 0.0,
+        -1.0, 5.0, -1.0,
+        0.0, -1.0, 0.0
+    };
+
+    auto randomEngine = std::mt19937(42);
+    auto distribution = std::uniform_int_distribution(0, 255);
+
+    // Odd sizes, so that the last row and column of some blocks are computed directly.
+    auto elements = std::vector<float>(67 * 45);
+    for (auto& element : elements) {
+        element = static_cast<float>(distribution(randomEngine));
+    }
+
+    auto paddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
+
+    for (auto kernel : {new ConvolutionKernel<float>(laplacianElements, 3, 3), new ConvolutionKernel<float>(sharpenElements, 3, 3), Kernels::sobelX<float>(), Kernels::scharrY<float>()}) {
+        auto convolution = WinogradConvolution<float>(kernel);
+
+        for (auto layout : {ROW_MAJOR, TILED}) {
+            auto matrix = Matrix<float>(elements.data(), 67, 45);
+            auto channel = (new Channel<float>(255, &matrix))->withLayout(layout);
+
+            auto expectedChannel = channel->filtered(kernel, paddingStrategy);
+            auto winogradChannel = convolution.filtered(channel, paddingStrategy);
+
+            EXPECT_EQ(winogradChannel->getMatrixLayout(), layout);
+
+            // Sums of small integers and halves are exact in any order.
+            for (int i = 0; i < 67; i++) {
+                for (int j = 0; j < 45; j++) {
+                    EXPECT_EQ(winogradChannel->at(i, j), expectedChannel->at(i, j));
+                }
+            }
+        }
+    }
+}
+
+TEST(WinogradConvolutionTests, ErrorAgainstTheDirectPath) {
+    auto kernel = Kernels::gaussianKernel<float>(3, 0.8);
+    auto paddingStrategy = new ZeroPaddingMatrixPaddingStrategy<float>();
+    auto convolution = WinogradConvolution<float>(kernel);
+
+    auto matrix = Matrix<float>::random(200, 173);
+    auto channel = new Channel<float>(255, &matrix);
+
+    auto expectedChannel = channel->filtered(kernel, paddingStrategy);
+    auto winogradChannel = convolution.filtered(channel, paddingStrategy);
+
+    // Only values within roundoff of a .5 tie may round the other way.
+    auto differentPixels = 0;
+    for (int i = 0; i < 200; i++) {
+        for (int j = 0; j < 173; j++) {
+            EXPECT_NEAR(winogradChannel->at(i, j), expectedChannel->at(i, j), 1.0f);
+            differentPixels += winogradChannel->at(i, j) != expectedChannel->at(i, j);
+        }
+    }
+
+    EXPECT_LT(differentPixels, 200 * 173 / 1000);
+}
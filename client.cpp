@@ -0,0 +1,58 @@
+#include "Source/Core/Daemon/FilterClient.h"
+#include "Source/Core/Daemon/FilterRequest.h"
+#include <iostream>
+
+/*
+ * ImageConvolutionKernelClient <socket> [command...]
+ *
+ * Sends the command given as arguments (e.g. `filter input=paw.ppm output=paw_blurred kernel=gaussian size=9 sigma=1.3`) to the daemon
+ * listening on <socket> and prints its reply. Without a command, sends each line of the standard input over a single connection instead.
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <socket> [command...]" << std::endl;
+        return 2;
+    }
+
+    auto client = FilterClient::connectTo(argv[1]);
+    if (client == nullptr) {
+        std::cerr << "Could not connect to " << argv[1] << std::endl;
+        return 1;
+    }
+
+    auto succeeded = true;
+    auto send = [&client, &succeeded](const std::string& line) {
+        auto reply = client->request(line);
+
+        if (!reply.has_value()) {
+            std::cerr << "The daemon closed the connection" << std::endl;
+            succeeded = false;
+            return false;
+        }
+
+        std::cout << reply.value() << std::endl;
+        succeeded = succeeded && reply->starts_with("ok");
+        return true;
+    };
+
+    if (argc > 2) {
+        auto line = std::string(argv[2]);
+
+        for (int i = 3; i < argc; i++) {
+            auto argument = std::string(argv[i]);
+            auto separator = argument.find('=');
+
+            line += " " + (separator == std::string::npos ?
+                FilterRequest::quoted(argument)
+                    :
+                argument.substr(0, separator + 1) + FilterRequest::quoted(argument.substr(separator + 1)));
+        }
+
+        send(line);
+    } else {
+        for (std::string line; std::getline(std::cin, line) && send(line);) {}
+    }
+
+    delete client;
+    return succeeded ? 0 : 1;
+}
@@ -1,14 +1,79 @@
 #include "Source/Core/Image/ImageFormats/PPM/PPMImage.h"
 #include "Source/Core/ConvolutionKernel/Kernels/GaussianKernel.cpp"
 #include "Source/Core/MatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy/PeriodicExtensionMatrixPaddingStrategy.h"
+#include "Source/Core/Daemon/FilterDaemon.h"
+#include "Source/Core/Plan/ConvolutionPlan.h"
+#include "Source/Core/Scheduler/WorkStealingScheduler.h"
+#include <csignal>
+#include <cstdlib>
 #include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace {
+    FilterDaemon<float>* runningDaemon = nullptr;
+
+    void stopRunningDaemon(int) {
+        if (runningDaemon != nullptr) {
+            runningDaemon->stop();
+        }
+    }
+
+    /*
+     * ImageConvolutionKernel --daemon <socket> [workers]: serves filter requests until SIGINT, SIGTERM or a `shutdown` request,
+     * then prints the latency percentiles of the served requests.
+     */
+    int runDaemon(const std::filesystem::path& socketPath, unsigned int workersCount) {
+        auto daemon = FilterDaemon<float>(socketPath, workersCount);
+
+        if (!daemon.isListening()) {
+            std::cerr << "Could not listen on " << socketPath << std::endl;
+            return 1;
+        }
+
+        runningDaemon = &daemon;
+        std::signal(SIGINT, stopRunningDaemon);
+        std::signal(SIGTERM, stopRunningDaemon);
+
+        daemon.serve();
+
+        runningDaemon = nullptr;
+        std::cout << daemon.getLatencyReport().toJSON() << std::endl;
+        return 0;
+    }
+}
+
+/*
+ * The blur of the default run goes through a measured `ConvolutionPlan`. When IMAGECONVOLUTIONKERNEL_WISDOM names a file, the wisdom of
+ * earlier runs is loaded from it at startup, so that the plan skips measuring shapes it has seen before, and what this run measured is
+ * saved back to it on exit.
+ */
+int main(int argc, char** argv) {
+    auto wisdomPath = std::getenv("IMAGECONVOLUTIONKERNEL_WISDOM");
+    if (wisdomPath != nullptr) {
+        ConvolutionWisdom::shared().load(wisdomPath);
+        std::atexit([] { ConvolutionWisdom::shared().save(std::getenv("IMAGECONVOLUTIONKERNEL_WISDOM")); });
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--daemon") {
+        auto workersCount = argc >= 4 ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : std::thread::hardware_concurrency();
+        return runDaemon(argv[2], workersCount);
+    }
 
-int main() {
     auto loadedImage = NetpbmImage<float, PPMImage<float>>::loadImage( std::filesystem::current_path() / "paw.ppm");
     auto gaussianBlur = Kernels::gaussianKernel<float>(9, 1.3);
     auto imagePaddingStrategy = new PeriodicExtensionMatrixPaddingStrategy<float>();
 
-    auto blurredImage = loadedImage->filtered(gaussianBlur, imagePaddingStrategy);
+    auto scheduler = WorkStealingScheduler();
+    auto firstChannel = loadedImage->getChannel(0);
+    auto blurPlan = ConvolutionPlan<float>(gaussianBlur, firstChannel->getRows(), firstChannel->getColumns(), firstChannel->getMatrixLayout(), imagePaddingStrategy, PlanningMode::MEASURE, &scheduler);
+
+    auto blurredChannels = std::vector<Channel<float>*>();
+    for (unsigned int i = 0; i < loadedImage->getChannelsCount(); i++) {
+        blurredChannels.push_back(loadedImage->getChannel(i)->filtered(&blurPlan));
+    }
+
+    auto blurredImage = NetpbmImage<float, PPMImage<float>>::withChannels(loadedImage->getWidth(), loadedImage->getHeight(), blurredChannels);
     blurredImage->writeToFile(std::filesystem::current_path() /"paw_blurred.ppm", ImageChannelsEncoding::BINARY);
     return 0;
 }